@@ -289,6 +289,13 @@ TTErr Automation::Process(const TTValue& inputValue, TTValue& outputValue)
                 if (err == kTTErrValueNotFound || redundancy)
                     continue;
                 
+                // during an offline render : write the value into the render file instead of sending it
+                if (TTTimeRenderIsRunning()) {
+                    
+                    TTTimeRenderOutput(key, valueToSend);
+                    continue;
+                }
+                
                 // look for the sender at the address
                 if (!mSenders.lookup(key, objects)) {
                     
@@ -318,6 +325,10 @@ TTErr Automation::Goto(const TTValue& inputValue, TTValue& outputValue)
     TTUInt32        i, j;
     TTBoolean       mute = NO;
     
+    // apply the command at the next tick of the clock service
+    if (!TTTimeClock::isExecutionThread())
+        return TTTimeClock::post(this, kTTSym_Goto, inputValue);
+    
     if (inputValue.size() >= 1) {
         
         if (inputValue[0].type() == kTypeUInt32) {
@@ -24,6 +24,11 @@ TIME_PROCESS_CONSTRUCTOR
     TIME_PLUGIN_INITIALIZE
     
 	TT_ASSERT("Correct number of args to create Interval", arguments.size() == 0);
+    
+    // an interval has nothing to process : its scheduler only needs to be ticked at the end
+    // (the scheduler is NULL if the TimeClock failed to load)
+    if (mScheduler)
+        mScheduler->setAttributeValue(TTSymbol("wakeUp"), TTFloat64(-1.));
 }
 
 Interval::~Interval()
@@ -70,6 +75,10 @@ TTErr Interval::Goto(const TTValue& inputValue, TTValue& outputValue)
     TTValue     v;
     TTUInt32    duration, timeOffset;
     
+    // apply the command at the next tick of the clock service
+    if (!TTTimeClock::isExecutionThread())
+        return TTTimeClock::post(this, kTTSym_Goto, inputValue);
+    
     if (inputValue.size() == 1) {
         
         if (inputValue[0].type() == kTypeUInt32) {
@@ -23,6 +23,7 @@
 
 #ifndef NO_EXECUTION_GRAPH
 #include "ScenarioGraph.h"
+#include "ScenarioRecord.h"
 #endif
 
 /**	The Scenario class allows to ...
@@ -40,18 +41,46 @@ class Scenario : public TimeContainer {
     
     SolverPtr                   mEditionSolver;                 ///< an internal gecode solver to assist scenario edition
     SolverObjectMap             mVariablesMap;                  ///< an internal map to store and retreive SolverVariablePtr using TTTimeEventPtr
+    SolverVariableIDMap         mVariablesIDMap;                ///< an internal map to retreive SolverVariablePtr using the solver ID of their date
     SolverObjectMap             mConstraintsMap;                ///< an internal map to store and retreive SolverConstraintPtr using TTTimeProcessPtr
     SolverObjectMap             mRelationsMap;                  ///< an internal map to store and retreive SolverRelationPtr using TTTimeProcessPtr
 #ifndef NO_EXECUTION_GRAPH
     GraphPtr                    mExecutionGraph;                ///< an internal petri net to execute the scenario according time event relations
 
     GraphObjectMap              mTransitionsMap;                ///< an internal map to store and retreive TransitionPtr using TTTimeEventPtr
+    GraphObjectMap              mTransitionEventsMap;           ///< an internal map to retreive a TTTimeEventPtr of each TransitionPtr (the events merged into a transition share it)
 	GraphObjectMap              mArcsMap;                       ///< an internal map to store and retreive Arc* using TTTimeProcessPtr
-    GraphObjectMap              mMergedTransitionsMap;          ///< an internal map to store and retreive TransitionPtr using another TransitionPtr
+    GraphObjectMap              mStartArcsMap;                  ///< an internal map to store and retreive the Arc* to the start transition using TTTimeProcessPtr (except intervals)
+    GraphObjectMap              mEndArcsMap;                    ///< an internal map to store and retreive the Arc* to the end transition using TTTimeProcessPtr (NULL for an interval without duration)
+    GraphObjectMap              mArcProcessesMap;               ///< an internal map to store and retreive the TTTimeProcessPtr of the Arc* stored in the two maps above
+    GraphObjectMap              mInteractiveEventsMap;          ///< an internal map to store and retreive the TransitionPtr of each interactive TTTimeEventPtr
+    
+    GraphObjectMap              mDirtyTimeEvents;               ///< the TTTimeEventPtr whose date changed since the last compilation
+    GraphObjectMap              mDirtyTimeProcesses;            ///< the TTTimeProcessPtr whose duration bounds changed since the last compilation
+    TTBoolean                   mGraphChanged;                  ///< a flag true when events, processes or conditions have been added, removed or conditioned since the last compilation
+    TTUInt32                    mGraphTimeOffset;               ///< the time offset of the last compilation
+    TTUInt32                    mGraphPlanKey;                  ///< the key of the plan the execution graph is frozen with (cf getGraphPlanKey)
+    GraphPlanMap                mGraphPlans;                    ///< the plans of the former compilations kept aside by key, until an edit makes them out of date
+    ScenarioGraphConditionedEventVector mConditionedEvents;     ///< the conditioned events sorted by date, sorted again after an edit (cf getGraphPlanKey)
+    
+    Scenario*                   mParentScenario;                ///< the scenario which compiled this scenario as a sub-scenario (NULL for the root scenario)
+    TTBoolean                   mGraphHosted;                   ///< a flag true when the execution graph is stepped by the execution graph of the parent scenario
    
     ExtendedInt                 plusInfinity;
 	ExtendedInt                 minusInfinity;
 	ExtendedInt                 integer0;
+    
+    TTBoolean                   mRecording;                     ///< a flag true when the inputs of the execution graph are recorded
+    TTSymbol                    mRecordPath;                    ///< the file where to write the record when it stops
+    ScenarioRecordChunkVector   mRecordedChunks;                ///< the chunks of the recorded steps with the events they processed
+    TTUInt32                    mRecordedSize;                  ///< the number of entries recorded into the chunks
+    ScenarioRecordValueVector   mRecordedValues;                ///< the recorded values received by the time conditions
+    TTMutexPtr                  mRecordMutex;                   ///< to protect the recorded steps from the execution thread and the thread which stops the record
+    TTMutexPtr                  mRecordValueMutex;              ///< to protect the recorded values from the threads of the receivers
+    
+    TTBoolean                   mReplaying;                     ///< a flag true when the execution graph is driven by a record
+    ScenarioRecordVector        mReplayedSteps;                 ///< the steps to replay with the events they processed
+    TTUInt32                    mReplayPosition;                ///< the next entry to replay
 #endif     
     TTTimeEventPtr              mCurrentTimeEvent;              ///< an internal pointer to remember the current time event being read
     TTTimeProcessPtr            mCurrentTimeProcess;            ///< an internal pointer to remember the current time process being read
@@ -106,6 +135,49 @@ class Scenario : public TimeContainer {
      @return                an error code if the operation fails */
     TTErr   Goto(const TTValue& inputValue, TTValue& outputValue);
     
+#ifndef NO_EXECUTION_GRAPH
+    /** Start or stop to trace the execution of all the scenarios into a binary file (cf ExecutionTrace)
+     @param	inputValue      the path of the file to start, nothing to stop
+     @param	outputValue     nothing
+     @return                an error code if the file can't be created or if the trace is already started */
+    TTErr   Trace(const TTValue& inputValue, TTValue& outputValue);
+    
+    /** Start or stop to record the inputs of the execution graph (cf ScenarioRecord)
+     each step is recorded with its time and the events triggered or disposed it processed,
+     the values received by the time conditions are recorded too
+     @param	inputValue      the path of the file to write when the record stops, nothing to stop and write the file
+     @param	outputValue     nothing
+     @return                an error code if the scenario is replaying or if the file can't be written */
+    TTErr   Record(const TTValue& inputValue, TTValue& outputValue);
+    
+    /** Start or stop to replay a record instead of listening to the triggers and the disposes
+     the recorded steps are made with their recorded time whatever the clock is (it can be driven by the host to replay faster, cf TTTimeClock::setExternal)
+     and each recorded event is given to the step which processed it : this have to be started before the scenario
+     @param	inputValue      the path of a record file to start, nothing to stop
+     @param	outputValue     nothing
+     @return                an error code if the scenario is running, recording or if the file can't be read */
+    TTErr   Replay(const TTValue& inputValue, TTValue& outputValue);
+    
+    /** Record a value received by a time condition while recording
+     @param	inputValue      a time condition object, an address, the received value
+     @param	outputValue     nothing
+     @return                kTTErrNone */
+    TTErr   ConditionValueReceived(const TTValue& inputValue, TTValue& outputValue);
+    
+    /** Remember a time event whose date changed to patch the execution graph at the next compilation
+     @param	inputValue      a time event object
+     @param	outputValue     nothing
+     @return                kTTErrNone */
+    TTErr   EventDateChanged(const TTValue& inputValue, TTValue& outputValue);
+    
+    /** Get the size and the arc times of the compiled execution graph (for the unit tests)
+     @param	inputValue      nothing
+     @param	outputValue     the number of transitions, the number of places then, for each time process,
+                            the time of its arc from the start of the graph and of its end arc (-1 when there is no arc)
+     @return                an error code if the scenario is not compiled */
+    TTErr   GraphInfo(const TTValue& inputValue, TTValue& outputValue);
+#endif
+    
     /**  needed to be handled by a TTXmlHandler
      @param	inputValue      ..
      @param	outputValue     ..
@@ -216,18 +288,43 @@ class Scenario : public TimeContainer {
     /** an internal method used to delete all time condition attribute observers */
     void    deleteTimeConditionCacheElement(const TTValue& oldCacheElement);
     
+    /** an internal method used to update the date of the time events solved by the last edition (only the part of the scenario connected to the edited events) */
+    void    updateSolvedVariables();
+    
+    /** an internal method used to compile the scenario from a time offset (cf Compile) */
+    TTErr   compileScenario(TTUInt32 timeOffset);
+    
     
  #ifndef NO_EXECUTION_GRAPH
     /** internal methods used to compile the execution graph */
     void    clearGraph();
-    void    compileGraph(TTUInt32 timeOffset);
-    void    compileTimeProcess(TTTimeProcessPtr aTimeProcess, TransitionPtr *previousTransition, TransitionPtr endTransition, TTUInt32 timeOffset);
-    void    compileInterval(TTTimeProcessPtr aTimeProcess);
-    void    compileTimeEvent(TTTimeEventPtr aTimeEvent, TTUInt32 time, TransitionPtr previousTransition, TransitionPtr currentTransition, Place* currentPlace);
+    void    releaseGraph();
+    void    releaseSubScenarios();
+    void    clearGraphPlans();
+    TTErr   compileGraph(TTUInt32 timeOffset);
+    void    compileTimeProcess(TTTimeProcessPtr aTimeProcess, ScenarioGraphNodePtr startNode, ScenarioGraphNodePtr endNode, TransitionPtr startTransition, TransitionPtr endTransition, TTUInt32 timeOffset);
+    void    compileInterval(TTTimeProcessPtr aTimeProcess, ScenarioGraphNodePtr startNode, ScenarioGraphNodePtr endNode);
+    Arc*    compileArc(TransitionPtr previousTransition, TransitionPtr currentTransition, TTUInt32 time);
     void    compileInteractiveEvent(TTTimeEventPtr aTimeEvent, TTUInt32 timeOffset);
+    TTErr   freezeGraph(TTUInt32 timeOffset);
+    
+    /** internal methods used to patch the execution graph when only dates, duration bounds or the time offset changed */
+    TTBoolean   isGraphPatchable();
+    void        patchGraph(TTUInt32 timeOffset);
+    TTUInt32    getGraphPlanKey(TTUInt32 timeOffset);
+    void        sortConditionedEvents();
+    
+    /** internal methods used to record and replay the execution graph inputs */
+    void    recordStep(TTUInt32 time);
+    void    recordEntry(TTUInt32 time, TTUInt32 kind, TTObjectBasePtr object);
+    void    clearRecord();
+    TTErr   writeRecord(TTSymbol path);
+    TTErr   readRecord(TTSymbol path);
+    TTErr   replaySteps(TTFloat64 scoreTime, TTFloat64 offset);
     
     friend void TT_EXTENSION_EXPORT ScenarioGraphTimeEventCallBack(TTPtr arg, TTBoolean active);
     friend void TT_EXTENSION_EXPORT ScenarioGraphIsEventReadyCallBack(TTPtr arg, TTBoolean isReady);
+    friend void TT_EXTENSION_EXPORT ScenarioGraphStepInputCallBack(TTPtr arg, TTPtr input, TTBoolean isAnEvent);
 #endif
 };
 
@@ -243,6 +340,12 @@ void TT_EXTENSION_EXPORT ScenarioGraphTimeEventCallBack(TTPtr arg, TTBoolean act
  @param	arg                         a time event instance
  @param	isReady                     is the time event ready to be triggered ? */
 void TT_EXTENSION_EXPORT ScenarioGraphIsEventReadyCallBack(TTPtr arg, TTBoolean isReady);
+
+/** The callback method used by the execution graph for each event or deactivation a step processes
+ @param	arg                         a scenario instance
+ @param	input                       a time event or a transition to deactivate
+ @param	isAnEvent                   is the input a time event ? */
+void TT_EXTENSION_EXPORT ScenarioGraphStepInputCallBack(TTPtr arg, TTPtr input, TTBoolean isAnEvent);
 #endif
 
 #endif // __SCENARIO_H__
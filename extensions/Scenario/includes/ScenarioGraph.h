@@ -21,6 +21,10 @@
 #define __SCENARIO_GRAPH_H__
 
 #include "PetriNet.hpp"
+#include "PetriNetValidator.hpp"
+
+#include <map>
+#include <vector>
 
 typedef PetriNet* GraphPtr;
 typedef Transition* TransitionPtr;
@@ -46,6 +50,43 @@ using namespace std;
 typedef	GraphObjectMap*                    GraphObjectMapPtr;
 typedef GraphObjectMap::const_iterator     GraphObjectMapIterator;
 
+/** Define a structure to store an event of a time process while the execution graph is compiled :
+    the events linked by an interval without duration are merged into one transition (union-find) */
+struct ScenarioGraphNode {
+    
+    TTPtr                           event;                          ///< the time event
+    ScenarioGraphNode*              parent;                         ///< the node this one is merged into (NULL for the node standing for all the merged nodes)
+    ScenarioGraphNode*              next;                           ///< the next merged node, whose event action follows this one on the transition
+    ScenarioGraphNode*              last;                           ///< the last node merged into this one (NULL if there is none)
+    TransitionPtr                   transition;                     ///< the transition of the merged nodes (kept by the node standing for all the merged nodes)
+    TTBoolean                       hasIntervalIn;                  ///< an interval with a duration ends at the merged nodes
+    TTBoolean                       hasIntervalOut;                 ///< an interval with a duration starts at the merged nodes
+    
+    ScenarioGraphNode(TTPtr anEvent) : event(anEvent), parent(NULL), next(NULL), last(NULL), transition(NULL), hasIntervalIn(NO), hasIntervalOut(NO) {};
+};
+
+typedef ScenarioGraphNode*                  ScenarioGraphNodePtr;
+
+/** Define a vector to store the nodes in the order of the time processes (their pointers must not move : reserve it first) */
+typedef std::vector<ScenarioGraphNode>      ScenarioGraphNodeVector;
+
+/** Define a structure to store a conditioned event with its date : the time offset of a compilation only decides which of them are interactive */
+struct ScenarioGraphConditionedEvent {
+    
+    TTUInt32                        date;                           ///< the date of the time event
+    TTUInt32                        order;                          ///< the position of the time event in the time event list (the order of compileGraph)
+    TTPtr                           event;                          ///< the time event
+    
+    ScenarioGraphConditionedEvent(TTUInt32 aDate, TTUInt32 anOrder, TTPtr anEvent) : date(aDate), order(anOrder), event(anEvent) {};
+};
+
+/** Define a vector to store the conditioned events sorted by date (cf Scenario::getGraphPlanKey) */
+typedef std::vector<ScenarioGraphConditionedEvent>  ScenarioGraphConditionedEventVector;
+
+/** A type to define a map to keep the frozen plans of the execution graph aside by compilation key */
+typedef std::map<TTUInt32, ExecutionPlan*> GraphPlanMap;
+typedef GraphPlanMap::iterator             GraphPlanMapIterator;
+
 #endif // __SCENARIO_GRAPH_H__
 
 #endif // NO_EXECUTION_GRAPH
@@ -0,0 +1,80 @@
+/** @file
+ *
+ * @ingroup scoreExtension
+ *
+ * @brief Scenario Record file defines the structures to record the inputs of the execution graph and to replay them
+ *
+ * @details A record stores each step of the execution graph with the time given to it,
+ * the events triggered and disposed which have been processed by this step
+ * and the values received by the time conditions. @n
+ * It is written into a text file, one entry per line : <step> <time> <kind> <name> [<address> <value>] @n
+ * where kind is step, trigger, dispose or value and name is the name of the time event or of the time condition. @n@n
+ *
+ * @see Scenario, PetriNet
+ *
+ * @authors Théo de la Hogue & Clément Bossut
+ *
+ * @copyright Copyright © 2013, Théo de la Hogue & Clément Bossut @n
+ * This code is licensed under the terms of the "CeCILL-C" @n
+ * http://www.cecill.info
+ */
+
+#ifndef NO_EXECUTION_GRAPH
+
+#ifndef __SCENARIO_RECORD_H__
+#define __SCENARIO_RECORD_H__
+
+#include "TTScore.h"
+#include "TTMutex.h"
+
+#include <vector>
+
+/** the number of entries of a chunk of record */
+#define SCENARIO_RECORD_CHUNK_SIZE 4096
+
+/** the number of chunks allocated when a record starts (the execution thread only allocates a chunk when they are all full) */
+#define SCENARIO_RECORD_CHUNK_COUNT 16
+
+/** Define the kinds of entry of a record */
+enum ScenarioRecordKind {
+    kScenarioRecordStep = 0,                                        ///< a step of the execution graph
+    kScenarioRecordTrigger,                                         ///< a time event triggered and processed by the next step
+    kScenarioRecordDispose,                                         ///< a time event disposed and processed by the next step
+    kScenarioRecordValue                                            ///< a value received by a time condition
+};
+
+/** Define a structure to store an entry of a record : it is plain data, so the execution thread records it without allocation
+    (the names are only looked up when the record is written) */
+struct ScenarioRecordEntry {
+
+    TTUInt32                        step;                           ///< the number of the step of the execution graph
+    TTUInt32                        time;                           ///< the time (in ms) given to the step
+    TTUInt32                        kind;                           ///< a ScenarioRecordKind
+    TTObjectBasePtr                 object;                         ///< the time event (trigger or dispose) or NULL (step)
+
+    ScenarioRecordEntry() : step(0), time(0), kind(kScenarioRecordStep), object(NULL) {};
+};
+
+/** Define a structure to store a value received by a time condition while recording */
+struct ScenarioRecordValue {
+
+    TTUInt32                        step;                           ///< the number of the step of the execution graph
+    TTUInt32                        time;                           ///< the time (in ms) of the step
+    TTObjectBasePtr                 object;                         ///< the time condition
+    TTValue                         value;                          ///< the address and the received value
+
+    ScenarioRecordValue() : step(0), time(0), object(NULL) {};
+};
+
+/** Define a vector to store the entries of a record in step order */
+typedef std::vector<ScenarioRecordEntry>    ScenarioRecordVector;
+
+/** Define a vector to store the chunks of SCENARIO_RECORD_CHUNK_SIZE entries of a record in step order */
+typedef std::vector<ScenarioRecordEntry*>   ScenarioRecordChunkVector;
+
+/** Define a vector to store the values received by the time conditions while recording */
+typedef std::vector<ScenarioRecordValue>    ScenarioRecordValueVector;
+
+#endif // __SCENARIO_RECORD_H__
+
+#endif // NO_EXECUTION_GRAPH
@@ -65,6 +65,8 @@ enum SolverVariableType { DATE_VARIABLE = 1, RANGE_VARIABLE = 100 };
  Solver Relation Types  */
 enum SolverRelationType { EQ_RELATION = 0, NQ_RELATION = 1, LQ_RELATION = 2, LE_RELATION = 3, GQ_RELATION = 4, GR_RELATION = 5 };
 
+class SolverConstraint;
+
 /*!
  * \class SolverVariable
  *
@@ -81,6 +83,8 @@ public:
     int             dateID;
     int             rangeID;
     
+    vector<SolverConstraint*>   constraints;    ///< the constraints starting or ending with the variable
+    
     SolverVariable(SolverPtr aSolver, TTTimeEventPtr anEvent, SolverValue max);
     
     ~SolverVariable();
@@ -96,6 +100,10 @@ public:
 };
 typedef SolverVariable* SolverVariablePtr;
 
+/** A type to define a map to retreive the SolverVariable of a solver variable ID (cf Solver::getSolvedVariables) */
+typedef std::map<int, SolverVariablePtr>    SolverVariableIDMap;
+typedef SolverVariableIDMap::const_iterator SolverVariableIDMapIterator;
+
 /*!
  * \class SolverConstraint
  *
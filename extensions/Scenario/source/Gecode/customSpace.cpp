@@ -99,21 +99,29 @@ CustomSpace::copy(bool share)
 int
 CustomSpace::addVariable(int min, int max)
 {
+	return addVariables(vector<int>(1, min), vector<int>(1, max));
+}
+
+int
+CustomSpace::addVariables(const vector<int> &mins, const vector<int> &maxs)
+{
+	int first = _dat.size();
+
 //TODO: avant "	IntVarArray newArray(this, _dat.size()+1);"
 //TODO:	avant "IntVar v(this, min, max);"
-	IntVarArray newArray(*this, _dat.size()+1);
-	IntVar v(*this, min, max);
+	IntVarArray newArray(*this, first + mins.size());
 
 	// Copy from the old array to the new
-	for (int i=0; i<newArray.size()-1; i++)
+	for (int i=0; i<first; i++)
 		newArray[i] = _dat[i];
 
-	newArray[newArray.size()-1] = v;
+	for (unsigned int i=0; i<mins.size(); i++)
+		newArray[first + i] = IntVar(*this, mins[i], maxs[i]);
 
 	// Replace the array
 	_dat = newArray;
 
-	return _dat.size()-1;
+	return first;
 }
 
 void
@@ -83,6 +83,10 @@ public :
 	// Add a variable to the array
 	int addVariable(int min, int max);
 
+	// Add several variables to the array, copying it once
+	// returns the index of the first one
+	int addVariables(const vector<int> &mins, const vector<int> &maxs);
+
 	// Called during BAB search
 	virtual void constrain(const Space &t);
 
@@ -49,8 +49,8 @@ class CustomSpace;
 ///////////////////////////////////////////////////////////////////////
 //
 // An integer variable has a weight and a value, bounded by a min and a max.
-// Each integer value is associated with 4 Gecode-variables, see
-// IntegerVariable.cpp for further information.
+// Each integer value is associated with 3 Gecode-variables, see
+// Solver::addVariablesToSpace for further information.
 //
 ///////////////////////////////////////////////////////////////////////
 
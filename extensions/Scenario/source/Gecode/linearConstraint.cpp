@@ -41,6 +41,7 @@ knowledge of the CeCILL-C license and that you accept its terms.
 #include "customSpace.hpp"
 #include "integerVariable.hpp"
 #include "solver.hpp"
+#include "temporalNetwork.hpp"
 
 LinearConstraint::LinearConstraint()
 {
@@ -64,7 +65,7 @@ LinearConstraint::~LinearConstraint()
 }
 
 void 
-LinearConstraint::addToSpace() const
+LinearConstraint::addToSpace(CustomSpace *space) const
 {
 	int size = _varsIDs->size();
 
@@ -76,12 +77,73 @@ LinearConstraint::addToSpace() const
 	for (int i=0; i<size; i++)
 	{
 		IntegerVariable *iv = _solver->varFromID(_varsIDs->at(i));
-		vars[i] = _solver->getSpace()->getIntVar(iv->getTotalIndex());
+		vars[i] = space->getIntVar(iv->getTotalIndex());
 		coeffs[i] = _varsCoeffs->at(i);
 	}
 
 //TODO: avant "Gecode::linear((Space*)_solver->getSpace(), coeffs, vars, _relType, _val);"
-	Gecode::linear(*(Space*)_solver->getSpace(), coeffs, vars, _relType, _val); 
+	Gecode::linear(*(Space*)space, coeffs, vars, _relType, _val); 
+}
+
+int
+LinearConstraint::getNbVars() const
+{
+	return _varsIDs->size();
+}
+
+int
+LinearConstraint::getVarID(int i) const
+{
+	return _varsIDs->at(i);
+}
+
+bool
+LinearConstraint::isDifference(int *from, int *to, int *min, int *max) const
+{
+	if (_varsIDs->size() != 2)
+		return false;
+
+	// <coeff 0> * var_0 + <coeff 1> * var_1 is var_to - var_from
+	if (_varsCoeffs->at(0) == 1 && _varsCoeffs->at(1) == -1)
+	{
+		*to = _varsIDs->at(0);
+		*from = _varsIDs->at(1);
+	}
+	else if (_varsCoeffs->at(0) == -1 && _varsCoeffs->at(1) == 1)
+	{
+		*to = _varsIDs->at(1);
+		*from = _varsIDs->at(0);
+	}
+	else
+		return false;
+
+	switch (_relType)
+	{
+	case IRT_EQ :
+		*min = _val;
+		*max = _val;
+		break;
+	case IRT_LQ :
+		*min = TEMPORAL_MINUS_INFINITY;
+		*max = _val;
+		break;
+	case IRT_LE :
+		*min = TEMPORAL_MINUS_INFINITY;
+		*max = _val - 1;
+		break;
+	case IRT_GQ :
+		*min = _val;
+		*max = TEMPORAL_PLUS_INFINITY;
+		break;
+	case IRT_GR :
+		*min = _val + 1;
+		*max = TEMPORAL_PLUS_INFINITY;
+		break;
+	default :
+		return false;
+	}
+
+	return *from != *to;
 }
 
 bool 
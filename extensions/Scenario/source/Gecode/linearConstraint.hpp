@@ -41,6 +41,7 @@ knowledge of the CeCILL-C license and that you accept its terms.
 
 #include "gecode_headers.hpp"
 
+class CustomSpace;
 class Solver;
 
 ///////////////////////////////////////////////////////////////////////
@@ -70,8 +71,16 @@ public :
 	LinearConstraint(Solver *s, vector<int> *varsIDs, vector<int> *varsCoeffs, IntRelType relType, int val);
 	~LinearConstraint();
 
-	// add the constraint to Gecode's space
-	void addToSpace() const;	
+	// add the constraint to the Gecode space of the component of its variables
+	void addToSpace(CustomSpace *space) const;	
+
+	// access to the variables implicated in the constraint
+	int getNbVars() const;
+	int getVarID(int i) const;
+
+	// TRUE if the constraint is a difference between two variables : min <= var_to - var_from <= max
+	// (cf TemporalNetwork)
+	bool isDifference(int *from, int *to, int *min, int *max) const;
 
 	// TRUE if the constraint implicated the variable whith the id 'i'
 	bool dependsOn(int i) const;	
@@ -43,13 +43,34 @@ knowledge of the CeCILL-C license and that you accept its terms.
 #include "linearConstraint.hpp"
 #include "relations_type.hpp"
 #include "searchEngine.hpp"
+#include "temporalNetwork.hpp"
+
+#include <algorithm>
+#include <set>
+#include <pthread.h>
+#include <unistd.h>
+
+// the share of the components of a solve given to a thread
+struct SolverThreadArgs {
+	Solver *solver;
+	vector<SolverComponent*> *components;
+	unsigned int first;
+	unsigned int step;
+};
 
 Solver::Solver()
 {
-	_space = new CustomSpace();
 	_integerVariablesMap = new map<int, IntegerVariable*>;
 	_constraintsMap = new map<int, LinearConstraint*>;
-	_engine = new SearchEngine(_space);
+	_componentsMap = new map<int, SolverComponent*>;
+	_variableComponent = new map<int, int>;
+	_variableConstraints = new map<int, vector<int> >;
+	_nextComponentID = 0;
+	_nextRelationID = 0;
+	_nextVariableID = 0;
+	_bulk = false;
+	_temporalNetwork = new TemporalNetwork();
+	_strongVars = NULL;
 	_suggest = false;
 
 	_maxModification = NO_MAX_MODIFICATION;
@@ -66,11 +87,23 @@ Solver::~Solver()
 	delete(_integerVariablesMap);
 	_integerVariablesMap = NULL;
 
-	if (_space)
+	map<int, SolverComponent*>::iterator q;
+	for (q = _componentsMap->begin(); q != _componentsMap->end(); q++)
 	{
-		delete(_space);
-		_space = NULL;
+		delete(q->second->space);
+		delete(q->second);
 	}
+	delete(_componentsMap);
+	_componentsMap = NULL;
+
+	delete(_variableComponent);
+	_variableComponent = NULL;
+
+	delete(_variableConstraints);
+	_variableConstraints = NULL;
+
+	delete(_temporalNetwork);
+	_temporalNetwork = NULL;
 }
 
 // find the Gecode relation type corresponding to a binary relation
@@ -106,29 +139,43 @@ Solver::getGecodeRelType(int relType)
 }
 
 // find the lowest free integer ID for a constraint
+// (the IDs lower than the next one are used or free)
 int
-Solver::findNewRelationID() const
+Solver::findNewRelationID()
 {
-	int newID = 0;
-	while (_constraintsMap->find(newID) != _constraintsMap->end())
-		newID++;
-	return newID;
+	while (!_freeRelationIDs.empty())
+	{
+		int newID = *_freeRelationIDs.begin();
+		_freeRelationIDs.erase(_freeRelationIDs.begin());
+
+		if (_constraintsMap->find(newID) == _constraintsMap->end())
+			return newID;
+	}
+
+	while (_constraintsMap->find(_nextRelationID) != _constraintsMap->end())
+		_nextRelationID++;
+
+	return _nextRelationID++;
 }
 
 // find the lowest free integer ID for a variable
+// (the IDs lower than the next one are used or free)
 int
-Solver::findNewVariableID() const
+Solver::findNewVariableID()
 {
-	int newID = 0;
-	while (_integerVariablesMap->find(newID) != _integerVariablesMap->end())
-		newID++;
-	return newID;
-}
+	while (!_freeVariableIDs.empty())
+	{
+		int newID = *_freeVariableIDs.begin();
+		_freeVariableIDs.erase(_freeVariableIDs.begin());
 
-CustomSpace*
-Solver::getSpace() const
-{
-	return _space;
+		if (_integerVariablesMap->find(newID) == _integerVariablesMap->end())
+			return newID;
+	}
+
+	while (_integerVariablesMap->find(_nextVariableID) != _integerVariablesMap->end())
+		_nextVariableID++;
+
+	return _nextVariableID++;
 }
 
 // find an IntegerVariable from its ID
@@ -148,18 +195,22 @@ Solver::constraintFromID(int constID) const
 int
 Solver::addIntVar(int min, int max, int val, int weight)
 {
-	// to each abstract variable we associate 4 Gecode variable
-	// usefull to minimize the variations
-	int index = _space->addVariable(min, max);
-	int pdelta = _space->addVariable(0, max);
-	int ndelta = _space->addVariable(0, max);
-	int total = _space->addVariable(min, max);
-
 	// tha abstract variable, i.e. the variable for the solver user
-	IntegerVariable *newVar = new IntegerVariable(min, max, val, index, weight, pdelta, ndelta, total);
+	IntegerVariable *newVar = new IntegerVariable(min, max, val, 0, weight, 0, 0, 0);
 	int newID = findNewVariableID();
 	_integerVariablesMap->insert(pair<int, IntegerVariable*>(newID, newVar));
 
+	// a variable without constraint is a temporal component on its own
+	int compID = newComponent();
+	SolverComponent *comp = (*_componentsMap)[compID];
+
+	comp->vars.push_back(newID);
+	comp->consistent = min <= max;
+	_temporalNetwork->setNode(newID, min, max, val);
+
+	(*_variableComponent)[newID] = compID;
+	(*_variableConstraints)[newID] = vector<int>();
+
 	return newID;
 }
 
@@ -168,18 +219,34 @@ Solver::setIntVar(int id, int min, int max, int val, int weight)
 {
 	//removeIntVar(id);
 
-	// to each abstract variable we associate 4 Gecode variable
-	// usefull to minimize the variations
-	int index = _space->addVariable(min, max);
-	int pdelta = _space->addVariable(0, max);
-	int ndelta = _space->addVariable(0, max);
-	int total = _space->addVariable(min, max);
+	map<int, IntegerVariable*>::iterator p = _integerVariablesMap->find(id);
+	if (p == _integerVariablesMap->end())
+	{
+		// a new variable is a component on its own
+		int compID = newComponent();
+		(*_componentsMap)[compID]->vars.push_back(id);
+		(*_componentsMap)[compID]->changed = true;
+		(*_variableComponent)[id] = compID;
+		(*_variableConstraints)[id] = vector<int>();
+	}
+	else
+	{
+		delete(p->second);
+
+		// the constraints of the former variable are posted on its Gecode variables
+		SolverComponent *comp = (*_componentsMap)[(*_variableComponent)[id]];
+		comp->changed = true;
+		comp->dirty = true;
+	}
 
 	// tha abstract variable, i.e. the variable for the solver user
-	IntegerVariable *newVar = new IntegerVariable(min, max, val, index, weight, pdelta, ndelta, total);
+	IntegerVariable *newVar = new IntegerVariable(min, max, val, 0, weight, 0, 0, 0);
 
 	(*_integerVariablesMap)[id] = newVar;
 
+	// the bounds of the temporal network are computed again with the new domain
+	_temporalNetwork->setNode(id, min, max, val);
+
 	return id;
 }
 
@@ -190,28 +257,40 @@ Solver::removeIntVar(int varID)
 	if (p == _integerVariablesMap->end())
 		return false;
 
+	// delete the relations implicating the deleted variable
+	vector<int> constraintsToRemove = (*_variableConstraints)[varID];
+
+	while (!constraintsToRemove.empty())
+	{
+		removeConstraint(constraintsToRemove.back());
+		constraintsToRemove.pop_back();
+	}
+
 	IntegerVariable *oldVar = p->second;
 	delete(oldVar);
 	_integerVariablesMap->erase(p);
 
-	vector<int> constraintsToRemove;
-
-	map<int, LinearConstraint*>::iterator i;
+	// Gecode can't remove a variable from a space
+	int compID = (*_variableComponent)[varID];
+	SolverComponent *comp = (*_componentsMap)[compID];
 
-	// find the relations implicating the deleted variable
-	for (i = _constraintsMap->begin() ; i != _constraintsMap->end() ; i++)
-		if ( (i->second)->dependsOn(varID) )
-			constraintsToRemove.push_back(i->first);
+	comp->vars.erase(std::remove(comp->vars.begin(), comp->vars.end(), varID), comp->vars.end());
+	comp->changed = true;
 
-	// delete the obsolete relations
-	while (!constraintsToRemove.empty())
+	if (comp->vars.empty())
 	{
-		i = _constraintsMap->find(constraintsToRemove.back());
-		delete(i->second);
-		_constraintsMap->erase(i);
-		constraintsToRemove.pop_back();
+		delete(comp->space);
+		delete(comp);
+		_componentsMap->erase(compID);
 	}
 
+	_variableComponent->erase(varID);
+	_variableConstraints->erase(varID);
+	_temporalNetwork->removeNode(varID);
+
+	if (varID < _nextVariableID)
+		_freeVariableIDs.insert(varID);
+
 	return true;
 }
 
@@ -236,6 +315,53 @@ Solver::addConstraint(int *varsIDs, int *varsCoeffs, int nbVars, int relType, in
 
 	// insert the constraint in the map
 	_constraintsMap->insert(pair<int, LinearConstraint*>(newID, newCst));
+
+	// the difference constraints are kept by the temporal network too
+	int from, to, min, max;
+	bool difference = newCst->isDifference(&from, &to, &min, &max);
+
+	if (difference)
+		_temporalNetwork->addEdge(newID, from, to, min, max);
+
+	// the constraint joins the components of its variables
+	int compID = (*_variableComponent)[varsIDs[0]];
+
+	for (int i=0; i<nbVars; i++)
+	{
+		int varCompID = (*_variableComponent)[varsIDs[i]];
+
+		if (varCompID != compID)
+			compID = mergeComponents(compID, varCompID);
+
+		(*_variableConstraints)[varsIDs[i]].push_back(newID);
+	}
+
+	SolverComponent *comp = (*_componentsMap)[compID];
+
+	comp->constraints.push_back(newID);
+	comp->dirty = true;
+
+	// a component which isn't temporal anymore needs a Gecode space
+	if (comp->temporal && !difference)
+	{
+		comp->temporal = false;
+		comp->changed = true;
+	}
+
+	// the component is built once at its next solve
+	if (_bulk)
+		comp->changed = true;
+
+	if (comp->changed)
+		return newID;
+
+	// check the consistency from the ends of the new constraint only
+	if (comp->temporal)
+		comp->consistent = comp->consistent && _temporalNetwork->propagate(from, to, comp->vars.size());
+
+	// post it on the space instead of building the space again
+	else
+		newCst->addToSpace(comp->space);
     
     return newID;
 }
@@ -247,125 +373,310 @@ Solver::removeConstraint(int constID)
 	if (p == _constraintsMap->end())
 		return false;
 
-	delete(p->second);
+	LinearConstraint *oldCst = p->second;
+
+	// Gecode can't remove a constraint from a space
+	SolverComponent *comp = (*_componentsMap)[(*_variableComponent)[oldCst->getVarID(0)]];
+
+	comp->constraints.erase(std::remove(comp->constraints.begin(), comp->constraints.end(), constID), comp->constraints.end());
+	comp->changed = true;
+	comp->dirty = true;
+
+	for (int i=0; i<oldCst->getNbVars(); i++)
+	{
+		vector<int> &varConstraints = (*_variableConstraints)[oldCst->getVarID(i)];
+		varConstraints.erase(std::remove(varConstraints.begin(), varConstraints.end(), constID), varConstraints.end());
+	}
+
+	_temporalNetwork->removeEdge(constID);
+
+	delete(oldCst);
 	_constraintsMap->erase(p);
 
+	if (constID < _nextRelationID)
+		_freeRelationIDs.insert(constID);
+
 	return true;
 }
 
-// rebuild a Gecode space with the current variable and constraints
-void
-Solver::updateState()
+int
+Solver::newComponent()
+{
+	SolverComponent *comp = new SolverComponent();
+
+	comp->space = NULL;
+	comp->changed = false;
+	comp->dirty = false;
+	comp->temporal = true;
+	comp->consistent = true;
+	comp->solved = true;
+	comp->memoryPeak = 0;
+
+	_componentsMap->insert(pair<int, SolverComponent*>(_nextComponentID, comp));
+
+	return _nextComponentID++;
+}
+
+// the variables and the constraints of the smallest component are added to the space of the other one
+// so the cost of the merges of a whole score stays in n.log(n)
+int
+Solver::mergeComponents(int compID1, int compID2)
 {
-	if (_space)
+	if ((*_componentsMap)[compID1]->vars.size() < (*_componentsMap)[compID2]->vars.size())
+		std::swap(compID1, compID2);
+
+	SolverComponent *comp = (*_componentsMap)[compID1];
+	SolverComponent *other = (*_componentsMap)[compID2];
+
+	// the merged component may be split if the other one has to be
+	if (other->changed)
+		comp->changed = true;
+
+	// a component which isn't temporal anymore needs a Gecode space
+	if (comp->temporal && !other->temporal)
+		comp->changed = true;
+
+	if (!comp->changed && !comp->temporal)
+	{
+		addVariablesToSpace(other->vars, comp->space);
+
+		for (unsigned int i=0; i<other->constraints.size(); i++)
+			constraintFromID(other->constraints[i])->addToSpace(comp->space);
+	}
+
+	for (unsigned int i=0; i<other->vars.size(); i++)
 	{
-		delete _space;
-		_space = NULL;
+		comp->vars.push_back(other->vars[i]);
+		(*_variableComponent)[other->vars[i]] = compID1;
 	}
 
-	_space = new CustomSpace();
+	comp->constraints.insert(comp->constraints.end(), other->constraints.begin(), other->constraints.end());
+	comp->dirty = comp->dirty || other->dirty;
+	comp->temporal = comp->temporal && other->temporal;
+	comp->consistent = comp->consistent && other->consistent;
+
+	delete(other->space);
+	delete(other);
+	_componentsMap->erase(compID2);
+
+	return compID1;
+}
+
+// rebuild the Gecode spaces (or the temporal network bounds) of a component with its current variables and constraints
+// (only when one of them has been removed or replaced : the others are added to the space when they are created)
+void
+Solver::updateComponent(int compID)
+{
+	SolverComponent *comp = (*_componentsMap)[compID];
+
+	if (!comp->changed)
+		return;
+
+	vector<int> vars;
+	vars.swap(comp->vars);
+	comp->constraints.clear();
+
+	std::set<int> visitedVars;
+	std::set<int> visitedConstraints;
 
-	// create gecode variables
-	for (map<int, IntegerVariable*>::iterator q = _integerVariablesMap->begin(); q != _integerVariablesMap->end(); q++)
+	// the component is split into the parts which are still connected by a constraint
+	for (unsigned int i=0; i<vars.size(); i++)
 	{
-		IntegerVariable *v = q->second;
+		if (visitedVars.count(vars[i]))
+			continue;
 
-		if ((_suggest) && (_maxModification != NO_MAX_MODIFICATION)) {
-			v->adjustMinMax(_suggest, _maxModification);
-		} else {
-			v->adjustMinMax(_suggest);
+		int partID = compID;
+
+		// the first part keeps the component, the others are new components
+		if (comp->vars.empty())
+		{
+			delete(comp->space);
+			comp->space = NULL;
+			comp->changed = false;
+			comp->temporal = true;
 		}
+		else
+			partID = newComponent();
+
+		SolverComponent *part = (*_componentsMap)[partID];
+
+		part->dirty = true;
+
+		// breadth-first walk through the constraints of the variables
+		part->vars.push_back(vars[i]);
+		visitedVars.insert(vars[i]);
+
+		for (unsigned int j=0; j<part->vars.size(); j++)
+		{
+			int varID = part->vars[j];
+			vector<int> &varConstraints = (*_variableConstraints)[varID];
+
+			(*_variableComponent)[varID] = partID;
+
+			for (unsigned int k=0; k<varConstraints.size(); k++)
+			{
+				if (visitedConstraints.count(varConstraints[k]))
+					continue;
+
+				visitedConstraints.insert(varConstraints[k]);
+				part->constraints.push_back(varConstraints[k]);
+
+				LinearConstraint *cst = constraintFromID(varConstraints[k]);
+				int from, to, min, max;
+
+				if (!cst->isDifference(&from, &to, &min, &max))
+					part->temporal = false;
+
+				for (int l=0; l<cst->getNbVars(); l++)
+					if (!visitedVars.count(cst->getVarID(l)))
+					{
+						visitedVars.insert(cst->getVarID(l));
+						part->vars.push_back(cst->getVarID(l));
+					}
+			}
+		}
+
+		// only difference constraints : the bounds of the temporal network are computed again
+		if (part->temporal)
+		{
+			for (unsigned int j=0; j<part->vars.size(); j++)
+				_temporalNetwork->setValue(part->vars[j], varFromID(part->vars[j])->getVal());
+
+			part->consistent = _temporalNetwork->reset(part->vars);
+			continue;
+		}
+
+		part->space = new CustomSpace();
+		part->consistent = true;
+
+		addVariablesToSpace(part->vars, part->space);
+
+		// add constraints to space once all their variables are created
+		for (unsigned int j=0; j<part->constraints.size(); j++)
+			constraintFromID(part->constraints[j])->addToSpace(part->space);
+	}
+}
+
+// to each abstract variable we associate 3 Gecode variables usefull to minimize the variations :
+// its value and the positive and negative deltas from the value to reach (cf editState)
+void
+Solver::addVariablesToSpace(const vector<int> &varsIDs, CustomSpace *space)
+{
+	vector<int> mins;
+	vector<int> maxs;
+
+	mins.reserve(3 * varsIDs.size());
+	maxs.reserve(3 * varsIDs.size());
+
+	for (unsigned int i=0; i<varsIDs.size(); i++)
+	{
+		IntegerVariable *var = varFromID(varsIDs[i]);
 
+		var->adjustMinMax(false);
 
-		v->setIndex(_space->addVariable(v->getVal(), v->getVal()));
-		v->setPosDeltaIndex(_space->addVariable(0, v->getMax() - v->getVal() + 1));
-		v->setNegDeltaIndex(_space->addVariable(0, v->getVal() - v->getMin() + 1));
-		v->setTotalIndex(_space->addVariable(v->getMin(), v->getMax()));
+		mins.push_back(var->getMin());
+		maxs.push_back(var->getMax());
+		mins.push_back(0);
+		maxs.push_back(var->getMax() - var->getMin() + 1);
+		mins.push_back(0);
+		maxs.push_back(var->getMax() - var->getMin() + 1);
 	}
 
-	// add constraints to space
-	for (map<int, LinearConstraint*>::iterator p = _constraintsMap->begin(); p != _constraintsMap->end(); p++)
+	int first = space->addVariables(mins, maxs);
+
+	for (unsigned int i=0; i<varsIDs.size(); i++)
 	{
-		(p->second)->addToSpace();
+		IntegerVariable *var = varFromID(varsIDs[i]);
+		int total = first + 3 * i;
+
+		var->setIndex(total);
+		var->setTotalIndex(total);
+		var->setPosDeltaIndex(total + 1);
+		var->setNegDeltaIndex(total + 2);
 	}
+}
+
+// clone the Gecode space of a component and post on the clone what changes at each solve :
+// the values to reach and the objective function
+CustomSpace *
+Solver::editState(SolverComponent *comp)
+{
+	// the constraints are propagated once in the space for all the solves
+	if (comp->space->status() == SS_FAILED)
+		return NULL;
+
+	CustomSpace *edit = (CustomSpace*)comp->space->clone(false);
 
 	LinExpr expr;
 	bool init=false;
 
 	// construct the linear combination of delta variables balanced by the weight associated with their type
-	for (map<int, IntegerVariable*>::iterator q = _integerVariablesMap->begin(); q != _integerVariablesMap->end(); q++)
+	for (unsigned int v=0; v<comp->vars.size(); v++)
 	{
-		IntegerVariable *currVar = q->second;
+		IntegerVariable *currVar = varFromID(comp->vars[v]);
 
 		// add a delta variable for each beginning or length
 		int multiplier = 1;
 
-		bool isStrong = false;
-
 		// give more weight to the edited variables
-		if (_suggest)
-		{
-			for (unsigned int i=0; i<_strongVars->size(); i++)
-				if (_strongVars->at(i) == q->first)
-				{
-					isStrong = true;
-					//multiplier = 10;
-					break;
-				}
+		bool isStrong = isStrongVar(comp->vars[v]);
+
+		// when edition, the variables can't move further than the maximal modification
+		if ((_suggest) && (_maxModification != NO_MAX_MODIFICATION)) {
+			currVar->adjustMinMax(_suggest, _maxModification);
+		} else {
+			currVar->adjustMinMax(_suggest);
 		}
 
-		IntVarArgs vars(4);
-		IntArgs coeffs(4);
+		if (_suggest)
+			dom(*edit, edit->getIntVar(currVar->getTotalIndex()), currVar->getMin(), currVar->getMax());
+
+		IntVarArgs vars(3);
+		IntArgs coeffs(3);
 
+		// constraint : <optimal value> - <positive delta> + <negative delta> = <initial or wanted value>
+		vars[0] = edit->getIntVar(currVar->getTotalIndex());
+		vars[1] = edit->getIntVar(currVar->getPosDeltaIndex());
+		vars[2] = edit->getIntVar(currVar->getNegDeltaIndex());
+		coeffs[0] = 1;
+		coeffs[1] = -1;
+		coeffs[2] = 1;
+
+		linear(*edit, coeffs, vars, IRT_EQ, currVar->getVal());
+
+		// the edited variables have to reach their wanted value
 		if (isStrong) {
-			vars[0] = _space->getIntVar(currVar->getTotalIndex());
-			vars[1] = _space->getIntVar(currVar->getIndex());
-			vars[2] = _space->getIntVar(currVar->getTotalIndex());
-			vars[3] = _space->getIntVar(currVar->getIndex());
-
-			coeffs[0] = -1;
-			coeffs[1] = 1;
-			coeffs[2] = -1;
-			coeffs[3] = 1;
-		} else {
-			// constraint : <initial or wanted value> + <positive delta> - <negative delta> = <optimal value>
-			vars[0] = _space->getIntVar(currVar->getNegDeltaIndex());
-			vars[1] = _space->getIntVar(currVar->getPosDeltaIndex());
-			vars[2] = _space->getIntVar(currVar->getTotalIndex());
-			vars[3] = _space->getIntVar(currVar->getIndex());
-			coeffs[0] = -1;
-			coeffs[1] = 1;
-			coeffs[2] = 1;
-			coeffs[3] = -1;
+			rel(*edit, vars[1], IRT_EQ, 0);
+			rel(*edit, vars[2], IRT_EQ, 0);
 		}
 
-		linear(*_space, coeffs, vars, IRT_EQ, 0);
-
 		// construction of the objective function
 		if (!init)
 		{
-			expr = LinExpr(vars[0], currVar->getWeight()*multiplier);
+			expr = LinExpr(vars[1], currVar->getWeight()*multiplier);
 
 			init = true;
 
-			LinExpr tmp(vars[1], currVar->getWeight()*multiplier);
+			LinExpr tmp(vars[2], currVar->getWeight()*multiplier);
 
 			expr = LinExpr(expr, Gecode::LinExpr::NT_ADD, tmp);
 		}
 		else
 		{
-			LinExpr tmp(vars[0], currVar->getWeight()*multiplier);
+			LinExpr tmp(vars[1], currVar->getWeight()*multiplier);
 
 			expr = LinExpr(expr, Gecode::LinExpr::NT_ADD, tmp);
 
-			tmp = LinExpr(vars[1], currVar->getWeight()*multiplier);
+			tmp = LinExpr(vars[2], currVar->getWeight()*multiplier);
 
 			expr = LinExpr(expr, Gecode::LinExpr::NT_ADD, tmp);
 		}
 	}
 
 	// the objective function is a linear combination of the delta variables (lengths are more important than beginnings)
-	_space->setObjFunc(Gecode::expr(*_space, expr));
+	edit->setObjFunc(Gecode::expr(*edit, expr));
+
+	return edit;
 }
 
 // edit some variables and try to reach the new values
@@ -393,7 +704,8 @@ Solver::suggestValues(int *varsIDs, unsigned int* values, int nbVars, int maxMod
 		}
 	}
 
-	bool res = updateVariablesValues();
+	// only the components of the edited variables are solved
+	bool res = updateVariablesValues(varsIDs, nbVars);
 
 	_strongVars->clear();
 	delete _strongVars;
@@ -407,61 +719,246 @@ Solver::suggestValues(int *varsIDs, unsigned int* values, int nbVars, int maxMod
 bool
 Solver::updateVariablesValues()
 {
-	CustomSpace *result = solve();
+	vector<int> compIDs;
 
-	if (result == NULL) {
-		return false;
+	// the values are solved after the construction
+	if (_bulk)
+	{
+		_solvedVars.clear();
+		return true;
 	}
 
+	// the values of the other components already satisfy their constraints
+	for (map<int, SolverComponent*>::iterator p = _componentsMap->begin(); p != _componentsMap->end(); p++)
+		if ((p->second)->dirty || (p->second)->changed)
+			compIDs.push_back(p->first);
+
+	return solveComponents(compIDs);
+}
 
-	if (_space)
+bool
+Solver::updateVariablesValues(int *varsIDs, int nbVars)
+{
+	vector<int> compIDs;
+
+	// the values are solved after the construction
+	if (_bulk)
 	{
-		delete _space;
-		_space = NULL;
+		_solvedVars.clear();
+		return true;
 	}
-	_space = (CustomSpace*)result->clone(false);
-	delete result; // des fois a merde !!!
 
-	for (map<int, IntegerVariable*>::iterator q = _integerVariablesMap->begin(); q != _integerVariablesMap->end(); q++)
-		(q->second)->updateValue(_space);
+	for (int i=0; i<nbVars; i++)
+	{
+		map<int, int>::iterator p = _variableComponent->find(varsIDs[i]);
+		if (p == _variableComponent->end())
+			return false;
 
-	return true;
+		if (std::find(compIDs.begin(), compIDs.end(), p->second) == compIDs.end())
+			compIDs.push_back(p->second);
+	}
+
+	return solveComponents(compIDs);
 }
 
-CustomSpace *
-Solver::solve()
+void
+Solver::startBulk()
 {
-	updateState();
+	_bulk = true;
+}
 
-	// branch variables
-	_space->doBranching();
+void
+Solver::endBulk()
+{
+	_bulk = false;
+}
 
-	return run();
+const vector<int> &
+Solver::getSolvedVariables() const
+{
+	return _solvedVars;
 }
 
+bool
+Solver::solveComponents(vector<int> &compIDs)
+{
+	vector<SolverComponent*> comps;
 
-// Returns the best solution, NULL if the system can't be solved
-CustomSpace *
-Solver::run()
+	_solvedVars.clear();
+
+	// split the components whose constraints have been removed before to solve them
+	for (unsigned int i=0; i<compIDs.size(); i++)
+	{
+		int firstID = _nextComponentID;
+
+		updateComponent(compIDs[i]);
+		comps.push_back((*_componentsMap)[compIDs[i]]);
+
+		// the parts of a split component are solved too
+		for (int newID = firstID; newID < _nextComponentID; newID++)
+			comps.push_back((*_componentsMap)[newID]);
+	}
+
+	// the components share nothing : each thread solves its share of them in its own spaces
+	unsigned int nbThreads = comps.size();
+	unsigned int nbCPUs = sysconf(_SC_NPROCESSORS_ONLN);
+
+	if (nbThreads > nbCPUs)
+		nbThreads = nbCPUs;
+
+	if (nbThreads < 1)
+		nbThreads = 1;
+
+	vector<pthread_t> threads(nbThreads);
+	vector<SolverThreadArgs> args(nbThreads);
+
+	for (unsigned int i=0; i<nbThreads; i++)
+	{
+		args[i].solver = this;
+		args[i].components = &comps;
+		args[i].first = i;
+		args[i].step = nbThreads;
+	}
+
+	for (unsigned int i=1; i<nbThreads; i++)
+		pthread_create(&threads[i], NULL, &Solver::solveComponentsThread, &args[i]);
+
+	solveComponentsThread(&args[0]);
+
+	for (unsigned int i=1; i<nbThreads; i++)
+		pthread_join(threads[i], NULL);
+
+	bool res = true;
+
+	for (unsigned int i=0; i<comps.size(); i++)
+	{
+		if (!comps[i]->solved)
+		{
+			res = false;
+			continue;
+		}
+
+		_solvedVars.insert(_solvedVars.end(), comps[i]->vars.begin(), comps[i]->vars.end());
+	}
+
+	return res;
+}
+
+void *
+Solver::solveComponentsThread(void *arg)
+{
+	SolverThreadArgs *args = (SolverThreadArgs*)arg;
+
+	for (unsigned int i=args->first; i<args->components->size(); i+=args->step)
+		args->solver->solveComponent(args->components->at(i));
+
+	return NULL;
+}
+
+bool
+Solver::isStrongVar(int varID) const
+{
+	if (!_suggest)
+		return false;
+
+	for (unsigned int i=0; i<_strongVars->size(); i++)
+		if (_strongVars->at(i) == varID)
+			return true;
+
+	return false;
+}
+
+void
+Solver::solveComponent(SolverComponent *comp)
+{
+	if (comp->temporal)
+	{
+		solveTemporalComponent(comp);
+		return;
+	}
+
+	CustomSpace *edit = editState(comp);
+
+	comp->solved = false;
+
+	if (edit == NULL)
+		return;
+
+	// branch variables
+	edit->doBranching();
+
+	CustomSpace *result = run(edit, &comp->memoryPeak);
+
+	// the search engine works on its own copy
+	delete edit;
+
+	if (result == NULL)
+		return;
+
+	// the space keeps the variables and the constraints only : the values are kept by the variables
+	for (unsigned int i=0; i<comp->vars.size(); i++)
+		varFromID(comp->vars[i])->updateValue(result);
+
+	delete result; // des fois a merde !!!
+
+	comp->solved = true;
+	comp->dirty = false;
+}
+
+// the temporal network finds the closest values to the current ones (or to the suggested ones)
+// with the same domains as in editState
+void
+Solver::solveTemporalComponent(SolverComponent *comp)
 {
-	if (_engine)
+	comp->solved = false;
+
+	// the network already knows the constraints can't be satisfied
+	if (!comp->consistent)
+		return;
+
+	for (unsigned int i=0; i<comp->vars.size(); i++)
 	{
-		delete (_engine);
-		_engine = NULL;
+		IntegerVariable *currVar = varFromID(comp->vars[i]);
+
+		// when edition, the variables can't move further than the maximal modification
+		if ((_suggest) && (_maxModification != NO_MAX_MODIFICATION)) {
+			currVar->adjustMinMax(_suggest, _maxModification);
+		} else {
+			currVar->adjustMinMax(_suggest);
+		}
+
+		// the edited variables have to reach their wanted value
+		_temporalNetwork->suggest(comp->vars[i], currVar->getVal(), currVar->getMin(), currVar->getMax(), isStrongVar(comp->vars[i]));
 	}
 
+	if (!_temporalNetwork->solve(comp->vars))
+		return;
+
+	for (unsigned int i=0; i<comp->vars.size(); i++)
+		varFromID(comp->vars[i])->updateValue(_temporalNetwork->getValue(comp->vars[i]));
+
+	comp->solved = true;
+	comp->dirty = false;
+}
+
+
+// Returns the best solution, NULL if the system can't be solved
+CustomSpace *
+Solver::run(CustomSpace *space, int *memoryPeak)
+{
 	Search::TimeStop* ts = new Search::TimeStop(100);
 	Search::Options o;
 
 	o.stop = ts;
 
-	_engine = new SearchEngine(_space, o);
+	// an engine for each solve as the components can be solved at the same time
+	SearchEngine *engine = new SearchEngine(space, o);
 
 	CustomSpace *last = NULL;
 
 	while (true)
 	{
-		CustomSpace *ex = _engine->next();
+		CustomSpace *ex = engine->next();
 
 		// When there's no better solution, stop the search
 		if (ex == NULL)
@@ -477,6 +974,9 @@ Solver::run()
 		delete(ex);
 	}
 
+	*memoryPeak = engine->getMemoryPeak();
+
+	delete engine;
 	delete ts;
 
 	return last;
@@ -485,8 +985,13 @@ Solver::run()
 int
 Solver::getMemoryPeak()
 {
-	if (_engine) return _engine->getMemoryPeak();
-	return 0;
+	int peak = 0;
+
+	for (map<int, SolverComponent*>::iterator p = _componentsMap->begin(); p != _componentsMap->end(); p++)
+		if ((p->second)->memoryPeak > peak)
+			peak = (p->second)->memoryPeak;
+
+	return peak;
 }
 
 int
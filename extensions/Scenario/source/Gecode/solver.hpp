@@ -42,14 +42,54 @@ knowledge of the CeCILL-C license and that you accept its terms.
 #include "gecode_headers.hpp"
 #include "relations_type.hpp"
 
+#include <set>
+
 class CustomSpace;
 class IntegerVariable;
 class LinearConstraint;
 class SearchEngine;
+class TemporalNetwork;
 class linearConstraint;
 
 #define NO_MAX_MODIFICATION 0
 
+///////////////////////////////////////////////////////////////////////
+//
+// A connected component of the constraint graph : its variables
+// don't share any constraint with the variables of the other
+// components so it is solved alone, in its own Gecode space
+// or by the TemporalNetwork if it only has difference constraints.
+//
+///////////////////////////////////////////////////////////////////////
+
+struct SolverComponent {
+
+	// Gecode space holding the variables and the constraints of the component between the solves
+	// (NULL for a temporal component)
+	CustomSpace *space;
+
+	// IDs of the variables and of the constraints of the component
+	vector<int> vars;
+	vector<int> constraints;
+
+	// true if a variable or a constraint has been removed or replaced since the space was built
+	// (the component may be split in several components)
+	bool changed;
+
+	// true if the values of the variables may not satisfy the constraints anymore
+	bool dirty;
+
+	// true if all the constraints are differences between two variables (cf TemporalNetwork)
+	bool temporal;
+
+	// false if the temporal network found that the constraints can't be satisfied
+	bool consistent;
+
+	// result of the last solve
+	bool solved;
+	int memoryPeak;
+};
+
 ///////////////////////////////////////////////////////////////////////
 //
 // Top-level interface for the Gecode Solver.
@@ -63,30 +103,82 @@ class Solver {
 
 private :
 
-	// Gecode space
-	CustomSpace *_space;
-
 	// Hash table containing the currently used variables
 	map<int, IntegerVariable*> *_integerVariablesMap;
 
 	// Hash table containing linear constraints
 	map<int, LinearConstraint*> *_constraintsMap;
 
-	// The search engine to find a solution
-	SearchEngine *_engine;
+	// Hash table containing the connected components of the constraint graph
+	map<int, SolverComponent*> *_componentsMap;
+
+	// The component of each variable
+	map<int, int> *_variableComponent;
+
+	// The constraints of each variable
+	map<int, vector<int> > *_variableConstraints;
+
+	// The ID of the next component
+	int _nextComponentID;
 
-	// Reloads all variables and constraints
-	void updateState();
+	// The variables of the components solved by the last solve
+	vector<int> _solvedVars;
+
+	// Simple Temporal Network holding all the variables and the difference constraints
+	TemporalNetwork *_temporalNetwork;
+
+	// Creates a component with an empty space and returns its ID
+	int newComponent();
+
+	// Moves the variables and the constraints of the smallest component into the other one
+	// returns the ID of the remaining component
+	int mergeComponents(int compID1, int compID2);
+
+	// Builds the spaces again if a variable or a constraint of the component has been removed or replaced
+	// (the parts which aren't connected anymore become new components)
+	void updateComponent(int compID);
+
+	// Adds the Gecode variables of some variables to a space, sizing its array once
+	void addVariablesToSpace(const vector<int> &varsIDs, CustomSpace *space);
+
+	// Clones the space of a component with the values to reach and the objective function
+	// returns NULL if the space is failed
+	CustomSpace *editState(SolverComponent *comp);
+
+	// true if the variable is edited by the current suggestion
+	bool isStrongVar(int varID) const;
+
+	// Finds a solution for the variables of a component
+	void solveComponent(SolverComponent *comp);
+
+	// Finds a solution for the variables of a temporal component without Gecode
+	void solveTemporalComponent(SolverComponent *comp);
+
+	// Solves some components, in parallel if there are several ones
+	// returns false if one of them can't be solved
+	bool solveComponents(vector<int> &compIDs);
+
+	// Solves a share of the components of solveComponents in a thread
+	static void *solveComponentsThread(void *arg);
 
 	// Get the relation type as defined by Gecode
 	static IntRelType getGecodeRelType(int relType);
 
 	// Find the lowest ID to insert a new element in a map
-	int findNewRelationID() const;
-	int findNewVariableID() const;
+	int findNewRelationID();
+	int findNewVariableID();
+
+	// The IDs of the removed elements (lower than the next IDs) to use them again
+	std::set<int> _freeRelationIDs;
+	std::set<int> _freeVariableIDs;
+	int _nextRelationID;
+	int _nextVariableID;
+
+	// true between startBulk and endBulk
+	bool _bulk;
 
 	// Launch the search engine
-	CustomSpace *run();
+	static CustomSpace *run(CustomSpace *space, int *memoryPeak);
 
 	// To put strong variables when edition
 	vector<int> *_strongVars ;
@@ -105,9 +197,6 @@ public :
 	IntegerVariable *varFromID(int varID) const;
 	LinearConstraint *constraintFromID(int constID) const;
 
-	// Accessor to the CustomSpace Pointer
-	CustomSpace *getSpace() const;
-
 	// inserts a new entry in the variables map and return the variable ID
 	int addIntVar(int min, int max, int val, int weight);
 	
@@ -122,16 +211,25 @@ public :
 	// remove a constraint from the solver
 	bool removeConstraint(int constID); 
 
+	// between startBulk and endBulk (e.g. when loading a score) the variables and the constraints are only stored :
+	// the space (or the temporal network bounds) of each component is built once, in a single pass, at its next solve
+	// and the values aren't updated
+	void startBulk();
+	void endBulk();
+
 	// check if the new value for the variable 'varID' is in the variable's domain
+	// (only the components of the edited variables are solved)
 	bool suggestValues(int *varsIDs, unsigned int* values, int nbVars, int maxModification = NO_MAX_MODIFICATION);
 
-	// find a solution to the system
-	// returns NULL if there's no solution
-	CustomSpace *solve();
-
-	// update the value of each variable
+	// update the value of each variable whose constraints changed since the last solve
 	bool updateVariablesValues();
 
+	// update the value of each variable of the components of some variables
+	bool updateVariablesValues(int *varsIDs, int nbVars);
+
+	// get the IDs of the variables whose value has been solved by the last solve
+	const vector<int> &getSolvedVariables() const;
+
 	// get the values for each variable
 	int getVariableValue(int varID) const;
 	int getVariableMin(int varID) const;
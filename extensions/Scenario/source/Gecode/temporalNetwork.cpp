@@ -0,0 +1,355 @@
+/*
+Copyright: LaBRI (http://www.labri.fr)
+
+Author(s): Score contributors
+Last modification: 17/10/2026
+
+Adviser(s): Myriam Desainte-Catherine (myriam.desainte-catherine@labri.fr)
+
+This software is a computer program whose purpose is to propose
+a library for interactive scores edition and execution.
+
+This software is governed by the CeCILL-C license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL-C
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "temporalNetwork.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+// a node to visit during a propagation, ordered by its distance (cf TemporalNetwork::distance)
+typedef std::pair<long long, TemporalNode*> TemporalStep;
+
+TemporalNetwork::TemporalNetwork()
+{
+}
+
+TemporalNetwork::~TemporalNetwork()
+{
+}
+
+void
+TemporalNetwork::setNode(int id, int min, int max, int value)
+{
+	TemporalNode &node = _nodes[id];
+
+	node.min = min;
+	node.max = max;
+	node.lower[NETWORK_BOUNDS] = min;
+	node.upper[NETWORK_BOUNDS] = max;
+	node.value = value;
+	node.solution = value;
+	node.passes = 0;
+}
+
+void
+TemporalNetwork::setValue(int id, int value)
+{
+	map<int, TemporalNode>::iterator p = _nodes.find(id);
+	if (p != _nodes.end())
+		p->second.value = value;
+}
+
+void
+TemporalNetwork::removeNode(int id)
+{
+	_nodes.erase(id);
+}
+
+void
+TemporalNetwork::addEdge(int id, int from, int to, int min, int max)
+{
+	TemporalEdge &edge = _edges[id];
+
+	edge.from = &_nodes[from];
+	edge.to = &_nodes[to];
+	edge.min = min;
+	edge.max = max;
+
+	edge.from->edges.push_back(&edge);
+	edge.to->edges.push_back(&edge);
+}
+
+void
+TemporalNetwork::removeEdge(int id)
+{
+	map<int, TemporalEdge>::iterator p = _edges.find(id);
+	if (p == _edges.end())
+		return;
+
+	TemporalEdge *edge = &(p->second);
+	vector<TemporalEdge*> &fromEdges = edge->from->edges;
+	vector<TemporalEdge*> &toEdges = edge->to->edges;
+
+	fromEdges.erase(std::remove(fromEdges.begin(), fromEdges.end(), edge), fromEdges.end());
+	toEdges.erase(std::remove(toEdges.begin(), toEdges.end(), edge), toEdges.end());
+
+	_edges.erase(p);
+}
+
+bool
+TemporalNetwork::reset(const vector<int> &ids)
+{
+	vector<TemporalNode*> nodes;
+
+	for (unsigned int i=0; i<ids.size(); i++)
+	{
+		TemporalNode *node = &_nodes[ids[i]];
+
+		node->lower[NETWORK_BOUNDS] = node->min;
+		node->upper[NETWORK_BOUNDS] = node->max;
+		nodes.push_back(node);
+	}
+
+	return propagate(nodes, NETWORK_BOUNDS, nodes.size() + 1);
+}
+
+bool
+TemporalNetwork::propagate(int from, int to, unsigned int nbNodes)
+{
+	vector<TemporalNode*> nodes;
+
+	nodes.push_back(&_nodes[from]);
+	nodes.push_back(&_nodes[to]);
+
+	return propagate(nodes, NETWORK_BOUNDS, nbNodes + 1);
+}
+
+bool
+TemporalNetwork::propagate(vector<TemporalNode*> &nodes, int bounds, unsigned int maxPasses)
+{
+	for (unsigned int i=0; i<nodes.size(); i++)
+		if (nodes[i]->lower[bounds] > nodes[i]->upper[bounds])
+			return false;
+
+	// the upper bounds and the lower bounds don't depend on each other
+	return propagate(nodes, bounds, true, maxPasses) && propagate(nodes, bounds, false, maxPasses);
+}
+
+// the bounds are the shortest paths from the domains : the potential of a node makes the reduced cost of its edges
+// positive, so the nodes can be visited in the order of Dijkstra's algorithm (each node once) instead of Bellman-Ford's.
+// For a solve the bounds of the network satisfy the edges, otherwise the current values are used
+// (if they don't satisfy the edges, the nodes are visited again until the bounds don't change)
+long long
+TemporalNetwork::distance(TemporalNode *node, int bounds, bool upper)
+{
+	if (upper)
+		return (long long)node->upper[bounds] - (bounds == SOLVE_BOUNDS ? node->upper[NETWORK_BOUNDS] : node->value);
+	else
+		return (long long)(bounds == SOLVE_BOUNDS ? node->lower[NETWORK_BOUNDS] : node->value) - node->lower[bounds];
+}
+
+bool
+TemporalNetwork::propagate(vector<TemporalNode*> &nodes, int bounds, bool upper, unsigned int maxPasses)
+{
+	std::priority_queue<TemporalStep, vector<TemporalStep>, std::greater<TemporalStep> > steps;
+	vector<TemporalNode*> visited;
+	bool consistent = true;
+
+	for (unsigned int i=0; i<nodes.size(); i++)
+		steps.push(TemporalStep(distance(nodes[i], bounds, upper), nodes[i]));
+
+	while (consistent && !steps.empty())
+	{
+		TemporalStep step = steps.top();
+		steps.pop();
+
+		TemporalNode *node = step.second;
+
+		// the node has been tightened again since this step
+		if (step.first != distance(node, bounds, upper))
+			continue;
+
+		if (node->passes++ == 0)
+			visited.push_back(node);
+
+		// in a consistent network a node can't be tightened more times than there are nodes
+		if (node->passes > maxPasses)
+		{
+			consistent = false;
+			break;
+		}
+
+		for (unsigned int i=0; i<node->edges.size(); i++)
+		{
+			TemporalEdge *edge = node->edges[i];
+			TemporalNode *other;
+			long long bound;
+
+			// other - node is within [min, max] or [-max, -min]
+			if (edge->from == node)
+			{
+				other = edge->to;
+
+				if (upper && edge->max != TEMPORAL_PLUS_INFINITY)
+					bound = (long long)node->upper[bounds] + edge->max;
+				else if (!upper && edge->min != TEMPORAL_MINUS_INFINITY)
+					bound = (long long)node->lower[bounds] + edge->min;
+				else
+					continue;
+			}
+			else
+			{
+				other = edge->from;
+
+				if (upper && edge->min != TEMPORAL_MINUS_INFINITY)
+					bound = (long long)node->upper[bounds] - edge->min;
+				else if (!upper && edge->max != TEMPORAL_PLUS_INFINITY)
+					bound = (long long)node->lower[bounds] - edge->max;
+				else
+					continue;
+			}
+
+			if (upper && bound < other->upper[bounds])
+				other->upper[bounds] = bound;
+			else if (!upper && bound > other->lower[bounds])
+				other->lower[bounds] = bound;
+			else
+				continue;
+
+			if (other->lower[bounds] > other->upper[bounds])
+			{
+				consistent = false;
+				break;
+			}
+
+			steps.push(TemporalStep(distance(other, bounds, upper), other));
+		}
+	}
+
+	for (unsigned int i=0; i<visited.size(); i++)
+		visited[i]->passes = 0;
+
+	return consistent;
+}
+
+int
+TemporalNetwork::clamp(int value, int lower, int upper)
+{
+	if (value < lower)
+		return lower;
+
+	if (value > upper)
+		return upper;
+
+	return value;
+}
+
+void
+TemporalNetwork::suggest(int id, int value, int min, int max, bool fixed)
+{
+	map<int, TemporalNode>::iterator p = _nodes.find(id);
+	if (p == _nodes.end())
+		return;
+
+	TemporalNode &node = p->second;
+
+	node.value = value;
+	node.lower[SOLVE_BOUNDS] = fixed ? value : min;
+	node.upper[SOLVE_BOUNDS] = fixed ? value : max;
+}
+
+// each date is clamped to the bounds implied by the fixed dates :
+// when the former values satisfied the edges, the clamped values satisfy them too
+// and each of them is the closest possible to its value to reach.
+// Otherwise the dates are fixed one after the other, propagating each of them.
+bool
+TemporalNetwork::solve(const vector<int> &ids)
+{
+	vector<TemporalNode*> nodes;
+
+	for (unsigned int i=0; i<ids.size(); i++)
+	{
+		map<int, TemporalNode>::iterator p = _nodes.find(ids[i]);
+		if (p == _nodes.end())
+			return false;
+
+		TemporalNode *node = &(p->second);
+
+		// the bounds of the network are implied by the domains
+		if (node->lower[NETWORK_BOUNDS] > node->lower[SOLVE_BOUNDS])
+			node->lower[SOLVE_BOUNDS] = node->lower[NETWORK_BOUNDS];
+		if (node->upper[NETWORK_BOUNDS] < node->upper[SOLVE_BOUNDS])
+			node->upper[SOLVE_BOUNDS] = node->upper[NETWORK_BOUNDS];
+
+		nodes.push_back(node);
+	}
+
+	if (!propagate(nodes, SOLVE_BOUNDS, nodes.size() + 1))
+		return false;
+
+	bool satisfied = true;
+
+	for (unsigned int i=0; i<nodes.size(); i++)
+		nodes[i]->solution = clamp(nodes[i]->value, nodes[i]->lower[SOLVE_BOUNDS], nodes[i]->upper[SOLVE_BOUNDS]);
+
+	for (unsigned int i=0; i<nodes.size() && satisfied; i++)
+		for (unsigned int j=0; j<nodes[i]->edges.size(); j++)
+		{
+			TemporalEdge *edge = nodes[i]->edges[j];
+			int difference = edge->to->solution - edge->from->solution;
+
+			if (edge->from != nodes[i])
+				continue;
+
+			if ((edge->min != TEMPORAL_MINUS_INFINITY && difference < edge->min) ||
+				(edge->max != TEMPORAL_PLUS_INFINITY && difference > edge->max))
+			{
+				satisfied = false;
+				break;
+			}
+		}
+
+	for (unsigned int i=0; i<nodes.size() && !satisfied; i++)
+	{
+		vector<TemporalNode*> fixed(1, nodes[i]);
+
+		nodes[i]->solution = clamp(nodes[i]->value, nodes[i]->lower[SOLVE_BOUNDS], nodes[i]->upper[SOLVE_BOUNDS]);
+		nodes[i]->lower[SOLVE_BOUNDS] = nodes[i]->solution;
+		nodes[i]->upper[SOLVE_BOUNDS] = nodes[i]->solution;
+
+		if (!propagate(fixed, SOLVE_BOUNDS, nodes.size() + 1))
+			return false;
+	}
+
+	// the solution is the current value of the next propagations
+	for (unsigned int i=0; i<nodes.size(); i++)
+		nodes[i]->value = nodes[i]->solution;
+
+	return true;
+}
+
+int
+TemporalNetwork::getValue(int id) const
+{
+	map<int, TemporalNode>::const_iterator p = _nodes.find(id);
+	if (p == _nodes.end())
+		return -1;
+
+	return p->second.solution;
+}
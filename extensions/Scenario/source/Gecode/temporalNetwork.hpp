@@ -0,0 +1,159 @@
+/*
+Copyright: LaBRI (http://www.labri.fr)
+
+Author(s): Score contributors
+Last modification: 17/10/2026
+
+Adviser(s): Myriam Desainte-Catherine (myriam.desainte-catherine@labri.fr)
+
+This software is a computer program whose purpose is to propose
+a library for interactive scores edition and execution.
+
+This software is governed by the CeCILL-C license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL-C
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef TEMPORAL_NETWORK_H
+#define TEMPORAL_NETWORK_H
+
+#include <climits>
+#include <map>
+#include <vector>
+
+using std::map;
+using std::vector;
+
+// bounds of an edge without minimum or without maximum
+#define TEMPORAL_MINUS_INFINITY INT_MIN
+#define TEMPORAL_PLUS_INFINITY INT_MAX
+
+// the bounds of a node implied by the edges of the network, or by the edges and the values to reach of a solve
+#define NETWORK_BOUNDS 0
+#define SOLVE_BOUNDS 1
+
+struct TemporalEdge;
+
+// a date bounded by a domain
+struct TemporalNode {
+
+	int min;
+	int max;
+
+	// the bounds implied by the edges (cf NETWORK_BOUNDS and SOLVE_BOUNDS)
+	int lower[2];
+	int upper[2];
+
+	// the current value (the value to reach during a solve) and the value found by the last solve
+	int value;
+	int solution;
+
+	vector<TemporalEdge*> edges;
+
+	// used during the propagation
+	unsigned int passes;
+};
+
+// a difference between two dates : min <= to - from <= max
+struct TemporalEdge {
+
+	TemporalNode *from;
+	TemporalNode *to;
+	int min;
+	int max;
+};
+
+///////////////////////////////////////////////////////////////////////
+//
+// A Simple Temporal Network solves the linear constraints of the
+// form min <= date_j - date_i <= max without any search :
+// the bounds of each date are tightened by a shortest-path propagation
+// from the edited dates only, and a move clamps each date to its bounds.
+// The Solver uses it for the components having only such constraints.
+//
+///////////////////////////////////////////////////////////////////////
+
+class TemporalNetwork {
+
+private :
+
+	// Hash table containing the nodes
+	map<int, TemporalNode> _nodes;
+
+	// Hash table containing the edges
+	map<int, TemporalEdge> _edges;
+
+	// Tightens the bounds of the nodes connected to some nodes until they are all satisfied
+	// returns false if the bounds of a node are crossed (or if a node is tightened more than maxPasses times)
+	static bool propagate(vector<TemporalNode*> &nodes, int bounds, unsigned int maxPasses);
+
+	// Tightens the upper (or the lower) bounds only
+	static bool propagate(vector<TemporalNode*> &nodes, int bounds, bool upper, unsigned int maxPasses);
+
+	// The distance between a bound and the potential of a node, used to visit the nodes in order
+	static long long distance(TemporalNode *node, int bounds, bool upper);
+
+	static int clamp(int value, int lower, int upper);
+
+public :
+
+	TemporalNetwork();
+	~TemporalNetwork();
+
+	// adds a node or changes its domain
+	void setNode(int id, int min, int max, int value);
+
+	// sets the current value of a node
+	void setValue(int id, int value);
+
+	// removes a node (its edges have to be removed before)
+	void removeNode(int id);
+
+	// adds an edge : min <= date(to) - date(from) <= max
+	void addEdge(int id, int from, int to, int min, int max);
+
+	void removeEdge(int id);
+
+	// computes the bounds of some nodes again from their domain
+	// returns false if the nodes can't satisfy their edges
+	bool reset(const vector<int> &ids);
+
+	// tightens the bounds of the nodes connected to the ends of a new edge
+	// returns false if the nodes can't satisfy their edges anymore
+	bool propagate(int from, int to, unsigned int nbNodes);
+
+	// sets the value to reach and the domain of a node for the next solve
+	// (a fixed node has to reach its value)
+	void suggest(int id, int value, int min, int max, bool fixed);
+
+	// finds the closest values to the values to reach which satisfy the edges between some nodes
+	// returns false if there's no solution
+	bool solve(const vector<int> &ids);
+
+	// get the value found by the last solve
+	int getValue(int id) const;
+};
+
+#endif // TEMPORAL_NETWORK_H
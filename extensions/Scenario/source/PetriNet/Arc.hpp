@@ -80,6 +80,7 @@ class Arc : public PetriNetItem // CB TODO : setFrom et setTo, pour ne pas avoir
 {
 public:
 	friend class PetriNet;
+	friend class ExecutionPlan;
 
 	/*!
 	 * Gets the node where this arc come from.
@@ -311,6 +312,9 @@ private:
 
 	// Number of this Arc if it goes into a transition.
 	int m_number;
+
+	// Index of this Arc in the ExecutionPlan of its PetriNet.
+	unsigned int m_planIndex;
     
     // Function that tells wether or not the arc can be activated.
     bool m_condition; // CB TODO : Devrait être un prédicat, pour l'instant, un simple booléen
@@ -0,0 +1,147 @@
+/*
+Copyright: LaBRI (http://www.labri.fr)
+
+Author(s): Score contributors
+Last modification: 17/10/2026
+
+Adviser(s): Myriam Desainte-Catherine (myriam.desainte-catherine@labri.fr)
+
+This software is a computer program whose purpose is to propose
+a library for interactive scores edition and execution.
+
+This software is governed by the CeCILL-C license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL-C
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+/*!
+ * \file EventSet.cpp
+ * \author Score contributors
+ * \date 2026
+ */
+
+#include "EventSet.hpp"
+
+EventSet::EventSet(unsigned int capacity)
+{
+	unsigned int size = 1;
+
+	while (size < capacity) {
+		size <<= 1;
+	}
+
+	m_events.resize(size, 0);
+	m_stamps.resize(size, 0);
+
+	m_stamp = 1;
+	m_size = 0;
+	m_mask = size - 1;
+}
+
+EventSet::~EventSet()
+{
+}
+
+void EventSet::insert(void* event)
+{
+	unsigned int slot = findSlot(event);
+
+	if (m_stamps[slot] == m_stamp) {
+		return;
+	}
+
+	m_events[slot] = event;
+	m_stamps[slot] = m_stamp;
+	++m_size;
+
+	// keep at least half of the slots empty so the probing stays short
+	if (2 * m_size > m_mask + 1) {
+		grow();
+	}
+}
+
+bool EventSet::contains(void* event)
+{
+	return m_stamps[findSlot(event)] == m_stamp;
+}
+
+void EventSet::clear()
+{
+	m_size = 0;
+	++m_stamp;
+
+	// the stamp went round : forget the stamps of the former steps for real
+	if (m_stamp == 0) {
+		m_stamps.assign(m_stamps.size(), 0);
+		m_stamp = 1;
+	}
+}
+
+unsigned int EventSet::size()
+{
+	return m_size;
+}
+
+std::list<void*> EventSet::getList()
+{
+	std::list<void*> events;
+
+	for (unsigned int i = 0 ; i < m_events.size() ; ++i) {
+		if (m_stamps[i] == m_stamp) {
+			events.push_back(m_events[i]);
+		}
+	}
+
+	return events;
+}
+
+unsigned int EventSet::findSlot(void* event)
+{
+	// multiplicative hash of the pointer (the lowest bits are always 0 because of the alignment)
+	unsigned int slot = (unsigned int) ((((unsigned long) event) >> 3) * 2654435761u) & m_mask;
+
+	// linear probing until the event or an empty slot
+	while (m_stamps[slot] == m_stamp && m_events[slot] != event) {
+		slot = (slot + 1) & m_mask;
+	}
+
+	return slot;
+}
+
+void EventSet::grow()
+{
+	std::list<void*> events = getList();
+
+	m_events.assign(2 * (m_mask + 1), 0);
+	m_stamps.assign(2 * (m_mask + 1), 0);
+
+	m_stamp = 1;
+	m_size = 0;
+	m_mask = 2 * m_mask + 1;
+
+	for (std::list<void*>::iterator it = events.begin() ; it != events.end() ; ++it) {
+		insert(*it);
+	}
+}
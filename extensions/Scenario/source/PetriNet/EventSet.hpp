@@ -0,0 +1,132 @@
+/*
+Copyright: LaBRI (http://www.labri.fr)
+
+Author(s): Score contributors
+Last modification: 17/10/2026
+
+Adviser(s): Myriam Desainte-Catherine (myriam.desainte-catherine@labri.fr)
+
+This software is a computer program whose purpose is to propose
+a library for interactive scores edition and execution.
+
+This software is governed by the CeCILL-C license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL-C
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef EVENTSET_HPP_
+#define EVENTSET_HPP_
+
+/*!
+ * \file EventSet.hpp
+ * \author Score contributors
+ * \date 2026
+ */
+
+#include <list>
+#include <vector>
+
+/*!
+ * \class EventSet
+ *
+ * Hash set of events (pointer) received during one step of a Petri Network.
+ *
+ * Testing an event is O(1). Clearing the set is O(1) : each slot is stamped
+ * with the step when it was filled, so the slots of the former steps are
+ * considered empty. Memory is only allocated when the set grows beyond its
+ * former size.
+ */
+class EventSet
+{
+public:
+	/*!
+	 * Constructor
+	 *
+	 * \param capacity : initial number of slots (increased to the next power of two).
+	 */
+	EventSet(unsigned int capacity = 64);
+
+	/*!
+	 * Destructor
+	 */
+	~EventSet();
+
+	/*!
+	 * Adds an event in the set.
+	 *
+	 * \param event : the event to add.
+	 */
+	void insert(void* event);
+
+	/*!
+	 * Tests if an event is in the set.
+	 *
+	 * \param event : the event to test.
+	 * \return true if the event is in the set.
+	 */
+	bool contains(void* event);
+
+	/*!
+	 * Removes all the events.
+	 */
+	void clear();
+
+	/*!
+	 * Gets the number of events in the set.
+	 *
+	 * \return the number of events.
+	 */
+	unsigned int size();
+
+	/*!
+	 * Gets the events in the set.
+	 *
+	 * \return a list of the events.
+	 */
+	std::list<void*> getList();
+
+private:
+	/*!
+	 * Gets the slot where an event is or should be.
+	 *
+	 * \param event : an event.
+	 * \return the slot index.
+	 */
+	unsigned int findSlot(void* event);
+
+	/*!
+	 * Doubles the number of slots and inserts the events again.
+	 */
+	void grow();
+
+	std::vector<void*> m_events; // events of each slot.
+	std::vector<unsigned int> m_stamps; // step stamp of each slot.
+
+	unsigned int m_stamp; // stamp of the current step.
+	unsigned int m_size; // number of events in the current step.
+	unsigned int m_mask; // number of slots - 1 (number of slots is a power of two).
+};
+
+#endif /*EVENTSET_HPP_*/
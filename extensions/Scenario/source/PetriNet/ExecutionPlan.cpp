@@ -0,0 +1,459 @@
+/*
+Copyright: LaBRI (http://www.labri.fr)
+
+Author(s): Score contributors
+Last modification: 17/10/2026
+
+Adviser(s): Myriam Desainte-Catherine (myriam.desainte-catherine@labri.fr)
+
+This software is a computer program whose purpose is to propose
+a library for interactive scores edition and execution.
+
+This software is governed by the CeCILL-C license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL-C
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+/*!
+ * \file ExecutionPlan.cpp
+ * \author Score contributors
+ * \date 2026
+ */
+
+#include "ExecutionPlan.hpp"
+
+#include "PetriNet.hpp"
+#include "PetriNetValidator.hpp"
+
+#include <algorithm>
+
+bool ExecutionPlan::canExecute(PetriNet* petriNet)
+{
+	PetriNetValidator validator(petriNet);
+
+	return canExecute(petriNet, validator);
+}
+
+bool ExecutionPlan::canExecute(PetriNet* petriNet, PetriNetValidator& validator)
+{
+	if (petriNet->m_nbColors != 1 || !petriNet->m_childrenPetriNet.empty()) {
+		return false;
+	}
+
+	for (unsigned int i = 0; i < petriNet->m_places.size(); ++i) {
+		if (petriNet->m_places[i]->m_childPetriNet != NULL) {
+			return false;
+		}
+	}
+
+	for (unsigned int i = 0; i < petriNet->m_transitions.size(); ++i) {
+		if (petriNet->m_transitions[i]->m_petriNetToEnd != NULL) {
+			return false;
+		}
+	}
+
+	// the plan doesn't check anything while stepping (the validator checks the start and end places as well)
+	return validator.validate();
+}
+
+ExecutionPlan::ExecutionPlan(PetriNet* petriNet)
+{
+	const placeList& places = petriNet->m_places;
+	const transitionList& transitions = petriNet->m_transitions;
+
+	m_petriNet = petriNet;
+	m_resetStamp = 0;
+
+	for (unsigned int i = 0; i < places.size(); ++i) {
+		places[i]->m_planIndex = i; // the items keep their index : no map to look them up while building the plan
+	}
+
+	m_startPlace = petriNet->m_startPlace->m_planIndex;
+	m_endPlace = petriNet->m_endPlace->m_planIndex;
+
+	// transitions and their in-going arcs
+	for (unsigned int i = 0; i < transitions.size(); ++i) {
+		Transition* transition = transitions[i];
+		ArcRange inGoingArcs = transition->inGoingArcsOf();
+		ArcRange outGoingArcs = transition->outGoingArcsOf();
+		unsigned int activeArcs = 0;
+
+		transition->m_planIndex = i;
+
+		m_transitions.push_back(transition);
+		m_transitionArcsBegin.push_back(m_arcPlaces.size());
+
+		for (unsigned int j = 0; j < inGoingArcs.size(); ++j) {
+			Arc* arc = inGoingArcs[j];
+			bool active = false;
+
+			if (transition->m_activeArcsBitArray != NULL && arc->getNumber() >= 0) {
+				active = transition->m_activeArcsBitArray->isOne(arc->getNumber());
+			}
+
+			if (active) {
+				++activeArcs;
+			}
+
+			arc->m_planIndex = m_arcPlaces.size();
+
+			m_arcPlaces.push_back(((Place*) arc->getFrom())->m_planIndex);
+			m_arcTransitions.push_back(i);
+			m_arcRelativeMins.push_back(toDate(arc->getRelativeMinValue()));
+			m_arcRelativeMaxs.push_back(toDate(arc->getRelativeMaxValue()));
+			m_arcAbsoluteMins.push_back(toDate(arc->getAbsoluteMinValue()));
+			m_arcAbsoluteMaxs.push_back(toDate(arc->getAbsoluteMaxValue()));
+			m_arcActives.push_back(active);
+		}
+
+		m_transitionPlacesBegin.push_back(m_transitionPlaces.size());
+
+		for (unsigned int j = 0; j < outGoingArcs.size(); ++j) {
+			m_transitionPlaces.push_back(((Place*) outGoingArcs[j]->getTo())->m_planIndex);
+		}
+
+		m_transitionActionsBegin.push_back(m_actionFunctions.size());
+
+		for (unsigned int j = 0; j < transition->m_externActions.size(); ++j) {
+			m_actionFunctions.push_back(transition->m_externActions[j]->m_transitionAction);
+			m_actionArguments.push_back(transition->m_externActions[j]->m_transitionActionArgument);
+		}
+
+		m_transitionEvents.push_back(transition->getEvent());
+		m_transitionStatics.push_back(transition->isStatic());
+		m_transitionActiveArcs.push_back(activeArcs);
+		m_transitionStartDates.push_back(toDate(transition->m_startDate));
+		m_transitionEndDates.push_back(toDate(transition->m_endDate));
+		m_transitionStartActions.push_back(transition->m_startAction);
+		m_transitionEndActions.push_back(transition->m_endAction);
+		m_transitionResetStamps.push_back(0);
+	}
+
+	m_transitionArcsBegin.push_back(m_arcPlaces.size());
+	m_transitionPlacesBegin.push_back(m_transitionPlaces.size());
+	m_transitionActionsBegin.push_back(m_actionFunctions.size());
+
+	// places and their out-going arcs
+	for (unsigned int i = 0; i < places.size(); ++i) {
+		ArcRange outGoingArcs = places[i]->outGoingArcsOf();
+
+		m_placeTokens.push_back(places[i]->m_tokenByColor[0]);
+		m_placeArcsBegin.push_back(m_placeArcs.size());
+
+		for (unsigned int j = 0; j < outGoingArcs.size(); ++j) {
+			m_placeArcs.push_back(outGoingArcs[j]->m_planIndex);
+		}
+	}
+
+	m_placeArcsBegin.push_back(m_placeArcs.size());
+
+	m_initialPlaceTokens = m_placeTokens;
+	m_initialTransitionActiveArcs = m_transitionActiveArcs;
+	m_initialTransitionStartDates = m_transitionStartDates;
+	m_initialTransitionEndDates = m_transitionEndDates;
+	m_initialArcAbsoluteMins = m_arcAbsoluteMins;
+	m_initialArcAbsoluteMaxs = m_arcAbsoluteMaxs;
+	m_initialArcActives = m_arcActives;
+}
+
+ExecutionPlan::~ExecutionPlan()
+{
+}
+
+unsigned int ExecutionPlan::indexOf(Transition* transition)
+{
+	return transition->m_planIndex;
+}
+
+void ExecutionPlan::start()
+{
+	produceToken(m_startPlace, 0);
+	m_placeTokens[m_endPlace].clear();
+}
+
+void ExecutionPlan::reset()
+{
+	// the assignments reuse the memory of the arrays
+	m_placeTokens = m_initialPlaceTokens;
+	m_transitionActiveArcs = m_initialTransitionActiveArcs;
+	m_transitionStartDates = m_initialTransitionStartDates;
+	m_transitionEndDates = m_initialTransitionEndDates;
+	m_arcAbsoluteMins = m_initialArcAbsoluteMins;
+	m_arcAbsoluteMaxs = m_initialArcAbsoluteMaxs;
+	m_arcActives = m_initialArcActives;
+
+	std::fill(m_transitionResetStamps.begin(), m_transitionResetStamps.end(), 0);
+	m_resetStamp = 0;
+	m_transitionsToReset.clear();
+}
+
+bool ExecutionPlan::isEnded()
+{
+	return !m_placeTokens[m_endPlace].empty();
+}
+
+bool ExecutionPlan::areAllInGoingArcsActive(unsigned int transition)
+{
+	return m_transitionActiveArcs[transition] == m_transitionArcsBegin[transition + 1] - m_transitionArcsBegin[transition];
+}
+
+bool ExecutionPlan::isStatic(unsigned int transition)
+{
+	return m_transitionStatics[transition];
+}
+
+void* ExecutionPlan::getEvent(unsigned int transition)
+{
+	return m_transitionEvents[transition];
+}
+
+ExtendedInt ExecutionPlan::getStartDate(unsigned int transition)
+{
+	return toExtendedInt(m_transitionStartDates[transition]);
+}
+
+void ExecutionPlan::crossTransition(unsigned int transition, bool mustChangeTokenValue, int newTokenValue)
+{
+	resetTransition(transition);
+
+	++m_resetStamp;
+	m_transitionsToReset.clear();
+
+	int tokenValue = 0;
+	bool activeToken = false;
+
+	for (unsigned int arc = m_transitionArcsBegin[transition]; arc < m_transitionArcsBegin[transition + 1]; ++arc) {
+		unsigned int place = m_arcPlaces[arc];
+
+		tokenValue = consumeToken(place);
+
+		if (tokenValue != -1) {
+			activeToken = true;
+			if (isStatic(transition)) {
+				tokenValue -= valueOf(m_arcRelativeMins[arc]);
+			} else {
+				tokenValue -= valueOf(m_arcRelativeMaxs[arc]);
+			}
+		}
+
+		if (m_placeTokens[place].size() >= NB_OF_TOKEN_TO_ACTIVE_ARC) {
+			setArcAsActive(arc, 0, false);
+		} else {
+			// the other transitions waiting for this place can't be crossed anymore
+			for (unsigned int i = m_placeArcsBegin[place]; i < m_placeArcsBegin[place + 1]; ++i) {
+				unsigned int otherTransition = m_arcTransitions[m_placeArcs[i]];
+
+				if (otherTransition != transition && m_transitionResetStamps[otherTransition] != m_resetStamp) {
+					m_transitionResetStamps[otherTransition] = m_resetStamp;
+					m_transitionsToReset.push_back(otherTransition);
+				}
+			}
+		}
+	}
+
+	std::sort(m_transitionsToReset.begin(), m_transitionsToReset.end());
+
+	for (unsigned int i = 0; i < m_transitionsToReset.size(); ++i) {
+		resetTransition(m_transitionsToReset[i]);
+		resetIncomingArcsState(m_transitionsToReset[i]);
+	}
+
+	for (unsigned int i = m_transitionActionsBegin[transition]; i < m_transitionActionsBegin[transition + 1]; ++i) {
+		m_petriNet->callAction(m_actionFunctions[i], m_actionArguments[i], activeToken);
+	}
+
+	if (!activeToken) {
+		tokenValue = -1;
+	} else if (mustChangeTokenValue) {
+		tokenValue = newTokenValue;
+	}
+
+	for (unsigned int i = m_transitionPlacesBegin[transition]; i < m_transitionPlacesBegin[transition + 1]; ++i) {
+		produceToken(m_transitionPlaces[i], tokenValue);
+	}
+}
+
+void ExecutionPlan::setArcAsActive(unsigned int arc, unsigned int timeOffset, bool recalculateArcTime)
+{
+	unsigned int transition = m_arcTransitions[arc];
+
+	if (!m_arcActives[arc]) {
+		m_arcActives[arc] = true;
+		++m_transitionActiveArcs[transition];
+	}
+
+	int currentTime = m_petriNet->getCurrentTimeInMs();
+	int startDate;
+	int endDate;
+
+	// the validation ensures that the min of the arc is lower than its max
+	if (recalculateArcTime) {
+		startDate = shiftDate(m_arcRelativeMins[arc], currentTime - (int) timeOffset);
+		endDate = shiftDate(m_arcRelativeMaxs[arc], currentTime - (int) timeOffset);
+
+		m_arcAbsoluteMins[arc] = startDate;
+		m_arcAbsoluteMaxs[arc] = endDate;
+	} else {
+		startDate = shiftDate(m_arcAbsoluteMins[arc], - (int) timeOffset);
+		endDate = shiftDate(m_arcAbsoluteMaxs[arc], - (int) timeOffset);
+	}
+
+	if (startDate > m_transitionStartDates[transition]) {
+		m_transitionStartDates[transition] = startDate;
+	}
+
+	if (endDate < m_transitionEndDates[transition]) {
+		m_transitionEndDates[transition] = endDate;
+
+		m_transitionEndActions[transition]->setDate(toExtendedInt(endDate));
+		m_petriNet->addActionToPriorityQueue(m_transitionEndActions[transition]);
+	}
+
+	if (areAllInGoingArcsActive(transition)) {
+		m_transitionStartActions[transition]->setDate(toExtendedInt(m_transitionStartDates[transition]));
+		m_petriNet->addActionToPriorityQueue(m_transitionStartActions[transition]);
+	}
+}
+
+void ExecutionPlan::resetTransition(unsigned int transition)
+{
+	for (unsigned int arc = m_transitionArcsBegin[transition]; arc < m_transitionArcsBegin[transition + 1]; ++arc) {
+		m_arcActives[arc] = false;
+	}
+
+	m_transitionActiveArcs[transition] = 0;
+
+	m_petriNet->checkTransition(m_transitions[transition]);
+
+	m_petriNet->removeActionFromPriorityQueue(m_transitionStartActions[transition]);
+	m_transitionStartDates[transition] = PLAN_MINUS_INFINITY;
+
+	m_petriNet->removeActionFromPriorityQueue(m_transitionEndActions[transition]);
+	m_transitionEndDates[transition] = PLAN_PLUS_INFINITY;
+}
+
+void ExecutionPlan::resetIncomingArcsState(unsigned int transition)
+{
+	for (unsigned int arc = m_transitionArcsBegin[transition]; arc < m_transitionArcsBegin[transition + 1]; ++arc) {
+		if (m_placeTokens[m_arcPlaces[arc]].size() >= NB_OF_TOKEN_TO_ACTIVE_ARC) {
+			setArcAsActive(arc, 0, false);
+		}
+	}
+}
+
+int ExecutionPlan::consumeToken(unsigned int place)
+{
+	std::vector<Token>& tokens = m_placeTokens[place];
+
+	unsigned int time = 0;
+	bool activeToken = false;
+
+	for (unsigned int i = 0; i < NB_OF_TOKEN_TO_CONSUME; ++i) {
+		time = tokens.back().getRemainingTime();
+		activeToken |= tokens.back().isActive();
+		tokens.pop_back();
+	}
+
+	return activeToken ? time : -1;
+}
+
+void ExecutionPlan::produceToken(unsigned int place, int tokensTime)
+{
+	std::vector<Token>& tokens = m_placeTokens[place];
+	unsigned int oldNumberOfTokens = tokens.size();
+
+	for (unsigned int i = 0; i < NB_OF_TOKEN_TO_PRODUCE; ++i) {
+		tokens.push_back(Token(tokensTime));
+	}
+
+	if (tokensTime < 0) {
+		tokensTime = 0;
+	}
+
+	if (oldNumberOfTokens >= NB_OF_TOKEN_TO_ACTIVE_ARC || tokens.size() < NB_OF_TOKEN_TO_ACTIVE_ARC) {
+		return;
+	}
+
+	for (unsigned int i = m_placeArcsBegin[place]; i < m_placeArcsBegin[place + 1]; ++i) {
+		unsigned int arc = m_placeArcs[i];
+		unsigned int transition = m_arcTransitions[arc];
+
+		setArcAsActive(arc, tokensTime, true);
+
+		if (isStatic(transition)) {
+			if (valueOf(m_arcRelativeMins[arc]) < (int) tokensTime) {
+				m_petriNet->pushTransitionToCrossWhenAcceleration(m_transitions[transition]);
+			}
+		} else {
+			if (valueOf(m_arcRelativeMaxs[arc]) < (int) tokensTime) {
+				m_petriNet->pushTransitionToCrossWhenAcceleration(m_transitions[transition]);
+			}
+		}
+	}
+}
+
+int ExecutionPlan::toDate(ExtendedInt value)
+{
+	if (value.isPlusInfinity()) {
+		return PLAN_PLUS_INFINITY;
+	}
+
+	if (value.isMinusInfinity()) {
+		return PLAN_MINUS_INFINITY;
+	}
+
+	return value.getValue();
+}
+
+ExtendedInt ExecutionPlan::toExtendedInt(int date)
+{
+	if (date == PLAN_PLUS_INFINITY) {
+		return ExtendedInt(PLUS_INFINITY);
+	}
+
+	if (date == PLAN_MINUS_INFINITY) {
+		return ExtendedInt(MINUS_INFINITY);
+	}
+
+	return ExtendedInt(INTEGER, date);
+}
+
+int ExecutionPlan::shiftDate(int date, int shift)
+{
+	if (date == PLAN_PLUS_INFINITY || date == PLAN_MINUS_INFINITY) {
+		return date;
+	}
+
+	return date + shift;
+}
+
+int ExecutionPlan::valueOf(int date)
+{
+	if (date == PLAN_PLUS_INFINITY || date == PLAN_MINUS_INFINITY) {
+		return 0;
+	}
+
+	return date;
+}
@@ -0,0 +1,309 @@
+/*
+Copyright: LaBRI (http://www.labri.fr)
+
+Author(s): Score contributors
+Last modification: 17/10/2026
+
+Adviser(s): Myriam Desainte-Catherine (myriam.desainte-catherine@labri.fr)
+
+This software is a computer program whose purpose is to propose
+a library for interactive scores edition and execution.
+
+This software is governed by the CeCILL-C license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL-C
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef EXECUTIONPLAN_HPP_
+#define EXECUTIONPLAN_HPP_
+
+/*!
+ * \file ExecutionPlan.hpp
+ * \author Score contributors
+ * \date 2026
+ */
+
+#include "ExtendedInt.hpp"
+#include "Token.hpp"
+
+#include <vector>
+#include <climits>
+
+#define PLAN_MINUS_INFINITY INT_MIN
+#define PLAN_PLUS_INFINITY INT_MAX
+
+class PetriNet;
+class PetriNetValidator;
+class Transition;
+class PriorityTransitionAction;
+
+/*!
+ * \class ExecutionPlan
+ *
+ * Frozen form of a PetriNet used to execute it : the places, transitions and
+ * arcs are numbered and stored in flat arrays (one array by property), so a
+ * step goes through contiguous memory instead of following pointers between
+ * Place, Transition and Arc objects.
+ *
+ * The in-going arcs of each transition are contiguous (CSR layout) : the arcs
+ * of the transition t are the indexes from m_transitionArcsBegin[t] to
+ * m_transitionArcsBegin[t + 1]. The out-going places of each transition,
+ * the out-going arcs of each place and the extern actions of each transition
+ * are stored the same way.
+ *
+ * The plan only executes networks with one color and without child network,
+ * which passed the PetriNetValidator analysis : a step doesn't check anything
+ * and can't throw an exception. The dates are plain integers (PLAN_MINUS_INFINITY
+ * and PLAN_PLUS_INFINITY stand for the infinities) instead of ExtendedInt.
+ *
+ * Once a PetriNet is frozen its objects must not be edited anymore : the
+ * execution state is in the plan and the objects are not updated.
+ */
+class ExecutionPlan
+{
+public:
+	/*!
+	 * Tests if a Petri Network can be executed by a plan.
+	 *
+	 * \param petriNet : the network to test.
+	 * \return true if it has one color, no child network and it is valid (cf PetriNetValidator).
+	 */
+	static bool canExecute(PetriNet* petriNet);
+
+	/*!
+	 * Tests if a Petri Network can be executed by a plan as canExecute(PetriNet*),
+	 * with a given validator which keeps the errors found.
+	 *
+	 * \param petriNet : the network to test.
+	 * \param validator : the validator of the network.
+	 * \return true if it has one color, no child network and it is valid.
+	 */
+	static bool canExecute(PetriNet* petriNet, PetriNetValidator& validator);
+
+	/*!
+	 * Constructor : freezes the current network and its execution state.
+	 *
+	 * \param petriNet : the network to freeze (canExecute must be true).
+	 */
+	ExecutionPlan(PetriNet* petriNet);
+
+	/*!
+	 * Destructor
+	 */
+	~ExecutionPlan();
+
+	/*!
+	 * Gets the index of a transition in the plan.
+	 *
+	 * \param transition : a transition of the frozen network.
+	 * \return its index.
+	 */
+	unsigned int indexOf(Transition* transition);
+
+	/*!
+	 * Produces a token in the start place and consumes the tokens of the end place.
+	 */
+	void start();
+
+	/*!
+	 * Brings the plan back to the execution state it was frozen with, so a
+	 * plan kept aside can be started again without being built again.
+	 */
+	void reset();
+
+	/*!
+	 * Tests if the end place has received a token.
+	 *
+	 * \return true if the end place has a token.
+	 */
+	bool isEnded();
+
+	/*!
+	 * Tests if all in-going arcs of a transition are active.
+	 *
+	 * \param transition : a transition index.
+	 * \return true if all in-going arcs are active.
+	 */
+	bool areAllInGoingArcsActive(unsigned int transition);
+
+	/*!
+	 * Tests if a transition is static (crossable without external event).
+	 *
+	 * \param transition : a transition index.
+	 * \return true if the transition is static.
+	 */
+	bool isStatic(unsigned int transition);
+
+	/*!
+	 * Gets the event to cross a transition.
+	 *
+	 * \param transition : a transition index.
+	 * \return pointer representing the waited event to cross the transition.
+	 */
+	void* getEvent(unsigned int transition);
+
+	/*!
+	 * Gets the date from which a transition can be crossed.
+	 *
+	 * \param transition : a transition index.
+	 * \return the start date.
+	 */
+	ExtendedInt getStartDate(unsigned int transition);
+
+	/*!
+	 * Crosses a transition : consumes the tokens of the in-going places, calls
+	 * the extern actions and produces tokens in the out-going places.
+	 *
+	 * \param transition : a transition index.
+	 * \param mustChangeTokenValue : true if the produced tokens take newTokenValue.
+	 * \param newTokenValue : the value of the produced tokens.
+	 */
+	void crossTransition(unsigned int transition, bool mustChangeTokenValue, int newTokenValue = 0);
+
+private:
+	/*!
+	 * Sets an arc as active and schedules the actions of its transition.
+	 *
+	 * \param arc : an arc index.
+	 * \param timeOffset : time already spent.
+	 * \param recalculateArcTime : true to compute the absolute bounds from the current time.
+	 */
+	void setArcAsActive(unsigned int arc, unsigned int timeOffset, bool recalculateArcTime);
+
+	/*!
+	 * Sets all the arcs of a transition as inactive and cancels its actions.
+	 *
+	 * \param transition : a transition index.
+	 */
+	void resetTransition(unsigned int transition);
+
+	/*!
+	 * Sets the arcs coming from a place with a token as active again.
+	 *
+	 * \param transition : a transition index.
+	 */
+	void resetIncomingArcsState(unsigned int transition);
+
+	/*!
+	 * Consumes a token (the place has one as its arcs are active).
+	 *
+	 * \param place : a place index.
+	 * \return the token value (-1 if the token is inactive).
+	 */
+	int consumeToken(unsigned int place);
+
+	/*!
+	 * Produces a token and activates the out-going arcs if it is the first token.
+	 *
+	 * \param place : a place index.
+	 * \param tokensTime : the token value (-1 for an inactive token).
+	 */
+	void produceToken(unsigned int place, int tokensTime);
+
+	/*!
+	 * Converts an ExtendedInt into a date of the plan.
+	 *
+	 * \param value : the value to convert.
+	 * \return the date (PLAN_MINUS_INFINITY or PLAN_PLUS_INFINITY for an infinity).
+	 */
+	static int toDate(ExtendedInt value);
+
+	/*!
+	 * Converts a date of the plan into an ExtendedInt.
+	 *
+	 * \param date : the date to convert.
+	 * \return the ExtendedInt.
+	 */
+	static ExtendedInt toExtendedInt(int date);
+
+	/*!
+	 * Moves a date (an infinity is not moved).
+	 *
+	 * \param date : the date to move.
+	 * \param shift : the time to add.
+	 * \return the moved date.
+	 */
+	static int shiftDate(int date, int shift);
+
+	/*!
+	 * Gets the value of a bound as ExtendedInt::getValue does (0 for an infinity).
+	 *
+	 * \param date : a date of the plan.
+	 * \return the value.
+	 */
+	static int valueOf(int date);
+
+	PetriNet* m_petriNet; // the frozen network.
+
+	unsigned int m_startPlace; // index of the start place.
+	unsigned int m_endPlace; // index of the end place.
+
+	// places
+	std::vector<std::vector<Token> > m_placeTokens; // tokens of each place.
+	std::vector<unsigned int> m_placeArcsBegin; // first out-going arc of each place in m_placeArcs.
+	std::vector<unsigned int> m_placeArcs; // out-going arcs of the places.
+
+	// transitions
+	std::vector<Transition*> m_transitions; // transitions (to call back the PetriNet).
+	std::vector<unsigned int> m_transitionArcsBegin; // first in-going arc of each transition.
+	std::vector<unsigned int> m_transitionPlacesBegin; // first out-going place of each transition in m_transitionPlaces.
+	std::vector<unsigned int> m_transitionPlaces; // out-going places of the transitions.
+	std::vector<unsigned int> m_transitionActionsBegin; // first extern action of each transition.
+	std::vector<void*> m_transitionEvents; // waited event of each transition.
+	std::vector<bool> m_transitionStatics; // static status of each transition.
+	std::vector<unsigned int> m_transitionActiveArcs; // number of active in-going arcs of each transition.
+	std::vector<int> m_transitionStartDates; // date from which each transition can be crossed.
+	std::vector<int> m_transitionEndDates; // date from which each transition must be crossed.
+	std::vector<PriorityTransitionAction*> m_transitionStartActions; // START action of each transition.
+	std::vector<PriorityTransitionAction*> m_transitionEndActions; // END action of each transition.
+	std::vector<unsigned int> m_transitionResetStamps; // last crossing that reset each transition.
+	unsigned int m_resetStamp; // stamp of the current crossing.
+
+	// arcs (from a place to a transition, grouped by transition)
+	std::vector<unsigned int> m_arcPlaces; // place of each arc.
+	std::vector<unsigned int> m_arcTransitions; // transition of each arc.
+	std::vector<int> m_arcRelativeMins; // relative min time of each arc.
+	std::vector<int> m_arcRelativeMaxs; // relative max time of each arc.
+	std::vector<int> m_arcAbsoluteMins; // absolute min time of each arc.
+	std::vector<int> m_arcAbsoluteMaxs; // absolute max time of each arc.
+	std::vector<bool> m_arcActives; // active status of each arc.
+
+	// extern actions
+	std::vector<void (*)(void*, bool)> m_actionFunctions; // function of each extern action.
+	std::vector<void*> m_actionArguments; // argument of each extern action.
+
+	std::vector<unsigned int> m_transitionsToReset; // transitions to reset during a crossing.
+
+	// execution state the plan was frozen with (cf reset)
+	std::vector<std::vector<Token> > m_initialPlaceTokens;
+	std::vector<unsigned int> m_initialTransitionActiveArcs;
+	std::vector<int> m_initialTransitionStartDates;
+	std::vector<int> m_initialTransitionEndDates;
+	std::vector<int> m_initialArcAbsoluteMins;
+	std::vector<int> m_initialArcAbsoluteMaxs;
+	std::vector<bool> m_initialArcActives;
+};
+
+#endif /*EXECUTIONPLAN_HPP_*/
@@ -0,0 +1,269 @@
+/*
+Copyright: LaBRI (http://www.labri.fr)
+
+Author(s): Score contributors
+Last modification: 17/10/2026
+
+Adviser(s): Myriam Desainte-Catherine (myriam.desainte-catherine@labri.fr)
+
+This software is a computer program whose purpose is to propose
+a library for interactive scores edition and execution.
+
+This software is governed by the CeCILL-C license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL-C
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL-C license and that you accept its terms.
+*/
+/*!
+ * \file ExecutionTrace.cpp
+ * \author Score contributors
+ * \date 2026
+ */
+
+#include "ExecutionTrace.hpp"
+
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+volatile bool ExecutionTrace::m_isOn = false;
+
+static pthread_once_t traceOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t traceRingKey; // the ring of the current thread.
+static pthread_mutex_t traceMutex; // protects the rings list and the start and the stop.
+static std::vector<void*> traceRings; // all the rings (as ExecutionTrace::Ring*).
+static unsigned int traceNbOfRings = 0; // to give an index to each ring.
+static FILE* traceFile = NULL;
+static pthread_t traceThread;
+static volatile bool traceMustStop = false;
+
+void executionTraceThreadEnd(void* ring)
+{
+	// the drain deletes the ring once it is empty
+	((ExecutionTrace::Ring*) ring)->isOrphan = true;
+}
+
+static void executionTraceInit()
+{
+	pthread_key_create(&traceRingKey, executionTraceThreadEnd);
+	pthread_mutex_init(&traceMutex, NULL);
+}
+
+void* executionTraceMain(void* arg)
+{
+	FILE* file = (FILE*) arg;
+
+	while (!traceMustStop) {
+		usleep(TRACE_DRAIN_PERIOD);
+
+		ExecutionTrace::drain(file);
+	}
+
+	return NULL;
+}
+
+bool ExecutionTrace::start(const char* path)
+{
+	pthread_once(&traceOnce, executionTraceInit);
+	pthread_mutex_lock(&traceMutex);
+
+	if (traceFile != NULL) {
+		pthread_mutex_unlock(&traceMutex);
+		return false;
+	}
+
+	FILE* file = fopen(path, "wb");
+
+	if (file == NULL) {
+		pthread_mutex_unlock(&traceMutex);
+		return false;
+	}
+
+	unsigned int recordSize = sizeof(TraceRecord);
+
+	fwrite("PNTRACE\1", 1, 8, file);
+	fwrite(&recordSize, sizeof(recordSize), 1, file);
+
+	// forget what was recorded by a previous trace
+	for (unsigned int i = 0; i < traceRings.size(); ++i) {
+		Ring* ring = (Ring*) traceRings[i];
+
+		ring->readPosition = ring->writePosition;
+		ring->nbOfReportedLostRecords = ring->nbOfLostRecords;
+	}
+
+	traceFile = file;
+	traceMustStop = false;
+	pthread_create(&traceThread, NULL, executionTraceMain, file);
+
+	__sync_synchronize();
+	m_isOn = true;
+
+	pthread_mutex_unlock(&traceMutex);
+
+	return true;
+}
+
+void ExecutionTrace::stop()
+{
+	pthread_once(&traceOnce, executionTraceInit);
+	pthread_mutex_lock(&traceMutex);
+
+	if (traceFile == NULL) {
+		pthread_mutex_unlock(&traceMutex);
+		return;
+	}
+
+	m_isOn = false;
+	traceMustStop = true;
+
+	pthread_mutex_unlock(&traceMutex);
+	pthread_join(traceThread, NULL);
+
+	drain(traceFile);
+
+	pthread_mutex_lock(&traceMutex);
+
+	fclose(traceFile);
+	traceFile = NULL;
+
+	pthread_mutex_unlock(&traceMutex);
+}
+
+void ExecutionTrace::write(TraceType type, const void* petriNet, unsigned int step, unsigned int time, const void* event)
+{
+	Ring* ring = getRing();
+	unsigned int position = ring->writePosition;
+
+	if (position - ring->readPosition >= TRACE_RING_SIZE) {
+		++ring->nbOfLostRecords;
+		return;
+	}
+
+	struct timeval now;
+	gettimeofday(&now, NULL);
+
+	TraceRecord& record = ring->records[position & (TRACE_RING_SIZE - 1)];
+
+	record.date = (unsigned long long) now.tv_sec * 1000000 + now.tv_usec;
+	record.petriNet = (unsigned long long) (size_t) petriNet;
+	record.event = (unsigned long long) (size_t) event;
+	record.step = step;
+	record.time = time;
+	record.type = type;
+	record.thread = ring->index;
+
+	// the record must be written before the drain can see it
+	__sync_synchronize();
+	ring->writePosition = position + 1;
+}
+
+ExecutionTrace::Ring* ExecutionTrace::getRing()
+{
+	pthread_once(&traceOnce, executionTraceInit);
+
+	Ring* ring = (Ring*) pthread_getspecific(traceRingKey);
+
+	if (ring == NULL) {
+		// only the first record of a thread allocates
+		ring = new Ring();
+		memset(ring, 0, sizeof(Ring));
+
+		pthread_mutex_lock(&traceMutex);
+		ring->index = traceNbOfRings++;
+		traceRings.push_back(ring);
+		pthread_mutex_unlock(&traceMutex);
+
+		pthread_setspecific(traceRingKey, ring);
+	}
+
+	return ring;
+}
+
+void ExecutionTrace::drain(FILE* file)
+{
+	pthread_mutex_lock(&traceMutex);
+
+	for (unsigned int i = 0; i < traceRings.size(); ++i) {
+		Ring* ring = (Ring*) traceRings[i];
+		bool isOrphan = ring->isOrphan;
+
+		drainRing(ring, file);
+
+		if (isOrphan) {
+			traceRings.erase(traceRings.begin() + i);
+			--i;
+
+			delete ring;
+		}
+	}
+
+	fflush(file);
+
+	pthread_mutex_unlock(&traceMutex);
+}
+
+void ExecutionTrace::drainRing(Ring* ring, FILE* file)
+{
+	unsigned int readPosition = ring->readPosition;
+	unsigned int writePosition = ring->writePosition;
+
+	// the records must be read after the position which tells they are written
+	__sync_synchronize();
+
+	while (readPosition != writePosition) {
+		unsigned int first = readPosition & (TRACE_RING_SIZE - 1);
+		unsigned int nbOfRecords = writePosition - readPosition;
+
+		// the records may go around the end of the ring
+		if (first + nbOfRecords > TRACE_RING_SIZE) {
+			nbOfRecords = TRACE_RING_SIZE - first;
+		}
+
+		fwrite(&ring->records[first], sizeof(TraceRecord), nbOfRecords, file);
+		readPosition += nbOfRecords;
+	}
+
+	// the records must be copied before the thread can overwrite them
+	__sync_synchronize();
+	ring->readPosition = readPosition;
+
+	unsigned int nbOfLostRecords = ring->nbOfLostRecords;
+
+	if (nbOfLostRecords != ring->nbOfReportedLostRecords) {
+		struct timeval now;
+		gettimeofday(&now, NULL);
+
+		TraceRecord record;
+		memset(&record, 0, sizeof(record));
+
+		record.date = (unsigned long long) now.tv_sec * 1000000 + now.tv_usec;
+		record.event = nbOfLostRecords - ring->nbOfReportedLostRecords;
+		record.type = TRACE_LOST;
+		record.thread = ring->index;
+
+		fwrite(&record, sizeof(TraceRecord), 1, file);
+		ring->nbOfReportedLostRecords = nbOfLostRecords;
+	}
+}
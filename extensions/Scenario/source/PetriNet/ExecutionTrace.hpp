@@ -0,0 +1,161 @@
+/*
+Copyright: LaBRI (http://www.labri.fr)
+
+Author(s): Score contributors
+Last modification: 17/10/2026
+
+Adviser(s): Myriam Desainte-Catherine (myriam.desainte-catherine@labri.fr)
+
+This software is a computer program whose purpose is to propose
+a library for interactive scores edition and execution.
+
+This software is governed by the CeCILL-C license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL-C
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL-C license and that you accept its terms.
+*/
+#ifndef EXECUTIONTRACE_HPP_
+#define EXECUTIONTRACE_HPP_
+
+/*!
+ * \file ExecutionTrace.hpp
+ * \author Score contributors
+ * \date 2026
+ */
+
+#include <stdio.h>
+#include <vector>
+#include <pthread.h>
+
+#define TRACE_RING_SIZE 4096 // records of each thread waiting to be written (power of 2).
+#define TRACE_DRAIN_PERIOD 10000 // time between two writes of the rings (in µs).
+
+/*!
+ * Kinds of trace records.
+ */
+enum TraceType {
+	TRACE_STEP, // a PetriNet begins a step.
+	TRACE_SENSITIZE_EVENT, // an interactive event is listened to.
+	TRACE_EVENT_NOT_READY, // an interactive event is not listened to anymore.
+	TRACE_EVENT_HAPPENED, // an interactive event has been received while listened to.
+	TRACE_TRANSITION_CROSSED, // a transition is crossed (event is its event).
+	TRACE_EVENT_TRIGGERED, // an event is put for the next step.
+	TRACE_EVENT_DISPOSED, // a transition is put to be deactivated at the next step.
+	TRACE_LOST // records have been lost because a ring was full (event is their number).
+};
+
+/*!
+ * \struct TraceRecord
+ *
+ * A fixed-size binary record, written as is in the trace file.
+ */
+struct TraceRecord
+{
+	unsigned long long date; // wall clock date in µs.
+	unsigned long long petriNet; // address of the PetriNet (0 if none).
+	unsigned long long event; // address of the event (0 if none).
+	unsigned int step; // number of steps the PetriNet has begun.
+	unsigned int time; // time of the PetriNet in ms.
+	unsigned int type; // a TraceType.
+	unsigned int thread; // index of the ring of the thread which made the record.
+};
+
+/*!
+ * \class ExecutionTrace
+ *
+ * Trace of the execution written to a file without blocking the executing threads.
+ *
+ * Each thread writes its records into its own ring (one writer, one reader, no lock) :
+ * when the ring is full the record is dropped and counted.
+ * A background thread drains the rings into the file.
+ * When the trace is off, a record costs one test.
+ *
+ * The file begins with the characters "PNTRACE", a version byte and the size of a record (4 bytes),
+ * then the TraceRecords follow.
+ */
+class ExecutionTrace
+{
+public:
+	/*!
+	 * Starts to trace into a file (the trace is off by default).
+	 *
+	 * \param path : path of the file to create.
+	 * \return false if the file can't be created or if the trace is already on.
+	 */
+	static bool start(const char* path);
+
+	/*!
+	 * Stops the trace, writes the remaining records and closes the file.
+	 */
+	static void stop();
+
+	/*!
+	 * Tests if the trace is on.
+	 *
+	 * \return true if the records are written.
+	 */
+	static bool isOn()
+	{
+		return m_isOn;
+	}
+
+	/*!
+	 * Records something (nothing is done if the trace is off).
+	 *
+	 * \param type : what happened.
+	 * \param petriNet : the PetriNet concerned (NULL if none).
+	 * \param step : number of steps the PetriNet has begun.
+	 * \param time : time of the PetriNet in ms.
+	 * \param event : the event concerned (NULL if none).
+	 */
+	static void record(TraceType type, const void* petriNet, unsigned int step, unsigned int time, const void* event)
+	{
+		if (m_isOn) {
+			write(type, petriNet, step, time, event);
+		}
+	}
+
+private:
+	struct Ring {
+		TraceRecord records[TRACE_RING_SIZE];
+		volatile unsigned int writePosition; // only modified by the thread of the ring.
+		volatile unsigned int readPosition; // only modified by the drain.
+		volatile unsigned int nbOfLostRecords; // only modified by the thread of the ring.
+		unsigned int nbOfReportedLostRecords; // only used by the drain.
+		unsigned int index;
+		volatile bool isOrphan; // true when the thread of the ring has ended.
+	};
+
+	static volatile bool m_isOn;
+
+	static void write(TraceType type, const void* petriNet, unsigned int step, unsigned int time, const void* event);
+	static Ring* getRing();
+	static void drain(FILE* file);
+	static void drainRing(Ring* ring, FILE* file);
+
+	friend void* executionTraceMain(void* arg);
+	friend void executionTraceThreadEnd(void* ring);
+};
+
+#endif /*EXECUTIONTRACE_HPP_*/
@@ -0,0 +1,130 @@
+/*
+Copyright: LaBRI (http://www.labri.fr)
+
+Author(s): Score contributors
+Last modification: 17/10/2026
+
+Adviser(s): Myriam Desainte-Catherine (myriam.desainte-catherine@labri.fr)
+
+This software is a computer program whose purpose is to propose
+a library for interactive scores edition and execution.
+
+This software is governed by the CeCILL-C license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL-C
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+/*!
+ * \file LockFreeEventQueue.cpp
+ * \author Score contributors
+ * \date 2026
+ */
+
+#include "LockFreeEventQueue.hpp"
+
+LockFreeEventQueue::LockFreeEventQueue(unsigned int capacity)
+{
+	unsigned int size = 1;
+
+	while (size < capacity) {
+		size <<= 1;
+	}
+
+	m_slots = new Slot[size];
+	m_mask = size - 1;
+
+	for (unsigned int i = 0 ; i < size ; ++i) {
+		m_slots[i].sequence = i;
+		m_slots[i].event = 0;
+	}
+
+	m_writePosition = 0;
+	m_readPosition = 0;
+}
+
+LockFreeEventQueue::~LockFreeEventQueue()
+{
+	delete[] m_slots;
+}
+
+bool LockFreeEventQueue::push(void* event)
+{
+	unsigned int position = m_writePosition;
+	Slot* slot;
+
+	while (true) {
+		slot = &m_slots[position & m_mask];
+
+		int difference = (int) (slot->sequence - position);
+
+		if (difference == 0) {
+			// the slot is free : take it if no other producer did
+			if (__sync_bool_compare_and_swap(&m_writePosition, position, position + 1)) {
+				break;
+			}
+
+			position = m_writePosition;
+		} else if (difference < 0) {
+			// the slot was not read yet
+			return false;
+		} else {
+			// another producer took the slot
+			position = m_writePosition;
+		}
+	}
+
+	slot->event = event;
+
+	__sync_synchronize();
+	slot->sequence = position + 1; // the event is ready to be read
+
+	return true;
+}
+
+bool LockFreeEventQueue::pop(void*& event)
+{
+	Slot* slot = &m_slots[m_readPosition & m_mask];
+
+	// the slot is still free or a producer is writing in it
+	if ((int) (slot->sequence - (m_readPosition + 1)) < 0) {
+		return false;
+	}
+
+	__sync_synchronize();
+	event = slot->event;
+
+	__sync_synchronize();
+	slot->sequence = m_readPosition + m_mask + 1; // the slot is free for the next round
+	++m_readPosition;
+
+	return true;
+}
+
+bool LockFreeEventQueue::empty()
+{
+	Slot* slot = &m_slots[m_readPosition & m_mask];
+
+	return (int) (slot->sequence - (m_readPosition + 1)) < 0;
+}
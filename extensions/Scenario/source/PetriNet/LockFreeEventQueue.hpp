@@ -0,0 +1,110 @@
+/*
+Copyright: LaBRI (http://www.labri.fr)
+
+Author(s): Score contributors
+Last modification: 17/10/2026
+
+Adviser(s): Myriam Desainte-Catherine (myriam.desainte-catherine@labri.fr)
+
+This software is a computer program whose purpose is to propose
+a library for interactive scores edition and execution.
+
+This software is governed by the CeCILL-C license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL-C
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef LOCKFREEEVENTQUEUE_HPP_
+#define LOCKFREEEVENTQUEUE_HPP_
+
+/*!
+ * \file LockFreeEventQueue.hpp
+ * \author Score contributors
+ * \date 2026
+ */
+
+/*!
+ * \class LockFreeEventQueue
+ *
+ * Bounded queue of events (pointer) which can be filled by several threads
+ * and emptied by one thread without any lock nor allocation.
+ *
+ * Each slot has a sequence number : a producer reserves a slot by moving
+ * the write position with a compare and swap, then publishes the event
+ * by updating the slot sequence.
+ */
+class LockFreeEventQueue
+{
+public:
+	/*!
+	 * Constructor
+	 *
+	 * \param capacity : maximum number of events waiting in the queue
+	 * (increased to the next power of two).
+	 */
+	LockFreeEventQueue(unsigned int capacity = 1024);
+
+	/*!
+	 * Destructor
+	 */
+	~LockFreeEventQueue();
+
+	/*!
+	 * Adds an event in the queue (from any thread).
+	 *
+	 * \param event : the event to add.
+	 * \return false if the queue is full.
+	 */
+	bool push(void* event);
+
+	/*!
+	 * Removes the oldest event of the queue (from the reading thread only).
+	 *
+	 * \param event : the removed event.
+	 * \return false if the queue is empty.
+	 */
+	bool pop(void*& event);
+
+	/*!
+	 * Tests if the queue is empty.
+	 *
+	 * \return true if no event is waiting to be read.
+	 */
+	bool empty();
+
+private:
+	struct Slot {
+		volatile unsigned int sequence;
+		void* event;
+	};
+
+	Slot* m_slots; // slots of the queue.
+	unsigned int m_mask; // number of slots - 1 (number of slots is a power of two).
+
+	volatile unsigned int m_writePosition; // next position to write (modified by all the producers).
+	unsigned int m_readPosition; // next position to read (only modified by the consumer).
+};
+
+#endif /*LOCKFREEEVENTQUEUE_HPP_*/
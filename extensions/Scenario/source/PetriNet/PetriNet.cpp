@@ -37,6 +37,7 @@ knowledge of the CeCILL-C license and that you accept its terms.
 */
 
 #include "PetriNet.hpp"
+#include "PetriNetValidator.hpp"
 
 /*!
  * \file PetriNet.cpp
@@ -51,6 +52,7 @@ knowledge of the CeCILL-C license and that you accept its terms.
 
 #include <iostream>
 #include <algorithm>
+#include <new>
 
 using namespace std;
 
@@ -59,22 +61,42 @@ m_nbColors((nbColors > 0)?nbColors:1),
 m_mustCrossAllTransitionWithoutWaitingEvent(false)
 {
 	m_parentPetriNet = NULL;
+	m_childIndex = 0;
+	m_nbOfLaunchedChildren = 0;
+	m_launchDate = 0;
 
 	m_updateFactor = 1;
 	m_isEventReadyCallback = NULL;
+	m_stepInputCallback = NULL;
+	m_stepInputContext = NULL;
+
+	m_plan = NULL;
+
+	m_firstSensitizedTransition = NULL;
+	m_lastSensitizedTransition = NULL;
+	m_nbOfSensitizedTransitions = 0;
+	m_nbOfTransitionsToCheck = 0;
 
 	m_mustStop = false;
+
+	// the shared pool is built while the PetriNets are built, not by the clock thread at the first step of the children
+	StepThreadPool::getInstance();
     
     m_currentTime = 0;
     m_isRunning = false;
+    m_nbOfSteps = 0;
 
 	resetEvents();
 }
 
 void PetriNet::start()
 {
-    m_startPlace->produceTokens(1);
-    m_endPlace->consumeTokens(m_endPlace->nbOfTokens());
+    if (m_plan != NULL) {
+        m_plan->start();
+    } else {
+        m_startPlace->produceTokens(1);
+        m_endPlace->consumeTokens(m_endPlace->nbOfTokens());
+    }
     
     m_isRunning = true;
 }
@@ -82,144 +104,532 @@ void PetriNet::start()
 bool PetriNet::makeOneStep(unsigned int currentTime)
 {
     m_currentTime = currentTime;
+    ++m_nbOfSteps;
+    
+    ExecutionTrace::record(TRACE_STEP, this, m_nbOfSteps, m_currentTime, NULL);
+    
+    // take all the events received since the last step at once
+    void* event;
     
-    if (m_endPlace->nbOfTokens() == 0 && !m_mustStop) {
+    while (m_incomingEvents.pop(event)) {
+        if (m_stepInputCallback != NULL) {
+            m_stepInputCallback(m_stepInputContext, event, true);
+        }
+        
+        m_stepEvents.insert(event);
+        checkTransitionsOfEvent(event);
         
-        bool stop = false;
+        // the active children take the event at their step, made at the end of this one
+        for (std::map<PetriNet*, PetriNet*>::iterator it = m_activeChildPetriNet.begin(); it != m_activeChildPetriNet.end(); ++it) {
+            it->second->putAnEvent(event);
+        }
+    }
+    
+    // take the deactivations as well
+    void* deactivatedTransition;
+    
+    while (m_incomingDeactivations.pop(deactivatedTransition)) {
+        Transition* t = (Transition*) deactivatedTransition;
         
-        while (!stop) {
-            if (m_priorityTransitionsActionQueue.size() == 0) {
-                stop = true; // CB should check that in while condition
+        if (m_stepInputCallback != NULL) {
+            m_stepInputCallback(m_stepInputContext, t, false);
+        }
+        
+        // a transition which is not sensitized has nothing to deactivate : the dispose is dropped
+        if (!t->m_isSensitized) {
+            continue;
+        }
+        
+        ++t->m_nbOfDeactivations;
+        checkTransition(t);
+    }
+    
+    if (m_mustCrossAllTransitionWithoutWaitingEvent) {
+        checkAllSensitizedTransitions();
+    }
+    
+    if (isEnded() || m_mustStop) {
+        m_isRunning = false;
+        return false;
+    }
+    
+    // a frozen PetriNet passed the validation : its step doesn't check anything and can't throw
+    if (m_plan != NULL) {
+        stepPlan(currentTime);
+    } else {
+        stepObjects(currentTime);
+    }
+    
+    stepActiveChildren();
+    
+    return true;
+}
+
+void PetriNet::stepObjects(unsigned int currentTime)
+{
+    bool stop = false;
+    
+    while (!stop) {
+        if (m_priorityTransitionsActionQueue.size() == 0) {
+            stop = true; // CB should check that in while condition
+        } else {
+            PriorityTransitionAction* topAction = getTopActionOnPriorityQueue();
+            
+            if ((unsigned int) topAction->getDate().getValue() > currentTime) {
+                stop = true; // CB because it's a priority queue, so it is ordered
             } else {
-                PriorityTransitionAction* topAction = getTopActionOnPriorityQueue();
+                Transition* topTransition = topAction->getTransition();
                 
-                if (!topAction->isEnable()) { // CB why disable actions without destructing them ?
-                    removeTopActionOnPriorityQueue();
-                } else if ((unsigned int) topAction->getDate().getValue() > currentTime) {
-                    stop = true; // CB because it's a priority queue, so it is ordered
-                } else {
-                    Transition* topTransition = topAction->getTransition();
-                    
-                    if (topAction->getType() == START) { // CB START means actually min duration for the interval
-                        if (topTransition->couldBeSensitize()) { // CB if there is no subnet running
-                            
-                            turnIntoSensitized(topTransition); // CB listen to the event (even if it's a static transition ?!)
-                            
-                            if (topTransition->getEvent() != NULL && m_isEventReadyCallback != NULL) { // CB if it's not static
-                                
-                                // DEBUG
-                                std::cout << "PetriNet::makeOneStep : sensitize event " << topTransition->getEvent() << " at " << currentTime << " ms" << std::endl;
-                                
-                                m_isEventReadyCallback(topTransition->getEvent(), true); // CB tell to Score to listen to the event
-                            }
+                // take the action out of the queue first because crossing a transition pushes new actions
+                m_priorityTransitionsActionQueue.pop();
+                
+                if (topAction->getType() == START) { // CB START means actually min duration for the interval
+                    if (couldBeSensitize(topTransition)) { // CB if there is no subnet running
+                        
+                        turnIntoSensitized(topTransition); // CB listen to the event (even if it's a static transition ?!)
+                        
+                        if (getEvent(topTransition) != NULL && m_isEventReadyCallback != NULL) { // CB if it's not static
                             
-                            removeTopActionOnPriorityQueue(); // CB Done
+                            ExecutionTrace::record(TRACE_SENSITIZE_EVENT, this, m_nbOfSteps, currentTime, getEvent(topTransition));
                             
-                        } else { // CB if there is a subnet running
-                            topAction->setDate(currentTime + 1); // CB delay
-                            removeTopActionOnPriorityQueue();
-                            m_priorityTransitionsActionQueue.push(topAction);
+                            callAction(m_isEventReadyCallback, getEvent(topTransition), true); // CB tell to Score to listen to the event
                         }
                         
-                        //stop = true;
-                    } else { // CB if type END, actually max duration for the interval
-                        if (topTransition->areAllInGoingArcsActive()) {
-                            topTransition->crossTransition(true, currentTime - topAction->getDate().getValue()); // CB force the transition
-                            removeTopActionOnPriorityQueue();
-                        } else { // CB should be part of debug, like avery IncoherentStateException actually
-                            removeTopActionOnPriorityQueue();
-                            throw IncoherentStateException();
-                        }
+                        // CB Done
+                        
+                    } else { // CB if there is a subnet running
+                        topAction->setDate(currentTime + 1); // CB delay
+                        m_priorityTransitionsActionQueue.push(topAction);
+                    }
+                    
+                    //stop = true;
+                } else { // CB if type END, actually max duration for the interval
+                    if (areAllInGoingArcsActive(topTransition)) {
+                        crossTransition(topTransition, true, currentTime - topAction->getDate().getValue()); // CB force the transition
+                    } else { // CB should be part of debug, like avery IncoherentStateException actually
+                        throw IncoherentStateException();
                     }
                 }
             }
         }
+    }
+    
+    // among the sensitized transitions whose state changed, in the order they were sensitized
+    Transition* sensitizedTransitionToTestTheEvent = m_firstSensitizedTransition;
+    
+    while (sensitizedTransitionToTestTheEvent != NULL && m_nbOfTransitionsToCheck > 0) {
         
-        // among all sensitized transitions
-        for (unsigned int i = 0 ; i < m_sensitizedTransitions.size() ; ++i) {
+        // the transitions which change behind the walk (after being checked) wait for the next step
+        Transition* nextSensitizedTransition = sensitizedTransitionToTestTheEvent->m_nextSensitized;
+        
+        if (!sensitizedTransitionToTestTheEvent->m_mustBeChecked) {
+            sensitizedTransitionToTestTheEvent = nextSensitizedTransition;
+            continue;
+        }
+        
+        // if all the going arc are not active ; CB in fact, if we already forced the transition because of the max duration of the interval (or if there is an IncoherentState)
+        if (!areAllInGoingArcsActive(sensitizedTransitionToTestTheEvent)) {
             
-            Transition* sensitizedTransitionToTestTheEvent;
-            sensitizedTransitionToTestTheEvent = m_sensitizedTransitions[i];
+            //remove the sensitized transition
+            turnIntoUnsensitized(sensitizedTransitionToTestTheEvent);
             
-            // if all the going arc are not active ; CB in fact, if we already forced the transition because of the max duration of the interval (or if there is an IncoherentState)
-            if (!sensitizedTransitionToTestTheEvent->areAllInGoingArcsActive()) {
+            // CB if it was an interactive event
+            if (getEvent(sensitizedTransitionToTestTheEvent) != NULL && m_isEventReadyCallback != NULL) {
                 
-                //remove the sensitized transition
-                m_sensitizedTransitions.erase(m_sensitizedTransitions.begin() + i);
-                --i;
+                ExecutionTrace::record(TRACE_EVENT_NOT_READY, this, m_nbOfSteps, currentTime, getEvent(sensitizedTransitionToTestTheEvent));
                 
-                // CB if it was an interactive event
-                if (sensitizedTransitionToTestTheEvent->getEvent() != NULL && m_isEventReadyCallback != NULL) {
-                    
-                    // DEBUG
-                    std::cout << "PetriNet::makeOneStep : sensitized event " << sensitizedTransitionToTestTheEvent->getEvent() << " not ready anymore" << std::endl;
-                    
-                    m_isEventReadyCallback(sensitizedTransitionToTestTheEvent->getEvent(), false); // CB tell Score to stop listening to the event
-                }
+                callAction(m_isEventReadyCallback, getEvent(sensitizedTransitionToTestTheEvent), false); // CB tell Score to stop listening to the event
             }
+        }
 
-            // cf triggerpoint : else check if the transition event is part of the recent incomming events (or if all transition have to pass)
-            else if (isAnEvent(sensitizedTransitionToTestTheEvent->getEvent()) || m_mustCrossAllTransitionWithoutWaitingEvent){
+        // cf triggerpoint : else check if the transition event is part of the recent incomming events (or if all transition have to pass)
+        else if (isAnEvent(getEvent(sensitizedTransitionToTestTheEvent)) || m_mustCrossAllTransitionWithoutWaitingEvent){
+            
+            if (isStatic(sensitizedTransitionToTestTheEvent)) { // CB if it's in fact a static event, actually listening to nothing though
                 
-                if (sensitizedTransitionToTestTheEvent->isStatic()) { // CB if it's in fact a static event, actually listening to nothing though
-                    
-                    sensitizedTransitionToTestTheEvent->crossTransition(true, currentTime - sensitizedTransitionToTestTheEvent->getStartDate().getValue());
-                    
-                } else { // CB if it's a real interactive event that has arrived
-                    
-                    // DEBUG
-                    std::cout << "PetriNet::makeOneStep : sensitized event happened " << sensitizedTransitionToTestTheEvent->getEvent() << " at " << currentTime << " ms" << std::endl;
-                    
-                    sensitizedTransitionToTestTheEvent->crossTransition(true,0);
-                }
+                crossTransition(sensitizedTransitionToTestTheEvent, true, currentTime - getStartDate(sensitizedTransitionToTestTheEvent).getValue());
                 
-                m_sensitizedTransitions.erase(m_sensitizedTransitions.begin() + i);
-                --i; // CB 0 - 1 in an unsigned int isn't a very good idea I think
+            } else { // CB if it's a real interactive event that has arrived
                 
-                if (sensitizedTransitionToTestTheEvent->getEvent() != NULL && m_isEventReadyCallback != NULL) {
-                    
-                    m_isEventReadyCallback(sensitizedTransitionToTestTheEvent->getEvent(), false); // CB tell Score to stop listening to the event
-                }
+                ExecutionTrace::record(TRACE_EVENT_HAPPENED, this, m_nbOfSteps, currentTime, getEvent(sensitizedTransitionToTestTheEvent));
+                
+                crossTransition(sensitizedTransitionToTestTheEvent, true, 0);
             }
+            
+            turnIntoUnsensitized(sensitizedTransitionToTestTheEvent);
+            
+            if (getEvent(sensitizedTransitionToTestTheEvent) != NULL && m_isEventReadyCallback != NULL) {
+                
+                callAction(m_isEventReadyCallback, getEvent(sensitizedTransitionToTestTheEvent), false); // CB tell Score to stop listening to the event
+            }
+        }
 
-            // CB check if the transition should be deactivated because of a condition
-            else {
-                for (transitionList::iterator it = m_deactivatedTransitions.begin() ; sensitizedTransitionToTestTheEvent && it != m_deactivatedTransitions.end() ; it++) {
-                    if (sensitizedTransitionToTestTheEvent == *it) {
-                        sensitizedTransitionToTestTheEvent->crossTransition(true, -1); // CB -1 for inactive token
-
-                        m_sensitizedTransitions.erase(m_sensitizedTransitions.begin() + i);
-                        --i;
-
-                        sensitizedTransitionToTestTheEvent = NULL;
+        // CB check if the transition should be deactivated because of a condition
+        else if (sensitizedTransitionToTestTheEvent->m_nbOfDeactivations > 0) {
+            
+            --sensitizedTransitionToTestTheEvent->m_nbOfDeactivations;
+            
+            crossTransition(sensitizedTransitionToTestTheEvent, true, -1); // CB -1 for inactive token
+            
+            turnIntoUnsensitized(sensitizedTransitionToTestTheEvent);
+        }
+        
+        // the changes made while checking the transition (crossing it resets its in-going arcs) don't need another check
+        uncheckTransition(sensitizedTransitionToTestTheEvent);
+        
+        sensitizedTransitionToTestTheEvent = nextSensitizedTransition;
+    }
+    
+    resetEvents(); // CB discards events that nobody listens to
+    
+    while(!m_transitionsToCrossWhenAcceleration.empty()) {
+        Transition* currentTransition = m_transitionsToCrossWhenAcceleration.back();
+        
+        if (areAllInGoingArcsActive(currentTransition)) {
+            crossTransition(currentTransition, false, 0);
+        } else {
+            throw IncoherentStateException();
+        }
+        
+        m_transitionsToCrossWhenAcceleration.pop_back();
+    }
+    
+    m_transitionsToCrossWhenAcceleration.clear();
+}
 
-                        m_deactivatedTransitions.erase(it);
-                    }
-                }
+void PetriNet::stepPlan(unsigned int currentTime)
+{
+    // the same step as stepObjects, with the transitions indexes into the plan
+    while (!m_priorityTransitionsActionQueue.empty()) {
+        PriorityTransitionAction* topAction = m_priorityTransitionsActionQueue.top();
+        
+        if ((unsigned int) topAction->getDate().getValue() > currentTime) {
+            break;
+        }
+        
+        Transition* topTransition = topAction->getTransition();
+        unsigned int index = topTransition->m_planIndex;
+        
+        m_priorityTransitionsActionQueue.pop();
+        
+        if (topAction->getType() == START) {
+            // a frozen PetriNet has no child PetriNet to wait for
+            turnIntoSensitized(topTransition);
+            
+            void* event = m_plan->getEvent(index);
+            
+            if (event != NULL && m_isEventReadyCallback != NULL) {
+                
+                ExecutionTrace::record(TRACE_SENSITIZE_EVENT, this, m_nbOfSteps, currentTime, event);
+                
+                callAction(m_isEventReadyCallback, event, true);
             }
+        } else {
+            // the validation ensures that all the in-going arcs are active when the max duration is reached
+            ExecutionTrace::record(TRACE_TRANSITION_CROSSED, this, m_nbOfSteps, m_currentTime, m_plan->getEvent(index));
+            
+            m_plan->crossTransition(index, true, currentTime - topAction->getDate().getValue());
+        }
+    }
+    
+    Transition* transition = m_firstSensitizedTransition;
+    
+    while (transition != NULL && m_nbOfTransitionsToCheck > 0) {
+        
+        Transition* nextTransition = transition->m_nextSensitized;
+        
+        if (!transition->m_mustBeChecked) {
+            transition = nextTransition;
+            continue;
         }
         
-        resetEvents(); // CB discards events that nobody listens to
+        unsigned int index = transition->m_planIndex;
+        void* event = m_plan->getEvent(index);
         
-        while(!m_transitionsToCrossWhenAcceleration.empty()) {
-            Transition* currentTransition = m_transitionsToCrossWhenAcceleration.back();
+        if (!m_plan->areAllInGoingArcsActive(index)) {
             
-            if (currentTransition->areAllInGoingArcsActive()) {
-                currentTransition->crossTransition(false, 0);
+            turnIntoUnsensitized(transition);
+            
+            if (event != NULL && m_isEventReadyCallback != NULL) {
+                
+                ExecutionTrace::record(TRACE_EVENT_NOT_READY, this, m_nbOfSteps, currentTime, event);
+                
+                callAction(m_isEventReadyCallback, event, false);
+            }
+        }
+        
+        else if (isAnEvent(event) || m_mustCrossAllTransitionWithoutWaitingEvent) {
+            
+            if (m_plan->isStatic(index)) {
+                ExecutionTrace::record(TRACE_TRANSITION_CROSSED, this, m_nbOfSteps, m_currentTime, event);
+                
+                m_plan->crossTransition(index, true, currentTime - m_plan->getStartDate(index).getValue());
             } else {
-                throw IncoherentStateException();
+                ExecutionTrace::record(TRACE_EVENT_HAPPENED, this, m_nbOfSteps, currentTime, event);
+                ExecutionTrace::record(TRACE_TRANSITION_CROSSED, this, m_nbOfSteps, m_currentTime, event);
+                
+                m_plan->crossTransition(index, true, 0);
+            }
+            
+            turnIntoUnsensitized(transition);
+            
+            if (event != NULL && m_isEventReadyCallback != NULL) {
+                callAction(m_isEventReadyCallback, event, false);
             }
+        }
+        
+        else if (transition->m_nbOfDeactivations > 0) {
+            
+            --transition->m_nbOfDeactivations;
+            
+            ExecutionTrace::record(TRACE_TRANSITION_CROSSED, this, m_nbOfSteps, m_currentTime, event);
+            
+            m_plan->crossTransition(index, true, -1);
             
-            m_transitionsToCrossWhenAcceleration.pop_back();
+            turnIntoUnsensitized(transition);
         }
         
-        m_transitionsToCrossWhenAcceleration.clear();
+        uncheckTransition(transition);
         
-        return true;
+        transition = nextTransition;
     }
     
-    m_isRunning = false;
-    return false;
+    resetEvents();
+    
+    // the plan doesn't push any transition to cross when accelerating (cf pushTransitionToCrossWhenAcceleration)
+}
+
+void PetriNet::stepActiveChildren()
+{
+	if (m_activeChildPetriNet.empty()) {
+		return;
+	}
+
+	m_childSteps.clear();
+
+	// in the order the children were added, so their actions are always called in the same order
+	for (std::map<PetriNet*, PetriNet*>::iterator it = m_activeChildPetriNet.begin(); it != m_activeChildPetriNet.end(); ++it) {
+		PetriNetStep step;
+
+		step.petriNet = it->second;
+		step.currentTime = (m_currentTime > it->second->m_launchDate) ? m_currentTime - it->second->m_launchDate : 0;
+
+		unsigned int i = m_childSteps.size();
+		m_childSteps.push_back(step);
+
+		while (i > 0 && m_childSteps[i - 1].petriNet->m_childIndex > step.petriNet->m_childIndex) {
+			m_childSteps[i] = m_childSteps[i - 1];
+			--i;
+		}
+
+		m_childSteps[i] = step;
+	}
+
+	StepThreadPool::getInstance()->stepPetriNets(m_childSteps);
+
+	bool hasThrown = false;
+
+	for (unsigned int i = 0; i < m_childSteps.size(); ++i) {
+		PetriNet* child = m_childSteps[i].petriNet;
+
+		for (unsigned int j = 0; j < child->m_deferredActions.size(); ++j) {
+			callAction(child->m_deferredActions[j].function, child->m_deferredActions[j].argument, child->m_deferredActions[j].option);
+		}
+
+		child->m_deferredActions.clear();
+
+		if (m_childSteps[i].hasThrown) {
+			// a frozen PetriNet can't throw : the child which failed is stopped instead
+			if (m_plan != NULL) {
+				externMustStop(child, true);
+			} else {
+				hasThrown = true;
+			}
+		}
+	}
+
+	if (hasThrown) {
+		throw IncoherentStateException();
+	}
+}
+
+void PetriNet::callAction(void (*function)(void*, bool), void* argument, bool option)
+{
+	// the children only launch and stop their own children by themselves
+	if (m_parentPetriNet == NULL || function == &externLaunch || function == &externMustStop) {
+		function(argument, option);
+	} else {
+		DeferredAction action;
+
+		action.function = function;
+		action.argument = argument;
+		action.option = option;
+
+		m_deferredActions.push_back(action);
+	}
+}
+
+bool PetriNet::freeze()
+{
+	PetriNetValidator validator(this);
+
+	return freeze(validator);
+}
+
+bool PetriNet::freeze(PetriNetValidator& validator)
+{
+	if (m_plan == NULL && ExecutionPlan::canExecute(this, validator)) {
+		m_plan = new ExecutionPlan(this);
+	}
+
+	return m_plan != NULL;
+}
+
+bool PetriNet::isFrozen()
+{
+	return m_plan != NULL;
+}
+
+bool PetriNet::unfreeze()
+{
+	ExecutionPlan* plan = takePlan();
+
+	if (plan == NULL) {
+		return false;
+	}
+
+	delete plan;
+
+	return true;
+}
+
+bool PetriNet::freeze(ExecutionPlan* plan)
+{
+	if (m_plan != NULL || plan == NULL) {
+		return false;
+	}
+
+	// the transitions keep the same indexes as long as none is added or removed
+	plan->reset();
+	m_plan = plan;
+
+	return true;
+}
+
+ExecutionPlan* PetriNet::takePlan()
+{
+	ExecutionPlan* plan = m_plan;
+
+	if (plan == NULL) {
+		return NULL;
+	}
+
+	m_plan = NULL;
+
+	// the plan held the marking : only the bookkeeping of the steps has to be reset
+	for (unsigned int i = 0; i < m_transitions.size(); ++i) {
+		Transition* t = m_transitions[i];
+
+		t->m_isSensitized = false;
+		t->m_previousSensitized = NULL;
+		t->m_nextSensitized = NULL;
+		t->m_mustBeChecked = false;
+		t->m_nbOfDeactivations = 0;
+	}
+
+	m_firstSensitizedTransition = NULL;
+	m_lastSensitizedTransition = NULL;
+	m_nbOfSensitizedTransitions = 0;
+	m_nbOfTransitionsToCheck = 0;
+
+	m_transitionsToCrossWhenAcceleration.clear();
+	m_priorityTransitionsActionQueue.clear();
+
+	void* input;
+
+	while (m_incomingEvents.pop(input)) {
+	}
+
+	while (m_incomingDeactivations.pop(input)) {
+	}
+
+	resetEvents();
+
+	m_activeChildPetriNet.clear();
+	m_deferredActions.clear();
+
+	m_mustStop = false;
+	m_currentTime = 0;
+	m_isRunning = false;
+	m_nbOfSteps = 0;
+
+	return plan;
+}
+
+bool PetriNet::couldBeSensitize(Transition* t)
+{
+	// a frozen PetriNet has no child PetriNet to wait for
+	if (m_plan != NULL) {
+		return true;
+	}
+
+	return t->couldBeSensitize();
+}
+
+bool PetriNet::areAllInGoingArcsActive(Transition* t)
+{
+	if (m_plan != NULL) {
+		return m_plan->areAllInGoingArcsActive(t->m_planIndex);
+	}
+
+	return t->areAllInGoingArcsActive();
+}
+
+bool PetriNet::isStatic(Transition* t)
+{
+	if (m_plan != NULL) {
+		return m_plan->isStatic(t->m_planIndex);
+	}
+
+	return t->isStatic();
+}
+
+void* PetriNet::getEvent(Transition* t)
+{
+	if (m_plan != NULL) {
+		return m_plan->getEvent(t->m_planIndex);
+	}
+
+	return t->getEvent();
+}
+
+ExtendedInt PetriNet::getStartDate(Transition* t)
+{
+	if (m_plan != NULL) {
+		return m_plan->getStartDate(t->m_planIndex);
+	}
+
+	return t->getStartDate();
+}
+
+void PetriNet::crossTransition(Transition* t, bool mustChangeTokenValue, int newTokenValue)
+{
+	ExecutionTrace::record(TRACE_TRANSITION_CROSSED, this, m_nbOfSteps, m_currentTime, getEvent(t));
+
+	if (m_plan != NULL) {
+		m_plan->crossTransition(t->m_planIndex, mustChangeTokenValue, newTokenValue);
+	} else {
+		t->crossTransition(mustChangeTokenValue, newTokenValue);
+	}
+}
+
+bool PetriNet::isEnded()
+{
+	if (m_plan != NULL) {
+		return m_plan->isEnded();
+	}
+
+	return m_endPlace->nbOfTokens() != 0;
 }
 
 unsigned int PetriNet::getCurrentTimeInMs()
@@ -227,6 +637,11 @@ unsigned int PetriNet::getCurrentTimeInMs()
     return m_currentTime;
 }
 
+unsigned int PetriNet::getNbOfSteps()
+{
+    return m_nbOfSteps;
+}
+
 bool PetriNet::isRunning()
 {
     return m_isRunning;
@@ -264,42 +679,62 @@ void PetriNet::changeNbOfColors(unsigned int newNbColors)
 void PetriNet::resetEvents()
 {
 	m_mustCrossAllTransitionWithoutWaitingEvent = false;
-	m_incomingEvents.clear();
-    m_incomingEvents.push_back(STATIC_EVENT);
+	m_stepEvents.clear();
 }
 
-void PetriNet::putAnEvent(void* event)
+bool PetriNet::putAnEvent(void* event)
 {
-	m_incomingEvents.push_back(event);
-
-	for (std::map<PetriNet*, PetriNet*>::iterator it = m_activeChildPetriNet.begin(); it != m_activeChildPetriNet.end(); ++it)
-	{
-		it->second->putAnEvent(event);
-	}
-
+	// only the queue is shared with the producers : the children are changed by the execution thread
+	return m_incomingEvents.push(event);
 }
 
 bool PetriNet::isAnEvent(void* event)
 {
-	eventList tempList = m_incomingEvents.getList();
-	std::list<void*>::iterator it = tempList.begin();
+	// the static event is always received
+	return (event == STATIC_EVENT) || m_stepEvents.contains(event);
+}
 
-	while (it != tempList.end()) {
-        
-		if (*it == event)
-			return true;
-        
-		++it;
+ExtendedInt PetriNet::getNextStepDate()
+{
+	// a static sensitized transition or one that is not active anymore is in the transitions to check
+	if (!m_incomingEvents.empty() || m_stepEvents.size() > 0 || m_mustCrossAllTransitionWithoutWaitingEvent ||
+		!m_incomingDeactivations.empty() ||
+		m_nbOfTransitionsToCheck > 0 || !m_transitionsToCrossWhenAcceleration.empty()) {
+		return ExtendedInt(INTEGER, m_currentTime);
 	}
-    
-	return false;
+
+	ExtendedInt nextStepDate(PLUS_INFINITY);
+
+	if (!isEmptyPriorityQueue()) {
+		nextStepDate = getTopActionOnPriorityQueue()->getDate();
+	}
+
+	// the active children are stepped with their parent, their dates are relative to their launch
+	for (std::map<PetriNet*, PetriNet*>::iterator it = m_activeChildPetriNet.begin(); it != m_activeChildPetriNet.end(); ++it) {
+		// an ended child waits to be stopped without needing any step
+		if (!it->second->isRunning()) {
+			continue;
+		}
+
+		ExtendedInt childNextStepDate = it->second->getNextStepDate();
+
+		if (childNextStepDate.isInteger()) {
+			childNextStepDate = ExtendedInt(INTEGER, childNextStepDate.getValue() + it->second->m_launchDate);
+
+			if (!nextStepDate.isInteger() || childNextStepDate.getValue() < nextStepDate.getValue()) {
+				nextStepDate = childNextStepDate;
+			}
+		}
+	}
+
+	return nextStepDate;
 }
 
 Place* PetriNet::createPlace()
 {
 	Place* newPlace;
 
-	newPlace = new Place(this);
+	newPlace = new (m_arena.allocate(sizeof(Place))) Place(this);
 	m_places.push_back(newPlace);
 
 	return newPlace;
@@ -309,7 +744,7 @@ Transition* PetriNet::createTransition()
 {
 	Transition* newTransition;
 
-	newTransition = new Transition(this);
+	newTransition = new (m_arena.allocate(sizeof(Transition))) Transition(this);
 	m_transitions.push_back(newTransition);
 
 	return newTransition;
@@ -323,7 +758,17 @@ Arc* PetriNet::newArc(PetriNetNode* from, PetriNetNode* to, int color)
 		return existArc;
 	}
 
-	return new Arc(this, from, to, color);
+	return new (m_arena.allocate(sizeof(Arc))) Arc(this, from, to, color);
+}
+
+PriorityTransitionAction* PetriNet::createPriorityTransitionAction(Transition* transition, short type, ExtendedInt date)
+{
+	return new (m_arena.allocate(sizeof(PriorityTransitionAction))) PriorityTransitionAction(transition, type, date);
+}
+
+TransitionAction* PetriNet::createTransitionAction(void(*pt2Func)(void*, bool), void* argPt2Func)
+{
+	return new (m_arena.allocate(sizeof(TransitionAction))) TransitionAction(pt2Func, argPt2Func);
 }
 
 Arc* PetriNet::createArc(Place* from, Transition* to, int color)
@@ -345,7 +790,7 @@ void PetriNet::deleteArc(PetriNetNode* from, PetriNetNode* to)
 			to->removeInGoingArcs(arcToDelete, i);
 			from->removeOutGoingArcs(arcToDelete, i);
 
-			delete arcToDelete;
+			destroyItem(arcToDelete);
 		}
 	}
 }
@@ -361,7 +806,7 @@ void PetriNet::deleteArc(PetriNetNode* from, PetriNetNode* to, int color)
 	to->removeInGoingArcs(arcToDelete, color);
 	from->removeOutGoingArcs(arcToDelete, color);
 
-	delete arcToDelete;
+	destroyItem(arcToDelete);
 }
 
 void PetriNet::deleteItem(PetriNetNode* nodeToDelete)
@@ -400,7 +845,7 @@ void PetriNet::deleteItem(Place* & placeToDelete)
 
 	deleteItem((PetriNetNode*) placeToDelete);
 
-	delete placeToDelete;
+	destroyItem(placeToDelete);
 	placeToDelete = NULL;
 
 }
@@ -428,18 +873,162 @@ void PetriNet::deleteItem(Transition* & transitionToDelete)
 
 	deleteItem((PetriNetNode*) transitionToDelete);
 
-	delete transitionToDelete;
+	// forget the transition in the sensitized bookkeeping and in the index of the events
+	turnIntoUnsensitized(transitionToDelete);
+	unindexEvent(transitionToDelete);
+
+	removeActionFromPriorityQueue(transitionToDelete->m_startAction);
+	removeActionFromPriorityQueue(transitionToDelete->m_endAction);
+
+	destroyItem(transitionToDelete->m_startAction);
+	destroyItem(transitionToDelete->m_endAction);
+
+	destroyItem(transitionToDelete);
 	transitionToDelete = NULL;
 }
 
 void PetriNet::turnIntoSensitized(Transition* t)
 {
-	m_sensitizedTransitions.push_back(t);
+	if (!t->m_isSensitized) {
+
+		// the list keeps the order of the sensitizations : the step checks the transitions in this order
+		t->m_isSensitized = true;
+
+		t->m_previousSensitized = m_lastSensitizedTransition;
+		t->m_nextSensitized = NULL;
+
+		if (m_lastSensitizedTransition != NULL) {
+			m_lastSensitizedTransition->m_nextSensitized = t;
+		} else {
+			m_firstSensitizedTransition = t;
+		}
+
+		m_lastSensitizedTransition = t;
+		++m_nbOfSensitizedTransitions;
+	}
+
+	// a new sensitized transition is always checked once
+	checkTransition(t);
+}
+
+void PetriNet::turnIntoUnsensitized(Transition* t)
+{
+	if (!t->m_isSensitized) {
+		return;
+	}
+
+	if (t->m_previousSensitized != NULL) {
+		t->m_previousSensitized->m_nextSensitized = t->m_nextSensitized;
+	} else {
+		m_firstSensitizedTransition = t->m_nextSensitized;
+	}
+
+	if (t->m_nextSensitized != NULL) {
+		t->m_nextSensitized->m_previousSensitized = t->m_previousSensitized;
+	} else {
+		m_lastSensitizedTransition = t->m_previousSensitized;
+	}
+
+	t->m_previousSensitized = NULL;
+	t->m_nextSensitized = NULL;
+	t->m_isSensitized = false;
+	--m_nbOfSensitizedTransitions;
+
+	// the deactivations received while it was sensitized don't apply to its next sensitization
+	t->m_nbOfDeactivations = 0;
+
+	// an unsensitized transition has nothing to check
+	uncheckTransition(t);
+}
+
+bool PetriNet::deactivateTransition(Transition* t)
+{
+    return m_incomingDeactivations.push(t);
+}
+
+void PetriNet::checkTransition(Transition* t)
+{
+	// the transition stays in the sensitized list : it is only marked
+	if (t->m_isSensitized && !t->m_mustBeChecked) {
+		t->m_mustBeChecked = true;
+		++m_nbOfTransitionsToCheck;
+	}
+}
+
+void PetriNet::uncheckTransition(Transition* t)
+{
+	if (t->m_mustBeChecked) {
+		t->m_mustBeChecked = false;
+		--m_nbOfTransitionsToCheck;
+	}
+}
+
+void PetriNet::indexEvent(Transition* t)
+{
+	void* event = t->m_events.front();
+
+	if (event == STATIC_EVENT) {
+		return;
+	}
+
+	// the new transition is put at the head of the transitions of its event
+	std::map<void*, Transition*>::iterator it = m_eventTransitions.find(event);
+
+	t->m_previousOfEvent = NULL;
+
+	if (it != m_eventTransitions.end()) {
+		t->m_nextOfEvent = it->second;
+		it->second->m_previousOfEvent = t;
+		it->second = t;
+	} else {
+		t->m_nextOfEvent = NULL;
+		m_eventTransitions[event] = t;
+	}
+}
+
+void PetriNet::unindexEvent(Transition* t)
+{
+	void* event = t->m_events.front();
+
+	if (event == STATIC_EVENT) {
+		return;
+	}
+
+	if (t->m_nextOfEvent != NULL) {
+		t->m_nextOfEvent->m_previousOfEvent = t->m_previousOfEvent;
+	}
+
+	if (t->m_previousOfEvent != NULL) {
+		t->m_previousOfEvent->m_nextOfEvent = t->m_nextOfEvent;
+	} else if (t->m_nextOfEvent != NULL) {
+		m_eventTransitions[event] = t->m_nextOfEvent;
+	} else {
+		m_eventTransitions.erase(event);
+	}
+
+	t->m_previousOfEvent = NULL;
+	t->m_nextOfEvent = NULL;
+}
+
+void PetriNet::checkTransitionsOfEvent(void* event)
+{
+	// the index is built when the events are set : finding the transitions doesn't allocate anything
+	std::map<void*, Transition*>::iterator it = m_eventTransitions.find(event);
+
+	if (it == m_eventTransitions.end()) {
+		return;
+	}
+
+	for (Transition* t = it->second; t != NULL; t = t->m_nextOfEvent) {
+		checkTransition(t);
+	}
 }
 
-void PetriNet::deactivateTransition(Transition* t)
+void PetriNet::checkAllSensitizedTransitions()
 {
-    m_deactivatedTransitions.push_back(t);
+	for (Transition* t = m_firstSensitizedTransition; t != NULL; t = t->m_nextSensitized) {
+		checkTransition(t);
+	}
 }
 
 //
@@ -450,7 +1039,7 @@ void PetriNet::deactivateTransition(Transition* t)
 //	}
 //}
 
-placeList PetriNet::getPlaces()
+const placeList& PetriNet::getPlaces()
 {
 	return m_places;
 }
@@ -475,7 +1064,7 @@ Place* PetriNet::getEndPlace()
 	return m_endPlace;
 }
 
-transitionList PetriNet::getTransitions()
+const transitionList& PetriNet::getTransitions()
 {
 	return m_transitions;
 }
@@ -486,12 +1075,21 @@ transitionList PetriNet::getTransitions()
 
 transitionList PetriNet::getSensitizedTransitions()
 {
-	return m_sensitizedTransitions;
+	transitionList sensitizedTransitions;
+
+	for (Transition* t = m_firstSensitizedTransition; t != NULL; t = t->m_nextSensitized) {
+		sensitizedTransitions.push_back(t);
+	}
+
+	return sensitizedTransitions;
 }
 
 eventList PetriNet::getEvents()
 {
-	return m_incomingEvents.getList();
+	eventList events = m_stepEvents.getList();
+	events.push_front(STATIC_EVENT);
+
+	return events;
 }
 
 void PetriNet::mustStop()
@@ -504,7 +1102,12 @@ void PetriNet::addActionToPriorityQueue(PriorityTransitionAction* action)
 	m_priorityTransitionsActionQueue.push(action);
 }
 
-priorityTransitionActionQueue PetriNet::getPriorityQueue()
+void PetriNet::removeActionFromPriorityQueue(PriorityTransitionAction* action)
+{
+	m_priorityTransitionsActionQueue.remove(action);
+}
+
+const priorityTransitionActionQueue& PetriNet::getPriorityQueue()
 {
 	return m_priorityTransitionsActionQueue;
 }
@@ -563,6 +1166,18 @@ void PetriNet::removeIsEventReadyCallback()
 	m_isEventReadyCallback = NULL;
 }
 
+void PetriNet::addStepInputCallback(void(*pt2Func)(void*, void*, bool), void* context)
+{
+	m_stepInputCallback = pt2Func;
+	m_stepInputContext = context;
+}
+
+void PetriNet::removeStepInputCallback()
+{
+	m_stepInputCallback = NULL;
+	m_stepInputContext = NULL;
+}
+
 void PetriNet::pushTransitionToCrossWhenAcceleration(Transition* t)
 {
 // This function is useless because the implementation is wrong
@@ -585,6 +1200,7 @@ void PetriNet::pushTransitionToCrossWhenAcceleration(Transition* t)
 void PetriNet::addInternPetriNet(Transition* startTransition, Transition* endTransition, PetriNet* petriNet)
 {
 	petriNet->m_parentPetriNet = this;
+	petriNet->m_childIndex = m_childrenPetriNet.size();
 	m_childrenPetriNet[petriNet] = petriNet;
 
 	startTransition->addExternAction(&externLaunch, petriNet);
@@ -594,11 +1210,33 @@ void PetriNet::addInternPetriNet(Transition* startTransition, Transition* endTra
 		petriNet->addIsEventReadyCallback(m_isEventReadyCallback);
 }
 
+void PetriNet::launchInternPetriNet(PetriNet* petriNet)
+{
+	petriNet->m_parentPetriNet = this;
+	petriNet->m_childIndex = m_childrenPetriNet.size() + m_nbOfLaunchedChildren;
+	++m_nbOfLaunchedChildren;
+
+	externLaunch(petriNet, true);
+}
+
+void PetriNet::stopInternPetriNet(PetriNet* petriNet)
+{
+	if (petriNet->m_parentPetriNet != this) {
+		return;
+	}
+
+	externMustStop(petriNet, true);
+
+	// its actions are called by itself again
+	petriNet->m_deferredActions.clear();
+	petriNet->m_parentPetriNet = NULL;
+}
+
 void PetriNet::print()
 {
 	std::cout << "PETRI NET" << std::endl;
 
-	std::cout << "TransitionList elements " << m_sensitizedTransitions.size() << std::endl;
+	std::cout << "TransitionList elements " << m_nbOfSensitizedTransitions << std::endl;
 	std::cout << "PriorityQueu elements " << m_priorityTransitionsActionQueue.size() << std::endl;
 
 	std::cout << std::endl;
@@ -716,18 +1354,25 @@ std::set<Transition*> PetriNet::getOneDepthPredecessorsTransitions(Transition* t
 
 PetriNet::~PetriNet()
 {
+	delete m_plan;
+
+	// only the places and the transitions own memory outside the arena (their lists),
+	// the arcs and the actions are released with the arena
 	for (unsigned int i = 0; i < m_places.size(); ++i) {
 		if (m_places[i] != NULL) {
-			delete m_places[i];
+			m_places[i]->~Place();
 		}
 	}
 
 	for (unsigned int i = 0; i < m_transitions.size(); ++i) {
 		if (m_transitions[i] != NULL) {
-			delete m_transitions[i];
+			m_transitions[i]->~Transition();
 		}
 	}
 
+	m_priorityTransitionsActionQueue.clear();
+	m_arena.reset();
+
 //	while (!m_transitions.empty()) {
 //		deleteItem(m_transitions[0]);
 //	}
@@ -740,11 +1385,12 @@ void externLaunch(void* arg, bool option)
 	if (petriNet->m_parentPetriNet != NULL) {
 		petriNet->m_parentPetriNet->m_activeChildPetriNet[petriNet] = petriNet;
 		petriNet->setUpdateFactor(petriNet->m_parentPetriNet->getUpdateFactor());
-	}
 
-    // NOTE : the line below is commented out because we don't need to launch the thread execution anymore
-    // see in : Scenario.cpp
-	//petriNet->launch();
+		// NOTE : the child is not launched into its own thread anymore, its parent steps it (see PetriNet::stepActiveChildren)
+		petriNet->m_launchDate = petriNet->m_parentPetriNet->m_currentTime;
+		petriNet->m_mustStop = false;
+		petriNet->start();
+	}
 }
 
 void externMustStop(void* arg, bool option)
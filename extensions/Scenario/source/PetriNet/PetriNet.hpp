@@ -49,7 +49,13 @@ knowledge of the CeCILL-C license and that you accept its terms.
 #include "Transition.hpp"
 #include "Arc.hpp"
 #include "PriorityTransitionAction.hpp"
-#include "ThreadSafeList.hpp"
+#include "PriorityTransitionActionHeap.hpp"
+#include "LockFreeEventQueue.hpp"
+#include "EventSet.hpp"
+#include "PetriNetArena.hpp"
+#include "ExecutionPlan.hpp"
+#include "StepThreadPool.hpp"
+#include "ExecutionTrace.hpp"
 
 #include "IllegalArgumentException.hpp"
 
@@ -61,23 +67,29 @@ knowledge of the CeCILL-C license and that you accept its terms.
 #include <string>
 #include <pthread.h>
 
+class PetriNetValidator;
+
 #define STATIC_EVENT (void*)NULL
 #define MY_MIN_STEP_TIME_IN_MS 100
 
-struct priorityTransitionActionComparison {
-  bool operator() (const PriorityTransitionAction* left, const PriorityTransitionAction* right) {
-	  return (left->getDate() > right->getDate());
-  }
-};
-
 typedef std::vector<Transition*>    transitionList;
 typedef std::vector<Place*>         placeList;
 typedef std::list<void*>            eventList;
 
-typedef std::priority_queue<PriorityTransitionAction*,
-	 						std::vector<PriorityTransitionAction *, std::allocator<PriorityTransitionAction*> >,
-	 					    priorityTransitionActionComparison >
-        priorityTransitionActionQueue;
+typedef PriorityTransitionActionHeap priorityTransitionActionQueue;
+
+/*!
+ * \struct DeferredAction
+ *
+ * Extern action (or event ready callback) of a child PetriNet,
+ * called by its parent once all its children are stepped.
+ */
+struct DeferredAction
+{
+	void (*function)(void*, bool);
+	void* argument;
+	bool option;
+};
 
 /*!
  * \class PetriNet
@@ -92,10 +104,22 @@ typedef std::priority_queue<PriorityTransitionAction*,
  * create/delete Arcs, add/reset events, change the number of colors.
  *
  * Places, Transitions, Arcs ... must not be created outside a PetriNet (useless).
+ *
+ * All the items of a PetriNet are allocated in its arena, so they are all
+ * released at once when the PetriNet is deleted.
+ *
+ * Once built, a PetriNet can be frozen into an ExecutionPlan which is then
+ * used to execute it.
+ *
+ * The active children of a PetriNet are stepped at the end of each of its steps,
+ * concurrently on the StepThreadPool. Their extern actions are called by the
+ * parent after they are all stepped, in the order the children were added.
  */
 class PetriNet
 {
 public:
+	friend class ExecutionPlan;
+
 	// constructor
 
 	/*!
@@ -119,6 +143,66 @@ public:
      */
 	void start();
 
+	/*!
+	 * Freezes the PetriNet into an ExecutionPlan used by the next steps.
+	 *
+	 * Nothing happens if the PetriNet can't be executed by a plan (see ExecutionPlan::canExecute) :
+	 * a PetriNet that doesn't pass the PetriNetValidator analysis keeps being executed by its objects.
+	 * Once frozen, the places, transitions and arcs must not be edited anymore.
+	 *
+	 * \return true if the PetriNet is frozen.
+	 */
+	bool freeze();
+
+	/*!
+	 * Freezes the PetriNet as freeze() with a given validator, which keeps the
+	 * errors found when the PetriNet can't be frozen (cf PetriNetValidator::getErrors).
+	 *
+	 * \param validator : the validator of this PetriNet.
+	 * \return true if the PetriNet is frozen.
+	 */
+	bool freeze(PetriNetValidator& validator);
+
+	/*!
+	 * Tests if the PetriNet is frozen into an ExecutionPlan.
+	 *
+	 * \return true if the PetriNet is frozen.
+	 */
+	bool isFrozen();
+
+	/*!
+	 * Gives a frozen PetriNet back to the edition.
+	 *
+	 * The ExecutionPlan and the state of the last execution are dropped : as a frozen
+	 * PetriNet is executed by its plan, its items are still as they were built, so their
+	 * arcs can be changed before freezing it again and it can be started again from scratch.
+	 * A PetriNet executed by its objects can't be unfrozen as its items kept their state.
+	 *
+	 * \return true if the PetriNet was frozen.
+	 */
+	bool unfreeze();
+
+	/*!
+	 * Gives the ExecutionPlan away : the PetriNet is unfrozen as by unfreeze
+	 * but the plan is kept by the caller, which has to delete it or to freeze
+	 * the PetriNet with it again later (cf freeze(ExecutionPlan*)).
+	 *
+	 * \return the plan (NULL if the PetriNet was not frozen).
+	 */
+	ExecutionPlan* takePlan();
+
+	/*!
+	 * Freezes the PetriNet with a plan taken from it before, without building it again.
+	 *
+	 * The plan is brought back to the state it was frozen with (cf ExecutionPlan::reset).
+	 * No place or transition must have been added or removed since the plan was built :
+	 * only the arcs and the events may have changed, the plan keeps them as they were.
+	 *
+	 * \param plan : a plan taken from this PetriNet (the PetriNet owns it again).
+	 * \return false if the PetriNet is already frozen or if there is no plan (the plan is left to the caller).
+	 */
+	bool freeze(ExecutionPlan* plan);
+
 	/*!
 	 * Modifies the PetriNet according to the current time in ms
      * \return true if the step have been processed, false if there is not more step
@@ -132,6 +216,11 @@ public:
      */
     unsigned int getCurrentTimeInMs();
     
+    /*
+     *  Get the number of steps begun since the creation (used by the ExecutionTrace)
+     */
+    unsigned int getNbOfSteps();
+    
     /*
      *  Get the running state
      */
@@ -165,26 +254,43 @@ public:
 	void changeNbOfColors(unsigned int newNbColors);
 
 	/*!
-	 * Empties the events list.
-	 * The list will only contain the static event.
+	 * Empties the events received for the current step.
+	 * Only the static event remains.
+	 * The events still waiting in the incoming queue are kept for the next step.
 	 */
 	void resetEvents();
 
 	/*!
-	 * Adds an event in this Petri Network.
+	 * Adds an event in this Petri Network (from any thread).
+	 * The event is taken into account at the beginning of the next step,
+	 * where it is passed on to the active children (on the execution thread).
 	 *
 	 * \param event : event to add.
+	 * \return false if the incoming queue of this Petri Network is full.
 	 */
-	void putAnEvent(void* event);
+	bool putAnEvent(void* event);
 
 	/*!
-	 * Tests if an particular event was received by this Petri Network.
+	 * Tests if an particular event was received by this Petri Network
+	 * for the current step (O(1)).
 	 *
 	 * \param event : event to test the reception.
 	 * \return true if the event was received by this PetriNetwork
 	 */
 	bool isAnEvent(void* event);
 
+	/*!
+	 * Gets the date when makeOneStep needs to be called again.
+	 * It is the current time if something is waiting to be done
+	 * (an incoming event, a static transition to cross, a deactivated
+	 * transition, ...), else the date of the top enabled action
+	 * or the next date of an active child.
+	 *
+	 * \return the next date to step or plus infinity if only
+	 * an incoming event can make the Petri Network evolve.
+	 */
+	ExtendedInt getNextStepDate();
+
 	/*!
 	 * Creates a new place.
 	 *
@@ -260,11 +366,41 @@ public:
 	void turnIntoSensitized(Transition* t);
 
     /*!
-     * Specifies the given transition as deactivated.
+     * Specifies the given transition as deactivated (from any thread).
+     * The deactivation is taken into account at the beginning of the next step,
+     * when the transition is sensitized it is crossed with an inactive token.
      *
      * \param t : transition to set as deactivated.
+     * \return false if the incoming queue of deactivations is full.
      */
-    void deactivateTransition(Transition* t);
+    bool deactivateTransition(Transition* t);
+
+	/*!
+	 * Asks to check a transition during the step because its state changed
+	 * (an in-going arc became inactive, its event or a deactivation was received).
+	 * Nothing is done if the transition is not sensitized.
+	 *
+	 * A step only checks these transitions instead of all the sensitized ones.
+	 *
+	 * \param t : transition to check.
+	 */
+	void checkTransition(Transition* t);
+
+	/*!
+	 * Adds a transition to the transitions waiting its event.
+	 * Called when the event of the transition is set, so receiving an event during
+	 * a step only looks its transitions up.
+	 *
+	 * \param t : transition to index.
+	 */
+	void indexEvent(Transition* t);
+
+	/*!
+	 * Removes a transition from the transitions waiting its event.
+	 *
+	 * \param t : transition to remove from the index.
+	 */
+	void unindexEvent(Transition* t);
 
 //	/*!
 //	 * Specifies the given transition as unsensitized.
@@ -280,7 +416,7 @@ public:
 	 *
 	 * \return the Petri Net Places
 	 */
-	placeList getPlaces();
+	const placeList& getPlaces();
 
 	void setStartPlace(Place* place);
 	Place* getStartPlace();
@@ -297,7 +433,7 @@ public:
 	 *
 	 * \return the Petri Net Transitions
 	 */
-	transitionList getTransitions();
+	const transitionList& getTransitions();
 
 	/*!
 	 * Gets the events in this PetriNet
@@ -315,18 +451,48 @@ public:
 
 	/*!
 	 * Gets the sensitized transitions in this PetriNet
+	 * (in the order they were sensitized).
 	 *
 	 * \return the Petri Net Sensitized Transitions
 	 */
 	transitionList getSensitizedTransitions();
 
 	/*!
-	 * Adds an action (START/END) to the priority queue.
+	 * Creates an action (START/END) in the arena of this PetriNet.
+	 *
+	 * The action is released with the PetriNet.
+	 *
+	 * \param transition : the transition linked to this action.
+	 * \param type : action type (START, END).
+	 * \param date : action starting date.
+	 * \return the new action.
+	 */
+	PriorityTransitionAction* createPriorityTransitionAction(Transition* transition, short type, ExtendedInt date);
+
+	/*!
+	 * Creates an action to call when a transition is crossed in the arena of this PetriNet.
+	 *
+	 * \param pt2Func : function with one void* parameter.
+	 * \param argPt2Func : argument for pt2Func.
+	 * \return the new action.
+	 */
+	TransitionAction* createTransitionAction(void(*pt2Func)(void*, bool), void* argPt2Func);
+
+	/*!
+	 * Adds an action (START/END) to the priority queue, or moves it if it
+	 * is already in the queue and its date changed.
 	 *
 	 * \param action : the action to add.
 	 */
 	void addActionToPriorityQueue(PriorityTransitionAction* action);
 
+	/*!
+	 * Removes an action (START/END) from the priority queue if it is in the queue.
+	 *
+	 * \param action : the action to remove.
+	 */
+	void removeActionFromPriorityQueue(PriorityTransitionAction* action);
+
 	/*!
 	 * Gets the top action (the most closer in time).
 	 *
@@ -336,7 +502,7 @@ public:
 	 */
 	PriorityTransitionAction* getTopActionOnPriorityQueue();
 
-	priorityTransitionActionQueue getPriorityQueue();
+	const priorityTransitionActionQueue& getPriorityQueue();
 
 	/*!
 	 * Removes the top action (the most closer in time).
@@ -360,10 +526,48 @@ public:
 	void addIsEventReadyCallback(void(*pt2Func)(void *, bool));
 	void removeIsEventReadyCallback();
 
+	/*!
+	 * Sets a function called by makeOneStep for each event and each deactivation it takes
+	 * (to record them with the number of the step which processes them).
+	 *
+	 * \param pt2Func : the function called with the context, the event or the deactivated Transition
+	 * and true for an event, false for a deactivation.
+	 * \param context : the first argument given to the function.
+	 */
+	void addStepInputCallback(void(*pt2Func)(void *, void *, bool), void* context);
+	void removeStepInputCallback();
+
 	void pushTransitionToCrossWhenAcceleration(Transition* t);
 
 	void addInternPetriNet(Transition* startTransition, Transition* endTransition, PetriNet* petriNet);
 
+	/*!
+	 * Launches a child PetriNet which was not added while this PetriNet was built.
+	 *
+	 * The child is stepped with this PetriNet from its current time, until it is stopped.
+	 * As it is not added, this PetriNet can still be frozen (cf ExecutionPlan::canExecute).
+	 *
+	 * \param petriNet : the child to launch (built and owned by the caller, it is started here).
+	 */
+	void launchInternPetriNet(PetriNet* petriNet);
+
+	/*!
+	 * Stops a child launched by launchInternPetriNet and detaches it, so its owner can delete it.
+	 *
+	 * \param petriNet : the child to stop.
+	 */
+	void stopInternPetriNet(PetriNet* petriNet);
+
+	/*!
+	 * Calls an extern action of a transition (or the event ready callback).
+	 * In a child PetriNet the call is deferred to its parent.
+	 *
+	 * \param function : the action to call.
+	 * \param argument : the argument of the action.
+	 * \param option : the option of the action.
+	 */
+	void callAction(void (*function)(void*, bool), void* argument, bool option);
+
 	void print();
 
     /*
@@ -382,14 +586,25 @@ private:
 	PetriNet* m_parentPetriNet;
 	std::map<PetriNet*, PetriNet*> m_childrenPetriNet;
 	std::map<PetriNet*, PetriNet*> m_activeChildPetriNet;
+
+	unsigned int m_childIndex; // order of this PetriNet among the children of its parent.
+	unsigned int m_nbOfLaunchedChildren; // number of children launched by launchInternPetriNet, to order them after the added ones.
+	unsigned int m_launchDate; // time of the parent when this PetriNet was launched.
+	std::vector<DeferredAction> m_deferredActions; // actions to be called by the parent.
+	std::vector<PetriNetStep> m_childSteps; // steps of the active children (kept to not allocate at each step).
     
     unsigned int m_currentTime; // we need to store it because transitions ask for
     unsigned int m_isRunning;   // we need to store it because transitions ask for
+    unsigned int m_nbOfSteps;   // number of calls to makeOneStep, to number the trace records
 
 	unsigned int m_nbColors; // number of colors.
 
 	float m_updateFactor;
 
+	PetriNetArena m_arena; // memory of all the items (places, transitions, arcs, actions).
+
+	ExecutionPlan* m_plan; // frozen form used for the execution (NULL if not frozen).
+
 	placeList m_places; // list of places.
 	transitionList m_transitions; // list of transitions.
 
@@ -399,7 +614,8 @@ private:
 	pthread_t m_thread;
 	bool m_mustStop;
 
-	ThreadSafeList m_incomingEvents; // list of events (pointer).
+	LockFreeEventQueue m_incomingEvents; // events (pointer) received since the beginning of the current step.
+	EventSet m_stepEvents; // events (pointer) received before the beginning of the current step.
 
 //	/*
 //	 * A transition is active when it has at least one predecessor with
@@ -411,8 +627,13 @@ private:
 //	 *
 //	 */
 //	transitionList m_activeTransitions; // list of actives transitions.
-	transitionList m_sensitizedTransitions;	// list of sensitized transitions.
-    transitionList m_deactivatedTransitions; // list of deactivated transitions.
+	Transition* m_firstSensitizedTransition; // intrusive list of sensitized transitions (cf Transition::m_nextSensitized).
+	Transition* m_lastSensitizedTransition;
+	unsigned int m_nbOfSensitizedTransitions;
+	unsigned int m_nbOfTransitionsToCheck; // number of sensitized transitions marked to check (cf Transition::m_mustBeChecked).
+	std::map<void*, Transition*> m_eventTransitions; // first transition waiting each event (cf Transition::m_nextOfEvent).
+
+	LockFreeEventQueue m_incomingDeactivations; // transitions deactivated since the beginning of the current step.
 	transitionList m_transitionsToCrossWhenAcceleration;
 
 	priorityTransitionActionQueue m_priorityTransitionsActionQueue;
@@ -420,10 +641,45 @@ private:
 	bool m_mustCrossAllTransitionWithoutWaitingEvent;
 
 	void (*m_isEventReadyCallback)(void*, bool);
+	void (*m_stepInputCallback)(void*, void*, bool);
+	void* m_stepInputContext; // the first argument of m_stepInputCallback.
 
 	// Private function only used to factorize the program.
 	Arc* newArc(PetriNetNode* from, PetriNetNode* to, int color);
+
+	// Private functions to make a step with the objects or with the ExecutionPlan if the PetriNet is frozen.
+	void stepObjects(unsigned int currentTime);
+	void stepPlan(unsigned int currentTime);
+
+	// Private function to step the active children concurrently.
+	void stepActiveChildren();
+
+	// Private functions to maintain the sensitized transitions.
+	void turnIntoUnsensitized(Transition* t);
+	void uncheckTransition(Transition* t);
+	void checkTransitionsOfEvent(void* event);
+	void checkAllSensitizedTransitions();
+
+	// Private functions to execute a transition with the ExecutionPlan if the PetriNet is frozen.
+	bool couldBeSensitize(Transition* t);
+	bool areAllInGoingArcsActive(Transition* t);
+	bool isStatic(Transition* t);
+	void* getEvent(Transition* t);
+	ExtendedInt getStartDate(Transition* t);
+	void crossTransition(Transition* t, bool mustChangeTokenValue, int newTokenValue = 0);
+	bool isEnded();
 	void deleteItem(PetriNetNode* nodeToDelete);
+
+	/*!
+	 * Destructs an item and gives back its memory to the arena.
+	 *
+	 * \param item : the item to destruct.
+	 */
+	template<class T> void destroyItem(T* item)
+	{
+		item->~T();
+		m_arena.deallocate(item, sizeof(T));
+	}
 };
 
 void externLaunch(void* arg, bool option);
@@ -0,0 +1,146 @@
+/*
+Copyright: LaBRI (http://www.labri.fr)
+
+Author(s): Score contributors
+Last modification: 17/10/2026
+
+Adviser(s): Myriam Desainte-Catherine (myriam.desainte-catherine@labri.fr)
+
+This software is a computer program whose purpose is to propose
+a library for interactive scores edition and execution.
+
+This software is governed by the CeCILL-C license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL-C
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+/*!
+ * \file PetriNetArena.cpp
+ * \author Score contributors
+ * \date 2026
+ */
+
+#include "PetriNetArena.hpp"
+
+#include <stdlib.h>
+#include <new>
+
+// all the items are aligned on the strictest fundamental alignment
+#define ARENA_ALIGNMENT 16
+
+PetriNetArena::PetriNetArena(std::size_t blockSize)
+{
+	m_blockSize = align(blockSize);
+	m_allocatedSize = 0;
+
+	m_current = NULL;
+	m_end = NULL;
+}
+
+PetriNetArena::~PetriNetArena()
+{
+	reset();
+}
+
+void* PetriNetArena::allocate(std::size_t size)
+{
+	size = align(size);
+
+	// reuse a freed item of the same size first
+	std::size_t sizeClass = size / ARENA_ALIGNMENT;
+
+	if (sizeClass < m_freeItems.size() && m_freeItems[sizeClass] != NULL) {
+		void* item = m_freeItems[sizeClass];
+		m_freeItems[sizeClass] = *(void**) item;
+		return item;
+	}
+
+	if (m_current == NULL || (std::size_t) (m_end - m_current) < size) {
+		// an item bigger than a block gets its own block
+		std::size_t blockSize = (size > m_blockSize) ? size : m_blockSize;
+
+		char* block = (char*) malloc(blockSize);
+
+		if (block == NULL) {
+			throw std::bad_alloc();
+		}
+
+		m_blocks.push_back(block);
+		m_allocatedSize += blockSize;
+
+		// the end of the former block is lost, it is only a few bytes
+		m_current = block;
+		m_end = block + blockSize;
+	}
+
+	void* item = m_current;
+	m_current += size;
+
+	return item;
+}
+
+void PetriNetArena::deallocate(void* item, std::size_t size)
+{
+	if (item == NULL) {
+		return;
+	}
+
+	std::size_t sizeClass = align(size) / ARENA_ALIGNMENT;
+
+	if (sizeClass >= m_freeItems.size()) {
+		m_freeItems.resize(sizeClass + 1, NULL);
+	}
+
+	*(void**) item = m_freeItems[sizeClass];
+	m_freeItems[sizeClass] = item;
+}
+
+void PetriNetArena::reset()
+{
+	for (unsigned int i = 0; i < m_blocks.size(); ++i) {
+		free(m_blocks[i]);
+	}
+
+	m_blocks.clear();
+	m_freeItems.clear();
+	m_allocatedSize = 0;
+
+	m_current = NULL;
+	m_end = NULL;
+}
+
+std::size_t PetriNetArena::getAllocatedSize()
+{
+	return m_allocatedSize;
+}
+
+std::size_t PetriNetArena::align(std::size_t size)
+{
+	if (size < sizeof(void*)) {
+		size = sizeof(void*);
+	}
+
+	return (size + ARENA_ALIGNMENT - 1) & ~((std::size_t) ARENA_ALIGNMENT - 1);
+}
@@ -0,0 +1,130 @@
+/*
+Copyright: LaBRI (http://www.labri.fr)
+
+Author(s): Score contributors
+Last modification: 17/10/2026
+
+Adviser(s): Myriam Desainte-Catherine (myriam.desainte-catherine@labri.fr)
+
+This software is a computer program whose purpose is to propose
+a library for interactive scores edition and execution.
+
+This software is governed by the CeCILL-C license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL-C
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef PETRINETARENA_HPP_
+#define PETRINETARENA_HPP_
+
+/*!
+ * \file PetriNetArena.hpp
+ * \author Score contributors
+ * \date 2026
+ */
+
+#include <cstddef>
+#include <vector>
+
+/*!
+ * \class PetriNetArena
+ *
+ * Memory arena of a Petri Network : all the items of the network (places,
+ * transitions, arcs, actions) are allocated from large blocks instead of one
+ * by one on the heap.
+ *
+ * A freed item goes into a free list of its size and is reused by the next
+ * allocation of the same size, so items created and freed during the
+ * execution (like PriorityTransitionAction) don't make the memory grow.
+ * All the blocks are released at once when the arena is reset or destroyed.
+ */
+class PetriNetArena
+{
+public:
+	/*!
+	 * Constructor
+	 *
+	 * \param blockSize : size in bytes of each block.
+	 */
+	PetriNetArena(std::size_t blockSize = 65536);
+
+	/*!
+	 * Destructor : releases all the blocks.
+	 */
+	~PetriNetArena();
+
+	/*!
+	 * Allocates memory for an item.
+	 *
+	 * \param size : size in bytes of the item.
+	 * \return the memory for the item.
+	 */
+	void* allocate(std::size_t size);
+
+	/*!
+	 * Gives back the memory of an item to be reused by the next allocation of the same size.
+	 *
+	 * \param item : memory returned by allocate.
+	 * \param size : size in bytes given to allocate.
+	 */
+	void deallocate(void* item, std::size_t size);
+
+	/*!
+	 * Releases all the blocks at once.
+	 *
+	 * The items allocated in the arena are not destructed.
+	 */
+	void reset();
+
+	/*!
+	 * Gets the memory taken by the arena.
+	 *
+	 * \return the size in bytes of all the blocks.
+	 */
+	std::size_t getAllocatedSize();
+
+private:
+	/*!
+	 * Rounds a size up to the alignment of the items.
+	 *
+	 * \param size : a size in bytes.
+	 * \return the aligned size.
+	 */
+	static std::size_t align(std::size_t size);
+
+	std::vector<char*> m_blocks; // all the allocated blocks.
+	std::vector<void*> m_freeItems; // free lists by aligned size (each free item stores the next one).
+
+	std::size_t m_blockSize; // size in bytes of each block.
+	std::size_t m_allocatedSize; // size in bytes of all the blocks.
+
+	char* m_current; // next free byte of the last block.
+	char* m_end; // end of the last block.
+
+	PetriNetArena(const PetriNetArena&);
+	PetriNetArena& operator=(const PetriNetArena&);
+};
+
+#endif /*PETRINETARENA_HPP_*/
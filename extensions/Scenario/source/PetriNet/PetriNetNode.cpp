@@ -57,47 +57,34 @@ PetriNetNode::PetriNetNode(PetriNet* petriNet)
 :PetriNetItem(petriNet) {
 	int nbColors = getPetriNet()->nbOfPossibleColors();
 
-	//m_inGoingArcs.assign(nbColors, std::vector<Arc*>(NULL));
-	m_inGoingArcs.assign(nbColors, arcList(NULL));
-	m_outGoingArcs.assign(nbColors, arcList(NULL));
+	m_inGoingColorEnds.assign(nbColors, 0);
+	m_outGoingColorEnds.assign(nbColors, 0);
 }
 
-//TODO : regarder le comportement de back_inserter;
-arcList PetriNetNode::inGoingArcsOf() {
-	arcList resultArcList;
-
-	for (unsigned int i = 0; i < nbOfPossibleColors(); i++) {
-		resultArcList.insert(resultArcList.end(), m_inGoingArcs[i].begin(), m_inGoingArcs[i].end());
-	}
-
-	return resultArcList;
+ArcRange PetriNetNode::inGoingArcsOf() {
+	return rangeOf(m_inGoingArcs, 0, m_inGoingArcs.size());
 }
 
-arcList PetriNetNode::inGoingArcsOf(int colorLabel) {
+ArcRange PetriNetNode::inGoingArcsOf(int colorLabel) {
 	if (!isColorValid(colorLabel)) {
 		throw OutOfBoundException();
 	}
 
-	return m_inGoingArcs[colorLabel - 1];
+	colorLabel--;
+	return rangeOf(m_inGoingArcs, (colorLabel > 0) ? m_inGoingColorEnds[colorLabel - 1] : 0, m_inGoingColorEnds[colorLabel]);
 }
 
-//TODO : regarder le comportement de back_inserter;
-arcList PetriNetNode::outGoingArcsOf() {
-	arcList resultArcList;
-
-	for (unsigned int i = 0; i < nbOfPossibleColors(); i++) {
-		resultArcList.insert(resultArcList.end(), m_outGoingArcs[i].begin(), m_outGoingArcs[i].end());
-	}
-
-	return resultArcList;
+ArcRange PetriNetNode::outGoingArcsOf() {
+	return rangeOf(m_outGoingArcs, 0, m_outGoingArcs.size());
 }
 
-arcList PetriNetNode::outGoingArcsOf(int colorLabel) {
+ArcRange PetriNetNode::outGoingArcsOf(int colorLabel) {
 	if (!isColorValid(colorLabel)) {
 		throw OutOfBoundException();
 	}
 
-	return m_outGoingArcs[colorLabel - 1];
+	colorLabel--;
+	return rangeOf(m_outGoingArcs, (colorLabel > 0) ? m_outGoingColorEnds[colorLabel - 1] : 0, m_outGoingColorEnds[colorLabel]);
 }
 
 void PetriNetNode::setInGoingArcs(arcList list, int colorLabel) {
@@ -105,7 +92,7 @@ void PetriNetNode::setInGoingArcs(arcList list, int colorLabel) {
 		throw OutOfBoundException();
 	}
 
-	m_inGoingArcs[colorLabel - 1] = list;
+	replaceArcs(m_inGoingArcs, m_inGoingColorEnds, list, colorLabel - 1);
 }
 
 void PetriNetNode::setOutGoingArcs(arcList list, int colorLabel) {
@@ -113,7 +100,7 @@ void PetriNetNode::setOutGoingArcs(arcList list, int colorLabel) {
 		throw OutOfBoundException();
 	}
 
-	m_outGoingArcs[colorLabel - 1] = list;
+	replaceArcs(m_outGoingArcs, m_outGoingColorEnds, list, colorLabel - 1);
 }
 
 void PetriNetNode::addInGoingArcs(Arc* arcToAdd, int colorLabel) {
@@ -121,9 +108,7 @@ void PetriNetNode::addInGoingArcs(Arc* arcToAdd, int colorLabel) {
 		throw OutOfBoundException();
 	}
 
-	colorLabel--;
-
-	m_inGoingArcs[colorLabel].push_back(arcToAdd);
+	insertArc(m_inGoingArcs, m_inGoingColorEnds, arcToAdd, colorLabel - 1);
 }
 
 void PetriNetNode::addOutGoingArcs(Arc* arcToAdd, int colorLabel) {
@@ -131,9 +116,7 @@ void PetriNetNode::addOutGoingArcs(Arc* arcToAdd, int colorLabel) {
 		throw OutOfBoundException();
 	}
 
-	colorLabel--;
-
-	m_outGoingArcs[colorLabel].push_back(arcToAdd);
+	insertArc(m_outGoingArcs, m_outGoingColorEnds, arcToAdd, colorLabel - 1);
 }
 
 void PetriNetNode::removeInGoingArcs(Arc* arcToRemove) {
@@ -153,43 +136,77 @@ void PetriNetNode::removeInGoingArcs(Arc* arcToRemove, int colorLabel) {
 		throw OutOfBoundException();
 	}
 
-	int indexToRemove = -1;
-    
-	colorLabel --;
+	eraseArc(m_inGoingArcs, m_inGoingColorEnds, arcToRemove, colorLabel - 1);
+}
 
-	for (unsigned int i = 0; i < m_inGoingArcs[colorLabel].size(); i++) {
-		if (m_inGoingArcs[colorLabel][i] == arcToRemove) {
-			indexToRemove = i;
-		}
+void PetriNetNode::removeOutGoingArcs(Arc* arcToRemove, int colorLabel) {
+	if (!isColorValid(colorLabel)) {
+		throw OutOfBoundException();
 	}
 
-	if (indexToRemove != -1) {
-		m_inGoingArcs[colorLabel].erase(m_inGoingArcs[colorLabel].begin() + indexToRemove);
+	eraseArc(m_outGoingArcs, m_outGoingColorEnds, arcToRemove, colorLabel - 1);
+}
+
+ArcRange PetriNetNode::rangeOf(const arcList& arcs, unsigned int first, unsigned int last) {
+	if (first >= last) {
+		return ArcRange();
 	}
+
+	return ArcRange(&arcs[0] + first, &arcs[0] + last);
 }
 
-void PetriNetNode::removeOutGoingArcs(Arc* arcToRemove, int colorLabel) {
-	if (!isColorValid(colorLabel)) {
-		throw OutOfBoundException();
+void PetriNetNode::insertArc(arcList& arcs, std::vector<unsigned int>& colorEnds, Arc* arcToAdd, unsigned int colorIndex) {
+	arcs.insert(arcs.begin() + colorEnds[colorIndex], arcToAdd);
+
+	for (unsigned int i = colorIndex; i < colorEnds.size(); i++) {
+		colorEnds[i]++;
 	}
+}
+
+void PetriNetNode::eraseArc(arcList& arcs, std::vector<unsigned int>& colorEnds, Arc* arcToRemove, unsigned int colorIndex) {
+	unsigned int first = (colorIndex > 0) ? colorEnds[colorIndex - 1] : 0;
+
+	// the last matching arc is removed
+	for (unsigned int i = colorEnds[colorIndex]; i > first; i--) {
+		if (arcs[i - 1] == arcToRemove) {
+			arcs.erase(arcs.begin() + i - 1);
 
-	int indexToRemove = -1;
-    
-	colorLabel --;
+			for (unsigned int j = colorIndex; j < colorEnds.size(); j++) {
+				colorEnds[j]--;
+			}
 
-	for (unsigned int i = 0; i < m_outGoingArcs[colorLabel].size(); i++) {
-		if (m_outGoingArcs[colorLabel][i] == arcToRemove) {
-			indexToRemove = i;
+			return;
 		}
 	}
+}
+
+void PetriNetNode::replaceArcs(arcList& arcs, std::vector<unsigned int>& colorEnds, const arcList& list, unsigned int colorIndex) {
+	unsigned int first = (colorIndex > 0) ? colorEnds[colorIndex - 1] : 0;
+	unsigned int last = colorEnds[colorIndex];
+	int difference = (int) list.size() - (int) (last - first);
+
+	arcs.erase(arcs.begin() + first, arcs.begin() + last);
+	arcs.insert(arcs.begin() + first, list.begin(), list.end());
 
-	if (indexToRemove != -1) {
-		m_outGoingArcs[colorLabel].erase(m_outGoingArcs[colorLabel].begin() + indexToRemove);
+	for (unsigned int i = colorIndex; i < colorEnds.size(); i++) {
+		colorEnds[i] += difference;
 	}
 }
 
+// go through the shorter list : the start and the end transitions of a scenario are linked to many places
 Arc* haveArc(PetriNetNode* from, PetriNetNode* to, int colorLabel) {
-	arcList outGoingsArcs = from->outGoingArcsOf(colorLabel);
+	ArcRange outGoingsArcs = from->outGoingArcsOf(colorLabel);
+	ArcRange inGoingsArcs = to->inGoingArcsOf(colorLabel);
+
+	if (inGoingsArcs.size() < outGoingsArcs.size()) {
+		for (unsigned int i = 0; i < inGoingsArcs.size(); i++) {
+			if (inGoingsArcs[i]->getFrom() == from) {
+				return inGoingsArcs[i];
+			}
+		}
+
+		return NULL;
+	}
 
 	for (unsigned int i = 0; i < outGoingsArcs.size(); i++) {
 		if (outGoingsArcs[i]->getTo() == to) {
@@ -201,7 +218,18 @@ Arc* haveArc(PetriNetNode* from, PetriNetNode* to, int colorLabel) {
 }
 
 Arc* haveArc(PetriNetNode* from, PetriNetNode* to) {
-	arcList outGoingsArcs = from->outGoingArcsOf();
+	ArcRange outGoingsArcs = from->outGoingArcsOf();
+	ArcRange inGoingsArcs = to->inGoingArcsOf();
+
+	if (inGoingsArcs.size() < outGoingsArcs.size()) {
+		for (unsigned int i = 0; i < inGoingsArcs.size(); i++) {
+			if (inGoingsArcs[i]->getFrom() == from) {
+				return inGoingsArcs[i];
+			}
+		}
+
+		return NULL;
+	}
 
 	for (unsigned int i = 0; i < outGoingsArcs.size(); i++) {
 		if (outGoingsArcs[i]->getTo() == to) {
@@ -230,7 +258,7 @@ Arc* PetriNetNode::haveArcTo(PetriNetNode* to, int colorLabel) {
 
 // TODO : regarder l'utilisation de unique !
 petriNetNodeList PetriNetNode::returnSuccessors() {
-	arcList outGoingArcs = outGoingArcsOf();
+	ArcRange outGoingArcs = outGoingArcsOf();
 
 	set<PetriNetNode*> petriNetSet;
 
@@ -245,7 +273,7 @@ petriNetNodeList PetriNetNode::returnSuccessors() {
 
 // TODO : regarder l'utilisation de unique !
 petriNetNodeList PetriNetNode::returnSuccessors(int colorLabel) {
-	arcList outGoingArcs = outGoingArcsOf(colorLabel);
+	ArcRange outGoingArcs = outGoingArcsOf(colorLabel);
 
 	set<PetriNetNode*> petriNetSet;
 
@@ -260,7 +288,7 @@ petriNetNodeList PetriNetNode::returnSuccessors(int colorLabel) {
 
 // TODO : regarder l'utilisation de unique !
 petriNetNodeList PetriNetNode::returnPredecessors() {
-	arcList inGoingArcs = inGoingArcsOf();
+	ArcRange inGoingArcs = inGoingArcsOf();
 
 	set<PetriNetNode*> petriNetSet;
 
@@ -275,7 +303,7 @@ petriNetNodeList PetriNetNode::returnPredecessors() {
 
 // TODO : regarder l'utilisation de unique !
 petriNetNodeList PetriNetNode::returnPredecessors(int colorLabel) {
-	arcList inGoingArcs = inGoingArcsOf(colorLabel);
+	ArcRange inGoingArcs = inGoingArcsOf(colorLabel);
 
 	set<PetriNetNode*> petriNetSet;
 
@@ -289,8 +317,9 @@ petriNetNodeList PetriNetNode::returnPredecessors(int colorLabel) {
 }
 
 void PetriNetNode::changeNbOfColors(int newNbColors) {
-	m_inGoingArcs.resize(newNbColors, arcList(NULL));
-	m_outGoingArcs.resize(newNbColors, arcList(NULL));
+	// the new colors have no arc
+	m_inGoingColorEnds.resize(newNbColors, m_inGoingArcs.size());
+	m_outGoingColorEnds.resize(newNbColors, m_outGoingArcs.size());
 }
 
 PetriNetNode::~PetriNetNode() {
@@ -53,9 +53,38 @@ knowledge of the CeCILL-C license and that you accept its terms.
 #include <vector>
 
 typedef std::vector<Arc*> arcList; // TODO : refactor, because later we don't know what is an arcList ! +1 CB
-typedef std::vector<arcList> arcListByColor;
 typedef std::vector<PetriNetNode*> petriNetNodeList;
 
+/*!
+ * \class ArcRange
+ *
+ * Non-owning view on contiguous arcs of a node, to go through them without copying them.
+ *
+ * The view is valid until an arc is added to or removed from the node : a caller that
+ * modifies the arcs while going through them must copy them in an arcList first.
+ */
+class ArcRange
+{
+public:
+	ArcRange() : m_begin(NULL), m_end(NULL) {}
+
+	ArcRange(Arc* const* begin, Arc* const* end) : m_begin(begin), m_end(end) {}
+
+	Arc* const* begin() const { return m_begin; }
+
+	Arc* const* end() const { return m_end; }
+
+	unsigned int size() const { return m_end - m_begin; }
+
+	bool empty() const { return m_begin == m_end; }
+
+	Arc* operator[](unsigned int index) const { return m_begin[index]; }
+
+private:
+	Arc* const* m_begin;
+	Arc* const* m_end;
+};
+
 /*!
  * \class PetriNetNode
  *
@@ -76,9 +105,9 @@ public:
 	/*!
 	 * Gets all the in-going arcs of this node (all colors taken together).
 	 *
-	 * \return all the in-going arcs of this node (all colors taken together).
+	 * \return a view on all the in-going arcs of this node (all colors taken together).
 	 */
-	arcList inGoingArcsOf();
+	ArcRange inGoingArcsOf();
 
 	/*!
 	 * Gets the in-going arcs of the given color.
@@ -86,16 +115,16 @@ public:
 	 * Throws a OutOfBoundException if colorLabel is not valid.
 	 *
 	 * \param colorLabel : color of the in-going arcs.
-	 * \return the in-going arcs of the given color.
+	 * \return a view on the in-going arcs of the given color.
 	 */
-	arcList inGoingArcsOf(int colorLabel);
+	ArcRange inGoingArcsOf(int colorLabel);
 
 	/*!
 	 * Gets all the out-going arcs of this node (all colors taken together).
 	 *
-	 * \return all the out-going arcs of this node (all colors taken together).
+	 * \return a view on all the out-going arcs of this node (all colors taken together).
 	 */
-	arcList outGoingArcsOf();
+	ArcRange outGoingArcsOf();
 
 	/*!
 	 * Gets the out-going arcs of the given color.
@@ -103,9 +132,9 @@ public:
 	 * Throws a OutOfBoundException if colorLabel is not valid.
 	 *
 	 * \param colorLabel : color of the out-going arcs.
-	 * \return the out-going arcs of the given color.
+	 * \return a view on the out-going arcs of the given color.
 	 */
-	arcList outGoingArcsOf(int colorLabel);
+	ArcRange outGoingArcsOf(int colorLabel);
 
 	/*!
 	 * Sets the in-going arcs list of the given color.
@@ -283,9 +312,52 @@ private :
 	 */
 	PetriNetNode(); // default constructor.
 
-	arcListByColor m_inGoingArcs; // ingoing arcs, by color.
+	// the arcs of all the colors are stored in one array (color 1 first) : each color is a contiguous range
+	arcList m_inGoingArcs; // ingoing arcs, grouped by color.
+	std::vector<unsigned int> m_inGoingColorEnds; // end of the ingoing arcs of each color.
+
+	arcList m_outGoingArcs; // outgoing arcs, grouped by color.
+	std::vector<unsigned int> m_outGoingColorEnds; // end of the outgoing arcs of each color.
 
-	arcListByColor m_outGoingArcs; // outgoing arcs, by color.
+	/*!
+	 * Gets a view on a range of arcs.
+	 *
+	 * \param arcs : arcs grouped by color.
+	 * \param first : index of the first arc.
+	 * \param last : index after the last arc.
+	 * \return the view.
+	 */
+	static ArcRange rangeOf(const arcList& arcs, unsigned int first, unsigned int last);
+
+	/*!
+	 * Adds an arc at the end of the range of its color.
+	 *
+	 * \param arcs : arcs grouped by color.
+	 * \param colorEnds : end of the arcs of each color.
+	 * \param arcToAdd : arc to add.
+	 * \param colorIndex : color of the arc - 1.
+	 */
+	static void insertArc(arcList& arcs, std::vector<unsigned int>& colorEnds, Arc* arcToAdd, unsigned int colorIndex);
+
+	/*!
+	 * Removes an arc from the range of its color.
+	 *
+	 * \param arcs : arcs grouped by color.
+	 * \param colorEnds : end of the arcs of each color.
+	 * \param arcToRemove : arc to remove.
+	 * \param colorIndex : color of the arc - 1.
+	 */
+	static void eraseArc(arcList& arcs, std::vector<unsigned int>& colorEnds, Arc* arcToRemove, unsigned int colorIndex);
+
+	/*!
+	 * Replaces the range of a color.
+	 *
+	 * \param arcs : arcs grouped by color.
+	 * \param colorEnds : end of the arcs of each color.
+	 * \param list : new arcs of the color.
+	 * \param colorIndex : color - 1.
+	 */
+	static void replaceArcs(arcList& arcs, std::vector<unsigned int>& colorEnds, const arcList& list, unsigned int colorIndex);
 
 protected :
 	/*!
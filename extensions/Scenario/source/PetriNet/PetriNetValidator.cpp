@@ -0,0 +1,347 @@
+/*
+Copyright: LaBRI (http://www.labri.fr)
+
+Author(s): Score contributors
+Last modification: 17/10/2026
+
+Adviser(s): Myriam Desainte-Catherine (myriam.desainte-catherine@labri.fr)
+
+This software is a computer program whose purpose is to propose
+a library for interactive scores edition and execution.
+
+This software is governed by the CeCILL-C license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL-C
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL-C license and that you accept its terms.
+*/
+/*!
+ * \file PetriNetValidator.cpp
+ * \author Score contributors
+ * \date 2026
+ */
+
+#include "PetriNetValidator.hpp"
+
+#include "PetriNet.hpp"
+
+#include <sstream>
+
+PetriNetValidator::PetriNetValidator(PetriNet* petriNet)
+{
+	m_petriNet = petriNet;
+	m_hasDefiniteErrors = false;
+}
+
+bool PetriNetValidator::validate()
+{
+	const placeList& places = m_petriNet->getPlaces();
+	const transitionList& transitions = m_petriNet->getTransitions();
+
+	m_errors.clear();
+	m_producers.clear();
+
+	// the items keep their index (the same as in the ExecutionPlan) : no map to look them up
+	for (unsigned int i = 0; i < places.size(); ++i) {
+		places[i]->m_planIndex = i;
+	}
+
+	for (unsigned int i = 0; i < transitions.size(); ++i) {
+		transitions[i]->m_planIndex = i;
+	}
+
+	m_producers.resize(places.size());
+
+	for (unsigned int i = 0; i < transitions.size(); ++i) {
+		ArcRange outGoingArcs = transitions[i]->outGoingArcsOf();
+
+		for (unsigned int j = 0; j < outGoingArcs.size(); ++j) {
+			m_producers[((Place*) outGoingArcs[j]->getTo())->m_planIndex].push_back(i);
+		}
+	}
+
+	checkStructure();
+	checkBounds();
+
+	// the dates can only be propagated in a net where every transition can be crossed
+	if (m_errors.empty()) {
+		checkReachability();
+	}
+
+	m_hasDefiniteErrors = !m_errors.empty();
+
+	if (m_errors.empty()) {
+		checkDates();
+	}
+
+	return m_errors.empty();
+}
+
+const std::vector<std::string>& PetriNetValidator::getErrors()
+{
+	return m_errors;
+}
+
+bool PetriNetValidator::hasDefiniteErrors()
+{
+	return m_hasDefiniteErrors;
+}
+
+void PetriNetValidator::checkStructure()
+{
+	const transitionList& transitions = m_petriNet->getTransitions();
+
+	if (m_petriNet->getStartPlace() == NULL) {
+		addError("the start place is not set");
+	}
+
+	if (m_petriNet->getEndPlace() == NULL) {
+		addError("the end place is not set");
+	}
+
+	for (unsigned int i = 0; i < transitions.size(); ++i) {
+		if (transitions[i]->inGoingArcsOf().empty()) {
+			addError("no place to wait for", i);
+		}
+	}
+}
+
+void PetriNetValidator::checkBounds()
+{
+	const transitionList& transitions = m_petriNet->getTransitions();
+
+	for (unsigned int i = 0; i < transitions.size(); ++i) {
+		ArcRange inGoingArcs = transitions[i]->inGoingArcsOf();
+
+		for (unsigned int j = 0; j < inGoingArcs.size(); ++j) {
+			ExtendedInt minValue = inGoingArcs[j]->getRelativeMinValue();
+			ExtendedInt maxValue = inGoingArcs[j]->getRelativeMaxValue();
+
+			if (minValue.isPlusInfinity() || maxValue.isMinusInfinity() || minValue >= maxValue) {
+				addError("an in-going arc has a min time greater or equal than its max time", i);
+			}
+		}
+	}
+}
+
+void PetriNetValidator::checkReachability()
+{
+	const transitionList& transitions = m_petriNet->getTransitions();
+
+	std::vector<bool> markedPlaces(m_producers.size(), false);
+	std::vector<unsigned int> nbOfMarkedArcs(transitions.size(), 0);
+	std::vector<bool> crossedTransitions(transitions.size(), false);
+	std::vector<unsigned int> placesToVisit;
+
+	// mark the places which could receive a token, whatever the time
+	markedPlaces[m_petriNet->getStartPlace()->m_planIndex] = true;
+	placesToVisit.push_back(m_petriNet->getStartPlace()->m_planIndex);
+
+	while (!placesToVisit.empty()) {
+		Place* place = m_petriNet->getPlaces()[placesToVisit.back()];
+		ArcRange outGoingArcs = place->outGoingArcsOf();
+
+		placesToVisit.pop_back();
+
+		for (unsigned int i = 0; i < outGoingArcs.size(); ++i) {
+			Transition* transition = (Transition*) outGoingArcs[i]->getTo();
+			unsigned int index = transition->m_planIndex;
+
+			if (++nbOfMarkedArcs[index] < transition->inGoingArcsOf().size()) {
+				continue;
+			}
+
+			crossedTransitions[index] = true;
+
+			ArcRange producedArcs = transition->outGoingArcsOf();
+
+			for (unsigned int j = 0; j < producedArcs.size(); ++j) {
+				unsigned int producedPlace = ((Place*) producedArcs[j]->getTo())->m_planIndex;
+
+				if (!markedPlaces[producedPlace]) {
+					markedPlaces[producedPlace] = true;
+					placesToVisit.push_back(producedPlace);
+				}
+			}
+		}
+	}
+
+	for (unsigned int i = 0; i < transitions.size(); ++i) {
+		if (!crossedTransitions[i]) {
+			addError("it can never be crossed", i);
+		}
+	}
+
+	if (!markedPlaces[m_petriNet->getEndPlace()->m_planIndex]) {
+		addError("the end place can never be reached");
+	}
+}
+
+void PetriNetValidator::checkDates()
+{
+	const transitionList& transitions = m_petriNet->getTransitions();
+	unsigned int startPlace = m_petriNet->getStartPlace()->m_planIndex;
+
+	std::vector<unsigned int> nbOfWaitedProducers(transitions.size(), 0);
+
+	// topological order of the transitions (a transition comes after the producers of its places)
+	m_order.clear();
+
+	for (unsigned int i = 0; i < transitions.size(); ++i) {
+		ArcRange inGoingArcs = transitions[i]->inGoingArcsOf();
+
+		for (unsigned int j = 0; j < inGoingArcs.size(); ++j) {
+			nbOfWaitedProducers[i] += m_producers[((Place*) inGoingArcs[j]->getFrom())->m_planIndex].size();
+		}
+
+		if (nbOfWaitedProducers[i] == 0) {
+			m_order.push_back(i);
+		}
+	}
+
+	for (unsigned int i = 0; i < m_order.size(); ++i) {
+		ArcRange outGoingArcs = transitions[m_order[i]]->outGoingArcsOf();
+
+		for (unsigned int j = 0; j < outGoingArcs.size(); ++j) {
+			ArcRange consumerArcs = ((Place*) outGoingArcs[j]->getTo())->outGoingArcsOf();
+
+			for (unsigned int k = 0; k < consumerArcs.size(); ++k) {
+				unsigned int consumer = ((Transition*) consumerArcs[k]->getTo())->m_planIndex;
+
+				if (--nbOfWaitedProducers[consumer] == 0) {
+					m_order.push_back(consumer);
+				}
+			}
+		}
+	}
+
+	if (m_order.size() < transitions.size()) {
+		addError("the PetriNet has a cycle, its dates can't be checked");
+		return;
+	}
+
+	m_earliestDates.assign(transitions.size(), ExtendedInt(INTEGER, 0));
+	m_latestDates.assign(transitions.size(), ExtendedInt(INTEGER, 0));
+
+	for (unsigned int i = 0; i < m_order.size(); ++i) {
+		unsigned int transition = m_order[i];
+		ArcRange inGoingArcs = transitions[transition]->inGoingArcsOf();
+
+		std::vector<ExtendedInt> earliestMarks(inGoingArcs.size());
+		std::vector<ExtendedInt> latestMarks(inGoingArcs.size());
+
+		ExtendedInt earliestStart(MINUS_INFINITY), latestStart(MINUS_INFINITY);
+		ExtendedInt earliestEnd(PLUS_INFINITY), latestEnd(PLUS_INFINITY);
+
+		// the place is marked by the first of its producers
+		for (unsigned int j = 0; j < inGoingArcs.size(); ++j) {
+			unsigned int place = ((Place*) inGoingArcs[j]->getFrom())->m_planIndex;
+			std::vector<unsigned int>& producers = m_producers[place];
+
+			earliestMarks[j] = (place == startPlace) ? ExtendedInt(INTEGER, 0) : ExtendedInt(PLUS_INFINITY);
+			latestMarks[j] = earliestMarks[j];
+
+			for (unsigned int k = 0; k < producers.size(); ++k) {
+				if (m_earliestDates[producers[k]] < earliestMarks[j]) {
+					earliestMarks[j] = m_earliestDates[producers[k]];
+				}
+
+				if (m_latestDates[producers[k]] < latestMarks[j]) {
+					latestMarks[j] = m_latestDates[producers[k]];
+				}
+			}
+
+			// a transition is never crossed before its places are marked
+			ExtendedInt minValue = inGoingArcs[j]->getRelativeMinValue();
+			ExtendedInt maxValue = inGoingArcs[j]->getRelativeMaxValue();
+
+			if (minValue < ExtendedInt(INTEGER, 0)) {
+				minValue = ExtendedInt(INTEGER, 0);
+			}
+
+			if (earliestMarks[j] + minValue > earliestStart) {
+				earliestStart = earliestMarks[j] + minValue;
+			}
+
+			if (latestMarks[j] + minValue > latestStart) {
+				latestStart = latestMarks[j] + minValue;
+			}
+
+			if (earliestMarks[j] + maxValue < earliestEnd) {
+				earliestEnd = earliestMarks[j] + maxValue;
+			}
+
+			if (latestMarks[j] + maxValue < latestEnd) {
+				latestEnd = latestMarks[j] + maxValue;
+			}
+		}
+
+		if (earliestStart > latestEnd) {
+			addError("the times of its in-going arcs can't be satisfied together", transition);
+		}
+
+		// when the max of an arc is reached, the transition is forced : all the other places have to be marked
+		unsigned int lastMarked = 0;
+		ExtendedInt secondLastMark(MINUS_INFINITY);
+
+		for (unsigned int j = 1; j < inGoingArcs.size(); ++j) {
+			if (latestMarks[j] > latestMarks[lastMarked]) {
+				secondLastMark = latestMarks[lastMarked];
+				lastMarked = j;
+			} else if (latestMarks[j] > secondLastMark) {
+				secondLastMark = latestMarks[j];
+			}
+		}
+
+		for (unsigned int j = 0; j < inGoingArcs.size(); ++j) {
+			ExtendedInt otherLastMark = (j == lastMarked) ? secondLastMark : latestMarks[lastMarked];
+
+			if (otherLastMark > earliestMarks[j] + inGoingArcs[j]->getRelativeMaxValue()) {
+				addError("it could be forced before all its places are marked", transition);
+				break;
+			}
+		}
+
+		m_earliestDates[transition] = earliestStart;
+
+		if (transitions[transition]->isStatic()) {
+			m_latestDates[transition] = latestStart;
+		} else {
+			m_latestDates[transition] = (latestEnd < latestStart) ? latestStart : latestEnd;
+		}
+	}
+}
+
+void PetriNetValidator::addError(const std::string& message)
+{
+	m_errors.push_back(message);
+}
+
+void PetriNetValidator::addError(const std::string& message, unsigned int transition)
+{
+	std::ostringstream error;
+
+	error << "transition " << transition << " (event " << m_petriNet->getTransitions()[transition]->getEvent() << ") : " << message;
+
+	m_errors.push_back(error.str());
+}
@@ -0,0 +1,128 @@
+/*
+Copyright: LaBRI (http://www.labri.fr)
+
+Author(s): Score contributors
+Last modification: 17/10/2026
+
+Adviser(s): Myriam Desainte-Catherine (myriam.desainte-catherine@labri.fr)
+
+This software is a computer program whose purpose is to propose
+a library for interactive scores edition and execution.
+
+This software is governed by the CeCILL-C license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL-C
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL-C license and that you accept its terms.
+*/
+#ifndef PETRINETVALIDATOR_HPP_
+#define PETRINETVALIDATOR_HPP_
+
+/*!
+ * \file PetriNetValidator.hpp
+ * \author Score contributors
+ * \date 2026
+ */
+
+#include "ExtendedInt.hpp"
+
+#include <string>
+#include <vector>
+
+class PetriNet;
+class Place;
+class Transition;
+
+/*!
+ * \class PetriNetValidator
+ *
+ * Static analysis of a one-color PetriNet made once before its execution,
+ * so the ExecutionPlan doesn't have to check anything while stepping.
+ *
+ * It checks that :
+ * - the start and end places are set and every transition waits for at least one place,
+ * - the time bounds of the in-going arcs of the transitions are consistent (min < max),
+ * - every transition can be crossed and the end place can be reached (no deadlock),
+ * - the net has no cycle and each transition can be crossed in time : all its
+ * in-going arcs are active before the first one reaches its max
+ * (else the transition would be forced while it can't be crossed).
+ *
+ * The dates are propagated from the start place : each transition gets the earliest
+ * and the latest date it could be crossed, an interactive transition being crossed
+ * anywhere between the min and the max of its in-going arcs.
+ */
+class PetriNetValidator
+{
+public:
+	/*!
+	 * Constructor
+	 *
+	 * \param petriNet : the PetriNet to validate.
+	 */
+	PetriNetValidator(PetriNet* petriNet);
+
+	/*!
+	 * Runs the analysis.
+	 *
+	 * \return true if no error was found.
+	 */
+	bool validate();
+
+	/*!
+	 * Gets the errors found by the last analysis (one message per error).
+	 *
+	 * \return the errors.
+	 */
+	const std::vector<std::string>& getErrors();
+
+	/*!
+	 * Tests if the last analysis found an error in the structure, the bounds or
+	 * the reachability of the PetriNet : such a PetriNet can't be executed at all.
+	 * The other errors come from the check of the dates, which is conservative
+	 * (the PetriNet can still be executed by its objects, which check it at each step).
+	 *
+	 * \return true if a definite error was found.
+	 */
+	bool hasDefiniteErrors();
+
+private:
+	PetriNet* m_petriNet; // the PetriNet to validate.
+	std::vector<std::string> m_errors; // errors found by the analysis.
+	bool m_hasDefiniteErrors; // true if an error was found before checking the dates.
+
+	std::vector<std::vector<unsigned int> > m_producers; // transitions producing tokens in each place.
+
+	std::vector<unsigned int> m_order; // transitions in topological order.
+	std::vector<ExtendedInt> m_earliestDates; // earliest date each transition could be crossed.
+	std::vector<ExtendedInt> m_latestDates; // latest date each transition could be crossed.
+
+	void checkStructure();
+	void checkBounds();
+	void checkReachability();
+	void checkDates();
+
+	void addError(const std::string& message);
+	void addError(const std::string& message, unsigned int transition);
+};
+
+#endif /*PETRINETVALIDATOR_HPP_*/
@@ -50,6 +50,7 @@ knowledge of the CeCILL-C license and that you accept its terms.
 Place::Place(PetriNet* petriNet)
 : PetriNetNode(petriNet) {
 	m_childPetriNet = NULL;
+	m_planIndex = 0;
 
 	int nbColors = getPetriNet()->nbOfPossibleColors();
 
@@ -105,7 +106,7 @@ void Place::produceTokens(unsigned int nbOfTokens, unsigned int colorLabel, int
     if(tokensTime < 0){tokensTime = 0;}
 
 	if ((oldNumberOfTokens < NB_OF_TOKEN_TO_ACTIVE_ARC) && (getNbOfTokens(colorLabel) >= NB_OF_TOKEN_TO_ACTIVE_ARC)) { // CB WTF : Si un token et deux arcs sortant, bug ?
-		arcList outGoingArcs = outGoingArcsOf(colorLabel);
+		ArcRange outGoingArcs = outGoingArcsOf(colorLabel);
 		for (unsigned int i = 0 ; i < outGoingArcs.size() ; ++i) {
 			Arc* arc = outGoingArcs[i];
             
@@ -142,8 +143,12 @@ void Place::changeNbOfColors(int newNbColors) {
 
 void Place::merge(Place* placeToMerge) // CB copie améliorée de Transition::merge, à descendre dans PetriNetNode ?
 {
-    arcList mergeInGoingArcs = placeToMerge->inGoingArcsOf(); // CB vector
-    arcList mergeOutGoingArcs = placeToMerge->outGoingArcsOf(); // CB vector
+    // copy the arcs because they are deleted while going through them
+    ArcRange mergeInGoingRange = placeToMerge->inGoingArcsOf();
+    ArcRange mergeOutGoingRange = placeToMerge->outGoingArcsOf();
+
+    arcList mergeInGoingArcs(mergeInGoingRange.begin(), mergeInGoingRange.end());
+    arcList mergeOutGoingArcs(mergeOutGoingRange.begin(), mergeOutGoingRange.end());
     
     for (arcList::iterator it = mergeInGoingArcs.begin() ; it != mergeInGoingArcs.end() ; it++) {
         Arc* newArc = getPetriNet()->createArc(dynamic_cast<Transition*>((*it)->getFrom()), this); // CB uncheck cast
@@ -165,7 +170,7 @@ void Place::print() {
 
 	std::cout << "Outgoings Arcs : " << std::endl;
 
-	arcList outGoingArcs = outGoingArcsOf();
+	ArcRange outGoingArcs = outGoingArcsOf();
 	for (unsigned int i = 0; i < outGoingArcs.size(); ++i) {
 		std::cout << "To : " << outGoingArcs[i]->getTo() << std::endl;
 		std::cout << "RelMin : " << outGoingArcs[i]->getRelativeMinValue().getValue() << std::endl;
@@ -176,7 +181,7 @@ void Place::print() {
 	}
 
 	std::cout << "Ingoings Arcs : " << std::endl;
-	arcList inGoingArcs = inGoingArcsOf();
+	ArcRange inGoingArcs = inGoingArcsOf();
 	for (unsigned int i = 0; i < inGoingArcs.size(); ++i) {
 		std::cout << "From : " << inGoingArcs[i]->getFrom() << std::endl;
 		std::cout << "RelMin : " << inGoingArcs[i]->getRelativeMinValue().getValue() << std::endl;
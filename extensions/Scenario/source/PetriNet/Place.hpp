@@ -59,6 +59,8 @@ class Place : public PetriNetNode
 {
 public:
 	friend class PetriNet;
+	friend class ExecutionPlan;
+	friend class PetriNetValidator;
 
 	/*!
 	 * Gets the number of tokens in the place (all colors taken together).
@@ -112,6 +114,8 @@ private :
 
 	std::vector<std::vector<Token> > m_tokenByColor; // tokens by color.
 
+	unsigned int m_planIndex; // index of the place in its PetriNet, set by the ExecutionPlan and the PetriNetValidator.
+
 	/*!
 	 * Default constructor.
 	 *
@@ -47,7 +47,7 @@ knowledge of the CeCILL-C license and that you accept its terms.
 #include "Transition.hpp"
 
 PriorityTransitionAction::PriorityTransitionAction(Transition* transition, short type, ExtendedInt date)
-:m_linkedTransition(transition), m_type(type), m_date(date), m_isEnable(true) // TODO : check construction of m_date (should pass INTEGER type)
+:m_linkedTransition(transition), m_type(type), m_date(date), m_heapIndex(-1) // TODO : check construction of m_date (should pass INTEGER type)
 {
 	if (type != START && type != END) {
 		throw IllegalArgumentException("PriorityTransitionAction : Invalid type");
@@ -75,21 +75,22 @@ ExtendedInt PriorityTransitionAction::getDate() const
 ExtendedInt PriorityTransitionAction::setDate(unsigned int date)
 {
 	m_date.setAsInteger(date);
+	return m_date;
 }
 
-Transition* PriorityTransitionAction::getTransition() const
+void PriorityTransitionAction::setDate(ExtendedInt date)
 {
-	return m_linkedTransition;
+	m_date = date;
 }
 
-bool PriorityTransitionAction::isEnable() const
+Transition* PriorityTransitionAction::getTransition() const
 {
-	return m_isEnable;
+	return m_linkedTransition;
 }
 
-void PriorityTransitionAction::disable()
+bool PriorityTransitionAction::isEnable() const
 {
-	m_isEnable = false;
+	return m_heapIndex >= 0;
 }
 
 //bool PriorityTransitionAction::operator<(PriorityTransitionAction a) const
@@ -89,6 +89,15 @@ public:
 
 	ExtendedInt setDate(unsigned int date);
 
+	/*!
+	 * Sets the action starting date.
+	 *
+	 * The action must not be in a priority queue (or the queue must be updated after).
+	 *
+	 * \param date : action starting date.
+	 */
+	void setDate(ExtendedInt date);
+
 	/*!
 	 * Gets the linked transition.
 	 *
@@ -97,17 +106,12 @@ public:
 	Transition* getTransition() const;
 
 	/*!
-	 * Tests if the action is still enable.
+	 * Tests if the action is scheduled (in a priority queue).
 	 *
-	 * \return true if this action is still enable.
+	 * \return true if this action is scheduled.
 	 */
 	bool isEnable() const;
 
-	/*!
-	 * Disables this PriorityTranstionAction.
-	 */
-	void disable();
-
 //	/*!
 //	 * Lower operator.
 //	 *
@@ -126,7 +130,9 @@ private:
 	Transition* m_linkedTransition;
 	short m_type;
 	ExtendedInt m_date;
-	bool m_isEnable;
+	int m_heapIndex; // position in the PriorityTransitionActionHeap (-1 if the action is not scheduled).
+
+	friend class PriorityTransitionActionHeap;
 };
 
 #endif /*PRIORITYTRANSITIONACTION_HPP_*/
@@ -0,0 +1,183 @@
+/*
+Copyright: LaBRI (http://www.labri.fr)
+
+Author(s): Score contributors
+Last modification: 17/10/2026
+
+Adviser(s): Myriam Desainte-Catherine (myriam.desainte-catherine@labri.fr)
+
+This software is a computer program whose purpose is to propose
+a library for interactive scores edition and execution.
+
+This software is governed by the CeCILL-C license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL-C
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+/*!
+ * \file PriorityTransitionActionHeap.cpp
+ * \author Score contributors
+ * \date 2026
+ */
+
+#include "PriorityTransitionActionHeap.hpp"
+
+// number of children of each node : a wider heap is shallower and its nodes stay in fewer cache lines
+#define HEAP_ARITY 4
+
+PriorityTransitionActionHeap::PriorityTransitionActionHeap()
+{
+}
+
+PriorityTransitionActionHeap::~PriorityTransitionActionHeap()
+{
+	clear();
+}
+
+void PriorityTransitionActionHeap::push(PriorityTransitionAction* action)
+{
+	if (action->m_heapIndex < 0) {
+		m_actions.push_back(action);
+		action->m_heapIndex = m_actions.size() - 1;
+		siftUp(action->m_heapIndex);
+	} else {
+		// the date could have been moved in both directions
+		unsigned int index = action->m_heapIndex;
+
+		siftUp(index);
+
+		if ((unsigned int) action->m_heapIndex == index) {
+			siftDown(index);
+		}
+	}
+}
+
+void PriorityTransitionActionHeap::remove(PriorityTransitionAction* action)
+{
+	if (action->m_heapIndex < 0) {
+		return;
+	}
+
+	unsigned int index = action->m_heapIndex;
+	PriorityTransitionAction* last = m_actions.back();
+
+	m_actions.pop_back();
+	action->m_heapIndex = -1;
+
+	// put the last action in the hole and move it where it belongs
+	if (last != action) {
+		place(index, last);
+		siftUp(index);
+
+		if ((unsigned int) last->m_heapIndex == index) {
+			siftDown(index);
+		}
+	}
+}
+
+PriorityTransitionAction* PriorityTransitionActionHeap::top() const
+{
+	return m_actions.front();
+}
+
+void PriorityTransitionActionHeap::pop()
+{
+	remove(m_actions.front());
+}
+
+void PriorityTransitionActionHeap::clear()
+{
+	for (unsigned int i = 0; i < m_actions.size(); ++i) {
+		m_actions[i]->m_heapIndex = -1;
+	}
+
+	m_actions.clear();
+}
+
+bool PriorityTransitionActionHeap::empty() const
+{
+	return m_actions.empty();
+}
+
+unsigned int PriorityTransitionActionHeap::size() const
+{
+	return m_actions.size();
+}
+
+void PriorityTransitionActionHeap::siftUp(unsigned int index)
+{
+	PriorityTransitionAction* action = m_actions[index];
+
+	while (index > 0) {
+		unsigned int parent = (index - 1) / HEAP_ARITY;
+
+		if (!(action->getDate() < m_actions[parent]->getDate())) {
+			break;
+		}
+
+		place(index, m_actions[parent]);
+		index = parent;
+	}
+
+	place(index, action);
+}
+
+void PriorityTransitionActionHeap::siftDown(unsigned int index)
+{
+	PriorityTransitionAction* action = m_actions[index];
+	unsigned int size = m_actions.size();
+
+	while (true) {
+		unsigned int firstChild = index * HEAP_ARITY + 1;
+
+		if (firstChild >= size) {
+			break;
+		}
+
+		unsigned int lastChild = (firstChild + HEAP_ARITY < size) ? firstChild + HEAP_ARITY : size;
+		unsigned int minChild = firstChild;
+
+		for (unsigned int child = firstChild + 1; child < lastChild; ++child) {
+			if (m_actions[child]->getDate() < m_actions[minChild]->getDate()) {
+				minChild = child;
+			}
+		}
+
+		if (!(m_actions[minChild]->getDate() < action->getDate())) {
+			break;
+		}
+
+		place(index, m_actions[minChild]);
+		index = minChild;
+	}
+
+	place(index, action);
+}
+
+void PriorityTransitionActionHeap::place(unsigned int index, PriorityTransitionAction* action)
+{
+	m_actions[index] = action;
+	action->m_heapIndex = index;
+}
@@ -0,0 +1,152 @@
+/*
+Copyright: LaBRI (http://www.labri.fr)
+
+Author(s): Score contributors
+Last modification: 17/10/2026
+
+Adviser(s): Myriam Desainte-Catherine (myriam.desainte-catherine@labri.fr)
+
+This software is a computer program whose purpose is to propose
+a library for interactive scores edition and execution.
+
+This software is governed by the CeCILL-C license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL-C
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef PRIORITYTRANSITIONACTIONHEAP_HPP_
+#define PRIORITYTRANSITIONACTIONHEAP_HPP_
+
+/*!
+ * \file PriorityTransitionActionHeap.hpp
+ * \author Score contributors
+ * \date 2026
+ */
+
+#include "PriorityTransitionAction.hpp"
+
+#include <vector>
+
+/*!
+ * \class PriorityTransitionActionHeap
+ *
+ * Priority queue of PriorityTransitionAction ordered by date (the closest first).
+ *
+ * It is an indexed 4-ary heap : each action knows its position in the heap,
+ * so an action can be removed or moved after a date change in O(log n)
+ * without leaving a disabled action in the queue. An action can only be
+ * once in the queue, so the size of the queue is bounded by the number of
+ * actions (two by transition).
+ */
+class PriorityTransitionActionHeap
+{
+public:
+	/*!
+	 * Constructor
+	 */
+	PriorityTransitionActionHeap();
+
+	/*!
+	 * Destructor
+	 */
+	~PriorityTransitionActionHeap();
+
+	/*!
+	 * Adds an action in the queue, or moves it if it is already in the queue
+	 * (after a date change).
+	 *
+	 * \param action : the action to schedule.
+	 */
+	void push(PriorityTransitionAction* action);
+
+	/*!
+	 * Removes an action from the queue (nothing happens if it is not in the queue).
+	 *
+	 * \param action : the action to cancel.
+	 */
+	void remove(PriorityTransitionAction* action);
+
+	/*!
+	 * Gets the closest action in time.
+	 *
+	 * The queue must not be empty.
+	 *
+	 * \return the top action.
+	 */
+	PriorityTransitionAction* top() const;
+
+	/*!
+	 * Removes the closest action in time.
+	 *
+	 * The queue must not be empty.
+	 */
+	void pop();
+
+	/*!
+	 * Removes all the actions.
+	 */
+	void clear();
+
+	/*!
+	 * Tests if the queue is empty.
+	 *
+	 * \return true if there is no action in the queue.
+	 */
+	bool empty() const;
+
+	/*!
+	 * Gets the number of actions in the queue.
+	 *
+	 * \return the number of actions.
+	 */
+	unsigned int size() const;
+
+private:
+	/*!
+	 * Moves the action at an index up until its parent is before it.
+	 *
+	 * \param index : the index of the action.
+	 */
+	void siftUp(unsigned int index);
+
+	/*!
+	 * Moves the action at an index down until its children are after it.
+	 *
+	 * \param index : the index of the action.
+	 */
+	void siftDown(unsigned int index);
+
+	/*!
+	 * Puts an action at an index and updates its position.
+	 *
+	 * \param index : the index.
+	 * \param action : the action.
+	 */
+	void place(unsigned int index, PriorityTransitionAction* action);
+
+	std::vector<PriorityTransitionAction*> m_actions; // the heap.
+};
+
+#endif /*PRIORITYTRANSITIONACTIONHEAP_HPP_*/
@@ -0,0 +1,321 @@
+/*
+Copyright: LaBRI (http://www.labri.fr)
+
+Author(s): Score contributors
+Last modification: 17/10/2026
+
+Adviser(s): Myriam Desainte-Catherine (myriam.desainte-catherine@labri.fr)
+
+This software is a computer program whose purpose is to propose
+a library for interactive scores edition and execution.
+
+This software is governed by the CeCILL-C license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL-C
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL-C license and that you accept its terms.
+*/
+/*!
+ * \file StepThreadPool.cpp
+ * \author Score contributors
+ * \date 2026
+ */
+
+#include "StepThreadPool.hpp"
+#include "PetriNet.hpp"
+
+#include <sched.h>
+#include <unistd.h>
+
+void* stepThreadPoolMain(void* arg)
+{
+	StepThreadPool* pool = (StepThreadPool*) arg;
+	unsigned int queue = __sync_fetch_and_add(&pool->m_nbOfStartedThreads, 1);
+
+	pthread_setspecific(pool->m_queueKey, (void*) (size_t) (queue + 1));
+
+	while (!pool->m_mustStop) {
+		PetriNetStep* step = pool->pop(queue);
+
+		if (step == NULL) {
+			step = pool->steal(queue);
+		}
+
+		if (step != NULL) {
+			pool->run(step);
+			continue;
+		}
+
+		// sleep until a step is pushed
+		pthread_mutex_lock(&pool->m_sleepMutex);
+
+		while (pool->m_nbOfQueuedSteps == 0 && !pool->m_mustStop) {
+			pthread_cond_wait(&pool->m_sleepCondition, &pool->m_sleepMutex);
+		}
+
+		pthread_mutex_unlock(&pool->m_sleepMutex);
+	}
+
+	return NULL;
+}
+
+StepThreadPool* StepThreadPool::getInstance()
+{
+	long nbOfProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+
+	static StepThreadPool pool(nbOfProcessors > 1 ? nbOfProcessors - 1 : 0);
+
+	return &pool;
+}
+
+StepThreadPool::StepThreadPool(unsigned int nbOfThreads)
+{
+	m_nbOfQueuedSteps = 0;
+	m_nbOfStartedThreads = 0;
+	m_mustStop = false;
+
+	pthread_key_create(&m_queueKey, NULL);
+	pthread_mutex_init(&m_sleepMutex, NULL);
+	pthread_cond_init(&m_sleepCondition, NULL);
+	pthread_mutex_init(&m_doneMutex, NULL);
+	pthread_cond_init(&m_doneCondition, NULL);
+
+	for (unsigned int i = 0 ; i <= nbOfThreads ; ++i) {
+		Queue* queue = new Queue();
+		pthread_mutex_init(&queue->mutex, NULL);
+		m_queues.push_back(queue);
+	}
+
+	// the threads don't inherit the scheduling of the thread which builds the pool (it could be
+	// the clock thread with a SCHED_FIFO priority on one cpu) : they run with the default policy on all the cpus
+	pthread_attr_t attributes;
+	struct sched_param param;
+
+	pthread_attr_init(&attributes);
+	pthread_attr_setinheritsched(&attributes, PTHREAD_EXPLICIT_SCHED);
+	pthread_attr_setschedpolicy(&attributes, SCHED_OTHER);
+
+	param.sched_priority = 0;
+	pthread_attr_setschedparam(&attributes, &param);
+
+#ifdef __linux__
+	cpu_set_t cpuSet;
+	long nbOfProcessors = sysconf(_SC_NPROCESSORS_CONF);
+
+	CPU_ZERO(&cpuSet);
+
+	for (long i = 0 ; i < nbOfProcessors && i < CPU_SETSIZE ; ++i) {
+		CPU_SET(i, &cpuSet);
+	}
+
+	pthread_attr_setaffinity_np(&attributes, sizeof(cpu_set_t), &cpuSet);
+#endif
+
+	m_threads.resize(nbOfThreads);
+
+	unsigned int nbOfCreatedThreads = 0;
+
+	for (unsigned int i = 0 ; i < nbOfThreads ; ++i) {
+		if (pthread_create(&m_threads[nbOfCreatedThreads], &attributes, stepThreadPoolMain, this) == 0) {
+			++nbOfCreatedThreads;
+		}
+	}
+
+	// the steps are made by less threads if some of them can't be created
+	m_threads.resize(nbOfCreatedThreads);
+
+	pthread_attr_destroy(&attributes);
+}
+
+StepThreadPool::~StepThreadPool()
+{
+	pthread_mutex_lock(&m_sleepMutex);
+	m_mustStop = true;
+	pthread_cond_broadcast(&m_sleepCondition);
+	pthread_mutex_unlock(&m_sleepMutex);
+
+	for (unsigned int i = 0 ; i < m_threads.size() ; ++i) {
+		pthread_join(m_threads[i], NULL);
+	}
+
+	for (unsigned int i = 0 ; i < m_queues.size() ; ++i) {
+		pthread_mutex_destroy(&m_queues[i]->mutex);
+		delete m_queues[i];
+	}
+
+	pthread_cond_destroy(&m_doneCondition);
+	pthread_mutex_destroy(&m_doneMutex);
+	pthread_cond_destroy(&m_sleepCondition);
+	pthread_mutex_destroy(&m_sleepMutex);
+	pthread_key_delete(m_queueKey);
+}
+
+void StepThreadPool::stepPetriNets(std::vector<PetriNetStep>& steps)
+{
+	// a single step (or a pool without thread) is made by the asking thread : no queue, no lock and no wake up
+	if (steps.size() == 1 || m_threads.empty()) {
+		for (unsigned int i = 0 ; i < steps.size() ; ++i) {
+			make(&steps[i]);
+		}
+
+		return;
+	}
+
+	volatile unsigned int nbOfPendingSteps = steps.size();
+	unsigned int queue = getCurrentQueue();
+
+	for (unsigned int i = 0 ; i < steps.size() ; ++i) {
+		steps[i].nbOfPendingSteps = &nbOfPendingSteps;
+
+		push(queue, &steps[i]);
+	}
+
+	// help the pool before waiting : the steps of this call could be behind the steps of another one
+	while (nbOfPendingSteps > 0) {
+		PetriNetStep* step = pop(queue);
+
+		if (step == NULL) {
+			step = steal(queue);
+		}
+
+		if (step != NULL) {
+			run(step);
+			continue;
+		}
+
+		// the last steps of this call are made by the threads of the pool : wait for them
+		pthread_mutex_lock(&m_doneMutex);
+
+		while (nbOfPendingSteps > 0) {
+			pthread_cond_wait(&m_doneCondition, &m_doneMutex);
+		}
+
+		pthread_mutex_unlock(&m_doneMutex);
+	}
+}
+
+unsigned int StepThreadPool::getNbOfThreads()
+{
+	return m_threads.size();
+}
+
+unsigned int StepThreadPool::getCurrentQueue()
+{
+	size_t queue = (size_t) pthread_getspecific(m_queueKey);
+
+	// the threads out of the pool share the last queue
+	if (queue == 0) {
+		return m_queues.size() - 1;
+	}
+
+	return queue - 1;
+}
+
+void StepThreadPool::push(unsigned int queue, PetriNetStep* step)
+{
+	pthread_mutex_lock(&m_queues[queue]->mutex);
+	m_queues[queue]->steps.push_back(step);
+	pthread_mutex_unlock(&m_queues[queue]->mutex);
+
+	__sync_fetch_and_add(&m_nbOfQueuedSteps, 1);
+
+	// the broadcast is done with the lock so an idle thread can't miss it between its test and its wait
+	if (!m_threads.empty()) {
+		pthread_mutex_lock(&m_sleepMutex);
+		pthread_cond_broadcast(&m_sleepCondition);
+		pthread_mutex_unlock(&m_sleepMutex);
+	}
+}
+
+PetriNetStep* StepThreadPool::pop(unsigned int queue)
+{
+	PetriNetStep* step = NULL;
+
+	pthread_mutex_lock(&m_queues[queue]->mutex);
+
+	if (!m_queues[queue]->steps.empty()) {
+		step = m_queues[queue]->steps.back();
+		m_queues[queue]->steps.pop_back();
+	}
+
+	pthread_mutex_unlock(&m_queues[queue]->mutex);
+
+	if (step != NULL) {
+		__sync_fetch_and_sub(&m_nbOfQueuedSteps, 1);
+	}
+
+	return step;
+}
+
+PetriNetStep* StepThreadPool::steal(unsigned int queue)
+{
+	PetriNetStep* step = NULL;
+
+	if (m_nbOfQueuedSteps == 0) {
+		return NULL;
+	}
+
+	for (unsigned int i = 1 ; step == NULL && i < m_queues.size() ; ++i) {
+		Queue* victim = m_queues[(queue + i) % m_queues.size()];
+
+		pthread_mutex_lock(&victim->mutex);
+
+		if (!victim->steps.empty()) {
+			step = victim->steps.front();
+			victim->steps.pop_front();
+		}
+
+		pthread_mutex_unlock(&victim->mutex);
+	}
+
+	if (step != NULL) {
+		__sync_fetch_and_sub(&m_nbOfQueuedSteps, 1);
+	}
+
+	return step;
+}
+
+void StepThreadPool::make(PetriNetStep* step)
+{
+	step->result = false;
+	step->hasThrown = false;
+
+	// an exception can't leave a thread of the pool : it is thrown again by the PetriNet which asked for the step
+	try {
+		step->result = step->petriNet->makeOneStep(step->currentTime);
+	} catch (...) {
+		step->hasThrown = true;
+	}
+}
+
+void StepThreadPool::run(PetriNetStep* step)
+{
+	make(step);
+
+	// the step can't be used after the decrement : the thread which asked for it could have returned
+	if (__sync_sub_and_fetch(step->nbOfPendingSteps, 1) == 0) {
+		pthread_mutex_lock(&m_doneMutex);
+		pthread_cond_broadcast(&m_doneCondition);
+		pthread_mutex_unlock(&m_doneMutex);
+	}
+}
@@ -0,0 +1,152 @@
+/*
+Copyright: LaBRI (http://www.labri.fr)
+
+Author(s): Score contributors
+Last modification: 17/10/2026
+
+Adviser(s): Myriam Desainte-Catherine (myriam.desainte-catherine@labri.fr)
+
+This software is a computer program whose purpose is to propose
+a library for interactive scores edition and execution.
+
+This software is governed by the CeCILL-C license under French law and
+abiding by the rules of distribution of free software.  You can  use, 
+modify and/ or redistribute the software under the terms of the CeCILL-C
+license as circulated by CEA, CNRS and INRIA at the following URL
+"http://www.cecill.info". 
+
+As a counterpart to the access to the source code and  rights to copy,
+modify and redistribute granted by the license, users are provided only
+with a limited warranty  and the software's author,  the holder of the
+economic rights,  and the successive licensors  have only  limited
+liability. 
+
+In this respect, the user's attention is drawn to the risks associated
+with loading,  using,  modifying and/or developing or reproducing the
+software by the user in light of its specific status of free software,
+that may mean  that it is complicated to manipulate,  and  that  also
+therefore means  that it is reserved for developers  and  experienced
+professionals having in-depth computer knowledge. Users are therefore
+encouraged to load and test the software's suitability as regards their
+requirements in conditions enabling the security of their systems and/or 
+data to be ensured and,  more generally, to use and operate it in the 
+same conditions as regards security.
+
+The fact that you are presently reading this means that you have had
+knowledge of the CeCILL-C license and that you accept its terms.
+*/
+#ifndef STEPTHREADPOOL_HPP_
+#define STEPTHREADPOOL_HPP_
+
+/*!
+ * \file StepThreadPool.hpp
+ * \author Score contributors
+ * \date 2026
+ */
+
+#include <deque>
+#include <vector>
+#include <pthread.h>
+
+class PetriNet;
+
+/*!
+ * \struct PetriNetStep
+ *
+ * A step to make on a PetriNet by a StepThreadPool.
+ */
+struct PetriNetStep
+{
+	PetriNet* petriNet; // the PetriNet to step.
+	unsigned int currentTime; // the time given to makeOneStep.
+	bool result; // what makeOneStep returned.
+	bool hasThrown; // true if makeOneStep threw an exception.
+	volatile unsigned int* nbOfPendingSteps; // steps of the same call not done yet (set by the pool).
+};
+
+/*!
+ * \class StepThreadPool
+ *
+ * Pool of threads to step independent PetriNets concurrently.
+ *
+ * Each thread has its own queue of steps : it takes the last step it pushed
+ * and when its queue is empty it steals the oldest step of another queue.
+ * The thread which asks for the steps helps the pool until they are all taken,
+ * then it sleeps until the last one is done, so a PetriNet stepped by the pool
+ * can step its own children the same way. A single step is made by the asking
+ * thread without going through the queues.
+ *
+ * The threads of the pool run with the default scheduling policy on all the
+ * cpus whatever the thread which builds the pool.
+ */
+class StepThreadPool
+{
+public:
+	/*!
+	 * Gets the pool shared by all the PetriNets
+	 * (one thread per processor, the asking thread being one of them).
+	 *
+	 * \return the shared pool.
+	 */
+	static StepThreadPool* getInstance();
+
+	/*!
+	 * Constructor
+	 *
+	 * \param nbOfThreads : number of threads to create
+	 * (0 to make all the steps with the asking thread).
+	 */
+	StepThreadPool(unsigned int nbOfThreads);
+
+	/*!
+	 * Destructor
+	 *
+	 * Waits the end of the threads.
+	 */
+	~StepThreadPool();
+
+	/*!
+	 * Makes one step on each PetriNet and returns when all of them are done.
+	 * The PetriNets must be independent : they are stepped in any order and concurrently.
+	 *
+	 * \param steps : the steps to make (their results are filled).
+	 */
+	void stepPetriNets(std::vector<PetriNetStep>& steps);
+
+	/*!
+	 * Gets the number of threads of the pool.
+	 *
+	 * \return the number of threads (without the asking thread).
+	 */
+	unsigned int getNbOfThreads();
+
+private:
+	struct Queue {
+		pthread_mutex_t mutex;
+		std::deque<PetriNetStep*> steps;
+	};
+
+	std::vector<pthread_t> m_threads;
+	std::vector<Queue*> m_queues; // a queue for each thread, the last one is for the threads out of the pool.
+
+	pthread_key_t m_queueKey; // index + 1 of the queue of the current thread (0 for the threads out of the pool).
+
+	pthread_mutex_t m_sleepMutex;
+	pthread_cond_t m_sleepCondition; // the idle threads wait on it until a step is pushed.
+	pthread_mutex_t m_doneMutex;
+	pthread_cond_t m_doneCondition; // the asking threads wait on it until their last step is done.
+	volatile unsigned int m_nbOfQueuedSteps;
+	volatile unsigned int m_nbOfStartedThreads; // to give its queue to each thread.
+	volatile bool m_mustStop;
+
+	unsigned int getCurrentQueue();
+	void push(unsigned int queue, PetriNetStep* step);
+	PetriNetStep* pop(unsigned int queue);
+	PetriNetStep* steal(unsigned int queue);
+	void make(PetriNetStep* step);
+	void run(PetriNetStep* step);
+
+	friend void* stepThreadPoolMain(void* arg);
+};
+
+#endif /*STEPTHREADPOOL_HPP_*/
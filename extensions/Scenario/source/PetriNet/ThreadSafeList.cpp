@@ -79,3 +79,11 @@ void ThreadSafeList::clear()
 	pthread_mutex_unlock(m_mutex);
 }
 
+unsigned int ThreadSafeList::size()
+{
+	pthread_mutex_lock(m_mutex);
+	unsigned int listSize = m_list.size();
+	pthread_mutex_unlock(m_mutex);
+
+	return listSize;
+}
@@ -58,6 +58,7 @@ public:
 	std::list<void*> getList();
 	void push_back(void* elementToAdd);
 	void clear();
+	unsigned int size();
 
 private:
 	std::list<void*> m_list;
@@ -53,9 +53,24 @@ using namespace std;
 
 Transition::Transition(PetriNet* petriNet)
 :PetriNetNode(petriNet), m_activeArcsBitArray(NULL), m_startDate(MINUS_INFINITY),
-m_endDate(PLUS_INFINITY), m_startAction(NULL), m_endAction(NULL) // TODO : initialisation to NULL is implicit
+m_endDate(PLUS_INFINITY)
 {
+	// the actions are scheduled again each time the dates change, they are never created during the execution
+	m_startAction = petriNet->createPriorityTransitionAction(this, START, m_startDate);
+	m_endAction = petriNet->createPriorityTransitionAction(this, END, m_endDate);
+
 	m_events.push_back(STATIC_EVENT);
+	m_planIndex = 0;
+
+	m_isSensitized = false;
+	m_previousSensitized = NULL;
+	m_nextSensitized = NULL;
+	m_mustBeChecked = false;
+	m_nbOfDeactivations = 0;
+
+	m_previousOfEvent = NULL;
+	m_nextOfEvent = NULL;
+
 	m_mustWaitThePetriNetToEnd = false;
 	m_petriNetToEnd = NULL;
 }
@@ -72,8 +87,12 @@ bool Transition::isStatic()
 // cf triggerpoint : register an unique pointer as event for this transition
 void Transition::setEvent(void* event)
 {
+	getPetriNet()->unindexEvent(this);
+
 	m_events.clear();
 	m_events.push_back(event);
+
+	getPetriNet()->indexEvent(this);
 }
 
 void Transition::createBitArray() // TODO : Should be called in addInGoingArcs
@@ -83,7 +102,7 @@ void Transition::createBitArray() // TODO : Should be called in addInGoingArcs
 		m_activeArcsBitArray = NULL;
 	}
 
-	arcList inGoingArcs = inGoingArcsOf();
+	ArcRange inGoingArcs = inGoingArcsOf();
 
 	if (inGoingArcs.size() != 0) {
 		m_activeArcsBitArray = new TransitionBitArray(inGoingArcs.size());
@@ -93,30 +112,37 @@ void Transition::createBitArray() // TODO : Should be called in addInGoingArcs
 	}
 }
 
-void Transition::resetBitArray()
+void Transition::addArcToBitArray(Arc* arcToAdd)
 {
-	for (unsigned int i = 0 ; i < m_activeArcsBitArray->getSize() ; ++i) {
-		m_activeArcsBitArray->setToZero(i); // CB TODO : eraseArray() do that
-	}
+	ArcRange inGoingArcs = inGoingArcsOf();
 
-	if (m_startAction != NULL) {
-		m_startAction->disable();
-		m_startAction = NULL;
+	// don't number all the arcs again : the end transition of a scenario can have many of them
+	if (m_activeArcsBitArray != NULL && inGoingArcs.size() == m_activeArcsBitArray->getSize() + 1 && inGoingArcs[inGoingArcs.size() - 1] == arcToAdd) {
+		m_activeArcsBitArray->pushBack();
+		arcToAdd->setNumber(inGoingArcs.size() - 1);
+	}
+	else {
+		createBitArray();
 	}
+}
 
-	m_startDate = MINUS_INFINITY;
+void Transition::resetBitArray()
+{
+	m_activeArcsBitArray->eraseArray();
 
-	if (m_endAction != NULL) {
-		m_endAction->disable();
-		m_endAction = NULL;
-	}
+	// a sensitized transition which is not active anymore has to be checked
+	getPetriNet()->checkTransition(this);
+
+	getPetriNet()->removeActionFromPriorityQueue(m_startAction);
+	m_startDate = MINUS_INFINITY;
 
+	getPetriNet()->removeActionFromPriorityQueue(m_endAction);
 	m_endDate = PLUS_INFINITY;
 }
 
 void Transition::resetIncomingArcsState()
 {
-	arcList inGoingArcs = inGoingArcsOf();
+	ArcRange inGoingArcs = inGoingArcsOf();
 
 	for (unsigned int i = 0; i < inGoingArcs.size(); ++i) {
 		if(inGoingArcs[i]->isActive()) {
@@ -131,8 +157,12 @@ void Transition::merge(Transition* transitionToMerge) // CB Attention, copie de
 		m_externActions.push_back(transitionToMerge->m_externActions[i]);
 	}
 
-	arcList mergeInGoingArcs = transitionToMerge->inGoingArcsOf();
-	arcList mergeOutGoingArcs = transitionToMerge->outGoingArcsOf();
+	// copy the arcs because they are deleted while going through them
+	ArcRange mergeInGoingRange = transitionToMerge->inGoingArcsOf();
+	ArcRange mergeOutGoingRange = transitionToMerge->outGoingArcsOf();
+
+	arcList mergeInGoingArcs(mergeInGoingRange.begin(), mergeInGoingRange.end());
+	arcList mergeOutGoingArcs(mergeOutGoingRange.begin(), mergeOutGoingRange.end());
 
 	for (unsigned int i = 0; i < mergeInGoingArcs.size() ; ++i) {
 		Arc* currentArc = mergeInGoingArcs[i];
@@ -165,7 +195,7 @@ void Transition::merge(Transition* transitionToMerge) // CB Attention, copie de
 
 void Transition::addExternAction(void(*pt2Func)(void*, bool), void* argPt2Func)
 {
-	m_externActions.push_back(new TransitionAction(pt2Func, argPt2Func));
+	m_externActions.push_back(getPetriNet()->createTransitionAction(pt2Func, argPt2Func));
 //	m_externAction = pt2Func;
 //	m_externActionArgument = argPt2Func;
 }
@@ -210,17 +240,13 @@ void Transition::setArcAsActive(Arc* arc, unsigned int timeOffset, bool recalcul
 	if (endDate < m_endDate) {
 		m_endDate = endDate;
 
-		if (m_endAction != NULL) {
-			m_endAction->disable();
-		}
-
-		m_endAction = new PriorityTransitionAction(this, END, m_endDate);
+		m_endAction->setDate(m_endDate);
 
 		getPetriNet()->addActionToPriorityQueue(m_endAction);
 	}
 
 	if (areAllInGoingArcsActive()) {
-		m_startAction = new PriorityTransitionAction(this, START, m_startDate);
+		m_startAction->setDate(m_startDate);
 		getPetriNet()->addActionToPriorityQueue(m_startAction);
 	}
 }
@@ -228,11 +254,11 @@ void Transition::setArcAsActive(Arc* arc, unsigned int timeOffset, bool recalcul
 void Transition::setArcAsInactive(Arc* arc)
 {
 	if (areAllInGoingArcsActive()) {
-		m_startAction->disable();
+		getPetriNet()->removeActionFromPriorityQueue(m_startAction);
 	}
 	setArcAsInactiveByNumber(arc->getNumber());
 
-
+	getPetriNet()->checkTransition(this);
 }
 
 bool Transition::areAllInGoingArcsActive()
@@ -294,8 +320,7 @@ void Transition::crossTransition(bool mustChangeTokenValue, int newTokenValue)
 		throw IncoherentStateException();
 	}
 
-	arcList inGoingArc = inGoingArcsOf();
-	arcList outGoingArc = outGoingArcsOf();
+	ArcRange inGoingArc = inGoingArcsOf();
 
 	resetBitArray();
 
@@ -321,13 +346,11 @@ void Transition::crossTransition(bool mustChangeTokenValue, int newTokenValue)
 		} else {
 			Place* place = (Place*) inGoingArc[i]->getFrom();
 
-			petriNetNodeList nodeList = place->returnSuccessors();
+			ArcRange placeOutGoingArcs = place->outGoingArcsOf();
 
-			if (nodeList.size() > 1) {
-				for (unsigned int i = 0 ; i < nodeList.size() ; ++i) {
-					if (nodeList[i] != this) {
-						transitionsToReset.insert((Transition*) nodeList[i]);
-					}
+			for (unsigned int j = 0 ; j < placeOutGoingArcs.size() ; ++j) {
+				if (placeOutGoingArcs[j]->getTo() != this) {
+					transitionsToReset.insert((Transition*) placeOutGoingArcs[j]->getTo());
 				}
 			}
 
@@ -343,7 +366,7 @@ void Transition::crossTransition(bool mustChangeTokenValue, int newTokenValue)
 
 	if (m_externActions.size() > 0) {
 		for (unsigned int i = 0 ; i < m_externActions.size() ; ++i) {
-            m_externActions[i]->m_transitionAction(m_externActions[i]->m_transitionActionArgument, activeToken);
+            getPetriNet()->callAction(m_externActions[i]->m_transitionAction, m_externActions[i]->m_transitionActionArgument, activeToken);
 		}
 	}
 
@@ -353,6 +376,9 @@ void Transition::crossTransition(bool mustChangeTokenValue, int newTokenValue)
         tokenValue = newTokenValue;
     }
 
+	// get the out-going arcs after the extern actions
+	ArcRange outGoingArc = outGoingArcsOf();
+
 	for (unsigned int i = 0 ; i < outGoingArc.size() ; ++i) {
 		outGoingArc[i]->produceTokenInTo(tokenValue);
 	}
@@ -360,7 +386,7 @@ void Transition::crossTransition(bool mustChangeTokenValue, int newTokenValue)
 
 Arc* Transition::hasATokenInPredecessors()
 {
-	arcList list = inGoingArcsOf();
+	ArcRange list = inGoingArcsOf();
 
 		for (unsigned int i = 0; i < list.size(); i++) {
 			if (list[i]->nbOfArcColorLabelTokensInFrom() > 0) {
@@ -375,7 +401,7 @@ void Transition::print() {
 	std::cout << "Transition : " << this << std::endl;
 
 	std::cout << "Outgoings Arcs : " << std::endl;
-	arcList outGoingArcs = outGoingArcsOf();
+	ArcRange outGoingArcs = outGoingArcsOf();
 	for (unsigned int i = 0; i < outGoingArcs.size(); ++i) {
 		std::cout << "To : " << outGoingArcs[i]->getTo() << std::endl;
 		std::cout << "RelMin : " << outGoingArcs[i]->getRelativeMinValue().getValue() << std::endl;
@@ -386,7 +412,7 @@ void Transition::print() {
 	}
 
 	std::cout << "Ingoings Arcs : " << std::endl;
-	arcList inGoingArcs = inGoingArcsOf();
+	ArcRange inGoingArcs = inGoingArcsOf();
 	for (unsigned int i = 0; i < inGoingArcs.size(); ++i) {
 		std::cout << "From : " << inGoingArcs[i]->getFrom() << std::endl;
 		std::cout << "RelMin : " << inGoingArcs[i]->getRelativeMinValue().getValue() << std::endl;
@@ -435,4 +461,7 @@ bool Transition::couldBeSensitize()
 
 Transition::~Transition()
 {
+	if (m_activeArcsBitArray != NULL) {
+		delete m_activeArcsBitArray;
+	}
 }
@@ -68,6 +68,8 @@ class Transition : public PetriNetNode
 {
 public:
 	friend class PetriNet;
+	friend class ExecutionPlan;
+	friend class PetriNetValidator;
 
 	/*!
 	 * Sets the event to cross the transition.
@@ -81,6 +83,14 @@ public:
 	 */
 	void createBitArray();
 
+	/*!
+	 * Updates the BitArray (representing actives arcs) for a new ingoing arc.
+	 * An arc added after the others only adds a bit, otherwise the BitArray is created again.
+	 *
+	 * \param arcToAdd : the new ingoing arc.
+	 */
+	void addArcToBitArray(Arc* arcToAdd);
+
 	/*!
 	 * Resets the BitArray (representing actives arcs).
 	 * All is set to 0.
@@ -261,6 +271,19 @@ private:
 	PetriNet* m_petriNetToEnd;
 	bool m_mustWaitThePetriNetToEnd;
 
+	unsigned int m_planIndex; // index of the transition in its PetriNet, set by the ExecutionPlan and the PetriNetValidator.
+
+	// the PetriNet keeps its sensitized transitions into an intrusive list to add and remove them in O(1)
+	bool m_isSensitized;
+	Transition* m_previousSensitized; // previous transition in the sensitized list of the PetriNet.
+	Transition* m_nextSensitized; // next transition in the sensitized list of the PetriNet.
+	bool m_mustBeChecked; // true if the PetriNet has to check this sensitized transition (its state changed).
+	unsigned int m_nbOfDeactivations; // number of deactivations received and not processed yet.
+
+	// the transitions waiting the same event are linked together (cf PetriNet::indexEvent)
+	Transition* m_previousOfEvent; // previous transition waiting the same event.
+	Transition* m_nextOfEvent; // next transition waiting the same event.
+
 
 };
 
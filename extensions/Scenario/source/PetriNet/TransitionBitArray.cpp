@@ -37,7 +37,6 @@ knowledge of the CeCILL-C license and that you accept its terms.
 */
 
 #include "TransitionBitArray.hpp"
-#include <cmath>
 
 /*!
  * \file BitArray.cpp
@@ -46,21 +45,15 @@ knowledge of the CeCILL-C license and that you accept its terms.
  */
 
 TransitionBitArray::TransitionBitArray(unsigned int size)
-:m_size(size), m_maxIndexInBitArray((size - 1)/INT_SIZE)
+:m_size(size), m_maxIndexInBitArray((size - 1)/INT_SIZE), m_nbOfOnes(0), m_capacity(m_maxIndexInBitArray + 1)
 {
 	if (size == 0) {
 		throw OutOfBoundException();
 	}
 
-	m_bitArray = new uint16_t[m_maxIndexInBitArray + 1];
+	m_bitArray = new uint16_t[m_capacity];
 
-	uint16_t allBitToOne = pow(2, INT_SIZE) - 1;
-
-	for (unsigned int i = 0; i <= m_maxIndexInBitArray; ++i) {
-		m_bitArray[i] = allBitToOne;
-	}
-
-	eraseArray(); // TODO : inutile de mettre tout à un, puis un par un à zéro !!!
+	eraseArray();
 }
 
 void TransitionBitArray::setToOne(unsigned int index)
@@ -74,7 +67,11 @@ void TransitionBitArray::setToOne(unsigned int index)
 
 	uint16_t bitToSetAsOne = 1 << indexInInt;
 
-	m_bitArray[indexInBitArray] = m_bitArray[indexInBitArray] | bitToSetAsOne;
+	// count the bit only if it changes, so isAllOne doesn't have to scan the array
+	if (!(m_bitArray[indexInBitArray] & bitToSetAsOne)) {
+		m_bitArray[indexInBitArray] = m_bitArray[indexInBitArray] | bitToSetAsOne;
+		++m_nbOfOnes;
+	}
 }
 
 void TransitionBitArray::setToZero(unsigned int index)
@@ -87,29 +84,63 @@ void TransitionBitArray::setToZero(unsigned int index)
 	unsigned int indexInInt = index % INT_SIZE;
 
 	uint16_t bitToSetAsZero = 1 << indexInInt;
-	bitToSetAsZero = ~bitToSetAsZero;
 
-	m_bitArray[indexInBitArray] = m_bitArray[indexInBitArray] & bitToSetAsZero;
+	if (m_bitArray[indexInBitArray] & bitToSetAsZero) {
+		m_bitArray[indexInBitArray] = m_bitArray[indexInBitArray] & ~bitToSetAsZero;
+		--m_nbOfOnes;
+	}
+}
+
+bool TransitionBitArray::isOne(unsigned int index)
+{
+	if (index >= getSize()) {
+		throw OutOfBoundException();
+	}
+
+	unsigned int indexInBitArray = index / INT_SIZE;
+	unsigned int indexInInt = index % INT_SIZE;
+
+	return (m_bitArray[indexInBitArray] >> indexInInt) & 1;
 }
 
 void TransitionBitArray::eraseArray()
 {
-	for (unsigned int i = 0; i < getSize() ; ++i) {
-		setToZero(i); // TODO : inefficace d'utiliser setToZero qui ne met qu'un bit à 0 si c'est pour tout mettre à 0 ...
+	for (unsigned int i = 0; i <= m_maxIndexInBitArray; ++i) {
+		m_bitArray[i] = 0;
 	}
+
+	m_nbOfOnes = 0;
 }
 
 bool TransitionBitArray::isAllOne()
 {
-	uint16_t allBitToOne = pow(2, INT_SIZE) - 1;
+	return m_nbOfOnes == m_size;
+}
 
-	for (unsigned int i = 0; i <= m_maxIndexInBitArray; ++i) {
-		if (m_bitArray[i] != allBitToOne) {
-			return false;
+void TransitionBitArray::pushBack()
+{
+	unsigned int indexInBitArray = m_size / INT_SIZE;
+	unsigned int indexInInt = m_size % INT_SIZE;
+
+	if (indexInBitArray >= m_capacity) {
+		uint16_t* bitArray = new uint16_t[2 * m_capacity];
+
+		for (unsigned int i = 0; i < m_capacity; ++i) {
+			bitArray[i] = m_bitArray[i];
 		}
+
+		delete[] m_bitArray;
+		m_bitArray = bitArray;
+		m_capacity = 2 * m_capacity;
+	}
+
+	// the ints after the last one are not erased by eraseArray
+	if (indexInInt == 0) {
+		m_bitArray[indexInBitArray] = 0;
 	}
 
-	return true;
+	++m_size;
+	m_maxIndexInBitArray = indexInBitArray;
 }
 
 unsigned int TransitionBitArray::getSize()
@@ -53,7 +53,8 @@ knowledge of the CeCILL-C license and that you accept its terms.
 /*!
  * \class BitArray
  *
- * This array permits to quickly know if every bits is 1.
+ * This array permits to quickly know if every bits is 1 :
+ * the number of bits set to 1 is kept up to date so the test is O(1).
  */
 class TransitionBitArray
 {
@@ -92,18 +93,35 @@ public:
 	 */
 	void setToZero(unsigned int index);
 
+	/*!
+	 * Tests the bit at given index.
+	 *
+	 * Throws OutOfBoundException if index is greater or equal the bitArray size.
+	 *
+	 * \param index : index of the bit to test.
+	 * \return true if the bit is 1.
+	 */
+	bool isOne(unsigned int index);
+
 	/*!
 	 * Sets all bits to 0.
 	 */
 	void eraseArray();
 
 	/*!
-	 * Tests if all bits are 1.
+	 * Tests if all bits are 1 (O(1)).
 	 *
 	 * \return true if all bits are 1.
 	 */
 	bool isAllOne();
 
+	/*!
+	 * Adds a bit set to 0 at the end of the BitArray.
+	 *
+	 * The array grows geometrically so adding n bits one by one is O(n).
+	 */
+	void pushBack();
+
 	/*!
 	 * Gets the BitArray size.
 	 *
@@ -114,6 +132,8 @@ public:
 private :
 	unsigned int m_size; // BitArray size.
 	unsigned int m_maxIndexInBitArray; // Max index of the BitArray.
+	unsigned int m_nbOfOnes; // Number of bits set to 1.
+	unsigned int m_capacity; // Number of allocated ints.
 	uint16_t* m_bitArray; // BitArray. // TODO : uint16_t not portable because optionnal, see uint_least16_t maybe
 };
 
@@ -14,6 +14,7 @@
  */
 
 #include "Scenario.h"
+#include "Scenario.test.h"
 
 #define thisTTClass                 Scenario
 #define thisTTClassName             "Scenario"
@@ -23,6 +24,7 @@ extern "C" TT_EXTENSION_EXPORT TTErr TTLoadJamomaExtension_Scenario(void)
 {
 	TTFoundationInit();
 	Scenario::registerClass();
+	ScenarioTest::registerClass();
 	return kTTErrNone;
 }
 
@@ -33,6 +35,17 @@ mViewPosition(TTValue(0, 0)),
 mEditionSolver(NULL),
 #ifndef NO_EXECUTION_GRAPH
 mExecutionGraph(NULL),
+mRecording(NO),
+mRecordedSize(0),
+mRecordMutex(NULL),
+mRecordValueMutex(NULL),
+mReplaying(NO),
+mReplayPosition(0),
+mGraphChanged(YES),
+mGraphTimeOffset(0),
+mGraphPlanKey(0),
+mParentScenario(NULL),
+mGraphHosted(NO),
 #endif
 mLoading(NO)
 {
@@ -45,6 +58,18 @@ mLoading(NO)
     
 #ifndef NO_EXECUTION_GRAPH
     addMessage(Compile);
+    addMessageWithArguments(Trace);
+    addMessageWithArguments(Record);
+    addMessageWithArguments(Replay);
+    
+    addMessageWithArguments(ConditionValueReceived);
+    addMessageProperty(ConditionValueReceived, hidden, YES);
+    
+    addMessageWithArguments(EventDateChanged);
+    addMessageProperty(EventDateChanged, hidden, YES);
+    
+    addMessageWithArguments(GraphInfo);
+    addMessageProperty(GraphInfo, hidden, YES);
 #endif
     
     // Create the edition solver
@@ -55,6 +80,9 @@ mLoading(NO)
     plusInfinity = ExtendedInt(PLUS_INFINITY, 0);
     minusInfinity = ExtendedInt(MINUS_INFINITY, 0);
     integer0 = ExtendedInt(INTEGER, 0);
+    
+    mRecordMutex = new TTMutex(false);
+    mRecordValueMutex = new TTMutex(false);
 #endif
     
     // it is possible to pass 2 events for the root scenario (which don't need a container by definition)
@@ -72,6 +100,10 @@ mLoading(NO)
 
 Scenario::~Scenario()
 {
+    // delete all time event observers
+    for (mTimeEventList.begin(); mTimeEventList.end(); mTimeEventList.next())
+        deleteTimeEventCacheElement(mTimeEventList.current());
+    
     if (mNamespace) {
         delete mNamespace;
         mNamespace = NULL;
@@ -83,9 +115,18 @@ Scenario::~Scenario()
     }
     
 #ifndef NO_EXECUTION_GRAPH
-    if (mExecutionGraph) {
-        delete mExecutionGraph;
-        mExecutionGraph = NULL;
+    releaseGraph();
+    
+    clearRecord();
+    
+    if (mRecordMutex) {
+        delete mRecordMutex;
+        mRecordMutex = NULL;
+    }
+    
+    if (mRecordValueMutex) {
+        delete mRecordValueMutex;
+        mRecordValueMutex = NULL;
     }
 #endif
     
@@ -117,14 +158,27 @@ TTErr Scenario::Compile()
 {
     TTValue         v;
     TTUInt32        timeOffset;
-    TTBoolean       compiled;
-    TTObjectBasePtr aTimeEvent;
-    TTObjectBasePtr aTimeProcess;
+    
+#ifndef NO_EXECUTION_GRAPH
+    // a sub-scenario is compiled only when the execution graph of its parent reaches it (cf ProcessStart)
+    if (mParentScenario)
+        return kTTErrNone;
+#endif
     
     // get scheduler time offset
     mScheduler->getAttributeValue(kTTSym_offset, v);
     timeOffset = TTFloat64(v[0]);
     
+    return compileScenario(timeOffset);
+}
+
+TTErr Scenario::compileScenario(TTUInt32 timeOffset)
+{
+    TTValue         v;
+    TTBoolean       compiled;
+    TTObjectBasePtr aTimeEvent;
+    TTObjectBasePtr aTimeProcess;
+    
     // set all time events to a waiting status
     for (mTimeEventList.begin(); mTimeEventList.end(); mTimeEventList.next()) {
         
@@ -135,7 +189,8 @@ TTErr Scenario::Compile()
     
 #ifndef NO_EXECUTION_GRAPH
     // compile the mExecutionGraph to prepare scenario execution from the scheduler time offset
-    compileGraph(timeOffset);
+    if (compileGraph(timeOffset))
+        return kTTErrGeneric;
 #endif
     
     // compile all time processes if they need to be compiled
@@ -156,6 +211,32 @@ TTErr Scenario::Compile()
 TTErr Scenario::ProcessStart()
 {
 #ifndef NO_EXECUTION_GRAPH
+    TTValue v;
+    
+    if (mParentScenario) {
+        
+        // the former execution graph could still be stepped by the parent if the sub-scenario didn't end
+        releaseGraph();
+        
+        // compile the sub-scenario now its parent reaches it
+        mScheduler->getAttributeValue(kTTSym_offset, v);
+        
+        if (compileScenario(TTFloat64(v[0])))
+            return kTTErrGeneric;
+        
+        // the execution graph of the parent steps the execution graph of the sub-scenario on the same timeline
+        if (mParentScenario->mExecutionGraph && mParentScenario->mExecutionGraph->isRunning()) {
+            
+            mParentScenario->mExecutionGraph->launchInternPetriNet(mExecutionGraph);
+            mGraphHosted = YES;
+            
+            // the scheduler only gives its speed to the time processes of the sub-scenario
+            mScheduler->setAttributeValue(TTSymbol("wakeUp"), TTFloat64(-1.));
+            
+            return kTTErrNone;
+        }
+    }
+    
     // start the execution graph
     mExecutionGraph->start();
 #else
@@ -179,6 +260,14 @@ TTErr Scenario::ProcessEnd()
         
         aTimeProcess->sendMessage(kTTSym_Stop);
     }
+    
+#ifndef NO_EXECUTION_GRAPH
+    // a sub-scenario keeps no execution graph until its parent reaches it again
+    if (mParentScenario)
+        releaseGraph();
+    else
+        releaseSubScenarios();
+#endif
    
     return kTTErrNone;
 }
@@ -186,6 +275,12 @@ TTErr Scenario::ProcessEnd()
 TTErr Scenario::Process(const TTValue& inputValue, TTValue& outputValue)
 {
     TTFloat64   progression, realTime;
+#ifndef NO_EXECUTION_GRAPH
+    TTValue     v;
+    TTFloat64   duration, offset, scoreTime;
+    TTUInt32    stepTime;
+    TTBoolean   running;
+#endif
     
     if (inputValue.size() == 2) {
         
@@ -195,9 +290,45 @@ TTErr Scenario::Process(const TTValue& inputValue, TTValue& outputValue)
             realTime = inputValue[1];
             
 #ifndef NO_EXECUTION_GRAPH
+            // the execution graph of a hosted sub-scenario is stepped by the execution graph of its parent
+            if (mGraphHosted)
+                return kTTErrNone;
+            
+            // the mExecutionGraph dates are relative to the time offset and they are in score time :
+            // use the position of the scheduler (which follows its speed curve) instead of the real time
+            mScheduler->getAttributeValue(kTTSym_duration, v);
+            duration = v[0];
+            
+            mScheduler->getAttributeValue(kTTSym_offset, v);
+            offset = v[0];
+            
+            scoreTime = progression * duration - offset;
+            
+            // a replayed record makes the steps at the recorded times instead
+            if (mReplaying)
+                return replaySteps(scoreTime, offset);
+            
+            stepTime = scoreTime > 0. ? scoreTime : 0.;
+            
             // update the mExecutionGraph to process the scenario
-            if (mExecutionGraph->makeOneStep(realTime))
+            running = mExecutionGraph->makeOneStep(stepTime);
+            
+            if (mRecording)
+                recordStep(stepTime);
+            
+            if (running) {
+                
+                // ask the scheduler to call back only when the mExecutionGraph needs to be updated again
+                // (-1 means only an interactive event can make it evolve)
+                ExtendedInt nextDate = mExecutionGraph->getNextStepDate();
+                
+                if (nextDate.isInfinity())
+                    mScheduler->setAttributeValue(TTSymbol("wakeUp"), TTFloat64(-1.));
+                else
+                    mScheduler->setAttributeValue(TTSymbol("wakeUp"), TTFloat64(nextDate.getValue() + offset));
+                
                 return kTTErrNone;
+            }
             
             else
                 // Make the end happen
@@ -271,6 +402,10 @@ TTErr Scenario::Goto(const TTValue& inputValue, TTValue& outputValue)
     TTUInt32        duration, timeOffset, date;
     TTBoolean       mute = NO;
     
+    // apply the command at the next tick of the clock service
+    if (!TTTimeClock::isExecutionThread())
+        return TTTimeClock::post(this, kTTSym_Goto, inputValue);
+    
     if (inputValue.size() >= 1) {
         
         if (inputValue[0].type() == kTypeUInt32) {
@@ -366,6 +501,36 @@ TTErr Scenario::Goto(const TTValue& inputValue, TTValue& outputValue)
     return kTTErrGeneric;
 }
 
+#ifndef NO_EXECUTION_GRAPH
+TTErr Scenario::Trace(const TTValue& inputValue, TTValue& outputValue)
+{
+    TTSymbol path;
+    
+    // stop the trace
+    if (inputValue.size() == 0) {
+        
+        ExecutionTrace::stop();
+        return kTTErrNone;
+    }
+    
+    // start the trace into a file
+    if (inputValue.size() == 1) {
+        
+        if (inputValue[0].type() == kTypeSymbol) {
+            
+            path = inputValue[0];
+            
+            if (ExecutionTrace::start(path.c_str()))
+                return kTTErrNone;
+            
+            TTLogError("Scenario::Trace : can't trace into %s\n", path.c_str());
+        }
+    }
+    
+    return kTTErrGeneric;
+}
+#endif
+
 TTErr Scenario::WriteAsXml(const TTValue& inputValue, TTValue& outputValue)
 {
 	TTXmlHandlerPtr     aXmlHandler = NULL;
@@ -488,14 +653,12 @@ TTErr Scenario::ReadFromXml(const TTValue& inputValue, TTValue& outputValue)
             mCurrentTimeCondition = NULL;
             
             // clear all data structures
+            for (mTimeEventList.begin(); mTimeEventList.end(); mTimeEventList.next())
+                deleteTimeEventCacheElement(mTimeEventList.current());
+            
             mTimeEventList.clear();
             mTimeProcessList.clear();
             
-            for (itSolver = mVariablesMap.begin() ; itSolver != mVariablesMap.end() ; itSolver++)
-                delete (SolverVariablePtr)itSolver->second;
-            
-            mVariablesMap.clear();
-            
             for (itSolver = mConstraintsMap.begin() ; itSolver != mConstraintsMap.end() ; itSolver++)
                 delete (SolverConstraintPtr)itSolver->second;
             
@@ -506,9 +669,19 @@ TTErr Scenario::ReadFromXml(const TTValue& inputValue, TTValue& outputValue)
             
             mRelationsMap.clear();
             
+            // the constraints are deleted before their variables
+            for (itSolver = mVariablesMap.begin() ; itSolver != mVariablesMap.end() ; itSolver++)
+                delete (SolverVariablePtr)itSolver->second;
+            
+            mVariablesMap.clear();
+            mVariablesIDMap.clear();
+            
             delete mEditionSolver;
             mEditionSolver = new Solver();
             
+            // the solver is built once all the score is read
+            mEditionSolver->startBulk();
+            
 #ifndef NO_EXECUTION_GRAPH
             clearGraph();
 #endif
@@ -521,6 +694,8 @@ TTErr Scenario::ReadFromXml(const TTValue& inputValue, TTValue& outputValue)
             
             mLoading = NO;
             
+            mEditionSolver->endBulk();
+            
             return kTTErrNone;
         }
         
@@ -709,6 +884,7 @@ TTErr Scenario::TimeEventCreate(const TTValue& inputValue, TTValue& outputValue)
 {
     TTTimeEventPtr  aTimeEvent = NULL;
     TTValue         args, aCacheElement, scenarioDuration;
+    TTBoolean       sorted;
     
     if (inputValue.size() == 1) {
         
@@ -734,15 +910,24 @@ TTErr Scenario::TimeEventCreate(const TTValue& inputValue, TTValue& outputValue)
             // create all observers
             makeTimeEventCacheElement(aTimeEvent, aCacheElement);
             
-            // store time event object and observers
+            // store time event object and observers (sort the list again only if the event doesn't come after the others)
+            sorted = mTimeEventList.isEmpty() || !TTTimeEventCompareDate(aCacheElement, mTimeEventList.getTail());
             mTimeEventList.append(aCacheElement);
-            mTimeEventList.sort(&TTTimeEventCompareDate);
+            
+            if (!sorted)
+                mTimeEventList.sort(&TTTimeEventCompareDate);
             
             // add variable to the solver
             SolverVariablePtr variable = new SolverVariable(mEditionSolver, aTimeEvent, TTUInt32(scenarioDuration[0]));
             
             // store the variable relative to the time event
             mVariablesMap.emplace(TTObjectBasePtr(aTimeEvent), variable);
+            mVariablesIDMap[variable->dateID] = variable;
+            
+#ifndef NO_EXECUTION_GRAPH
+            // the execution graph have to be rebuilt
+            mGraphChanged = YES;
+#endif
             
             // return the time event
             outputValue = TTObjectBasePtr(aTimeEvent);
@@ -813,9 +998,16 @@ TTErr Scenario::TimeEventRelease(const TTValue& inputValue, TTValue& outputValue
                     
                     if (!found) {
                         mVariablesMap.erase(aTimeEvent);
+                        mVariablesIDMap.erase(variable->dateID);
                         delete variable;
                     }
                     
+#ifndef NO_EXECUTION_GRAPH
+                    // the execution graph have to be rebuilt
+                    mDirtyTimeEvents.erase(aTimeEvent);
+                    mGraphChanged = YES;
+#endif
+                    
                     // release the time event
                     TTObjectBaseRelease(TTObjectBaseHandle(&aTimeEvent));
                     
@@ -832,8 +1024,9 @@ TTErr Scenario::TimeEventMove(const TTValue& inputValue, TTValue& outputValue)
 {
     TTTimeEventPtr          aTimeEvent;
     SolverVariablePtr       variable;
+    SolverConstraintPtr     constraint;
     SolverObjectMapIterator it;
-    SolverError             sErr;
+    SolverError             sErr = SolverErrorNone;
     TTValue                 scenarioDuration;
     
     // can't move an event during a load
@@ -860,13 +1053,15 @@ TTErr Scenario::TimeEventMove(const TTValue& inputValue, TTValue& outputValue)
             variable = SolverVariablePtr(it->second);
             
             // move all constraints relative to the variable
-            for (it = mConstraintsMap.begin() ; it != mConstraintsMap.end() ; it++) {
+            for (TTUInt32 i = 0; i < variable->constraints.size(); i++) {
+                
+                constraint = variable->constraints[i];
                 
-                if (SolverConstraintPtr(it->second)->startVariable == variable)
-                    sErr = SolverConstraintPtr(it->second)->move(inputValue[1], SolverConstraintPtr(it->second)->endVariable->get());
+                if (constraint->startVariable == variable)
+                    sErr = constraint->move(inputValue[1], constraint->endVariable->get());
                 
-                if (SolverConstraintPtr(it->second)->endVariable == variable)
-                    sErr = SolverConstraintPtr(it->second)->move(SolverConstraintPtr(it->second)->startVariable->get(), inputValue[1]);
+                if (constraint->endVariable == variable)
+                    sErr = constraint->move(constraint->startVariable->get(), inputValue[1]);
                 
                 if (sErr)
                     break;
@@ -874,10 +1069,8 @@ TTErr Scenario::TimeEventMove(const TTValue& inputValue, TTValue& outputValue)
             
             if (!sErr) {
                 
-                // update each solver variable value
-                for (it = mVariablesMap.begin() ; it != mVariablesMap.end() ; it++)
-                    
-                    SolverVariablePtr(it->second)->update();
+                // update the solver variables of the edited part of the scenario
+                updateSolvedVariables();
                 
                 return kTTErrNone;
             }
@@ -902,6 +1095,11 @@ TTErr Scenario::TimeEventCondition(const TTValue& inputValue, TTValue& outputVal
             aTimeEvent = TTTimeEventPtr((TTObjectBasePtr)inputValue[0]);
             aTimeCondition = TTTimeConditionPtr((TTObjectBasePtr)inputValue[1]);
             
+#ifndef NO_EXECUTION_GRAPH
+            // the transition of the time event have to wait (or not) the condition
+            mGraphChanged = YES;
+#endif
+            
             // try to find the time event
             mTimeEventList.find(&TTTimeContainerFindTimeEvent, (TTPtr)aTimeEvent, aCacheElement);
             
@@ -955,9 +1153,20 @@ TTErr Scenario::TimeEventTrigger(const TTValue& inputValue, TTValue& outputValue
                 // if the excecution graph is running
                 if (mExecutionGraph->getUpdateFactor() != 0) {
                     
+                    // the replayed record gives the events instead
+                    if (mReplaying)
+                        return kTTErrNone;
+                    
                     // append the event to the event queue to process its triggering
-                    TTLogMessage("Scenario::TimeEventTrigger : %p\n", TTPtr(aTimeEvent));
-                    mExecutionGraph->putAnEvent(TTPtr(aTimeEvent));
+                    ExecutionTrace::record(TRACE_EVENT_TRIGGERED, mExecutionGraph, mExecutionGraph->getNbOfSteps(), mExecutionGraph->getCurrentTimeInMs(), aTimeEvent);
+                    if (!mExecutionGraph->putAnEvent(TTPtr(aTimeEvent))) {
+                        
+                        TTLogError("Scenario::TimeEventTrigger : too many events are waiting to be processed\n");
+                        return kTTErrGeneric;
+                    }
+                    
+                    // don't wait the next scheduler tick to process the event
+                    TTTimeClock::wake();
                     
                     return kTTErrNone;
                 }
@@ -988,9 +1197,20 @@ TTErr Scenario::TimeEventDispose(const TTValue &inputValue, TTValue &outputValue
                 // if the execution graph is running
                 if (mExecutionGraph->getUpdateFactor() != 0) {
 
+                    // the replayed record gives the deactivations instead
+                    if (mReplaying)
+                        return kTTErrNone;
+
                     // put the associated transition in the list of transitions to deactivate
-                    TTLogMessage("Scenario::TimeEventDispose : %p\n", TTPtr(aTimeEvent));
-                    mExecutionGraph->deactivateTransition(TransitionPtr(mTransitionsMap[aTimeEvent]));
+                    ExecutionTrace::record(TRACE_EVENT_DISPOSED, mExecutionGraph, mExecutionGraph->getNbOfSteps(), mExecutionGraph->getCurrentTimeInMs(), aTimeEvent);
+                    if (!mExecutionGraph->deactivateTransition(TransitionPtr(mTransitionsMap[aTimeEvent]))) {
+                        
+                        TTLogError("Scenario::TimeEventDispose : too many deactivations are waiting to be processed\n");
+                        return kTTErrGeneric;
+                    }
+
+                    // don't wait the next scheduler tick to process the deactivation
+                    TTTimeClock::wake();
 
                     return kTTErrNone;
                 }
@@ -1078,6 +1298,12 @@ TTErr Scenario::TimeEventReplace(const TTValue& inputValue, TTValue& outputValue
             mVariablesMap.erase(aFormerTimeEvent);
             mVariablesMap.emplace(aNewTimeEvent, variable);
             
+#ifndef NO_EXECUTION_GRAPH
+            // the execution graph have to be rebuilt
+            mDirtyTimeEvents.erase(aFormerTimeEvent);
+            mGraphChanged = YES;
+#endif
+            
             return kTTErrNone;
         }
     }
@@ -1151,6 +1377,11 @@ TTErr Scenario::TimeProcessCreate(const TTValue& inputValue, TTValue& outputValu
                     
                 }
                 
+#ifndef NO_EXECUTION_GRAPH
+                // the execution graph have to be rebuilt
+                mGraphChanged = YES;
+#endif
+                
                 // return the time process
                 outputValue = TTObjectBasePtr(aTimeProcess);
                 
@@ -1221,6 +1452,12 @@ TTErr Scenario::TimeProcessRelease(const TTValue& inputValue, TTValue& outputVal
                 outputValue[0] = getTimeProcessStartEvent(aTimeProcess);
                 outputValue[1] = getTimeProcessEndEvent(aTimeProcess);
                 
+#ifndef NO_EXECUTION_GRAPH
+                // the execution graph have to be rebuilt
+                mDirtyTimeProcesses.erase(aTimeProcess);
+                mGraphChanged = YES;
+#endif
+                
                 // release the time process
                 TTObjectBaseRelease(TTObjectBaseHandle(&aTimeProcess));
                 
@@ -1293,10 +1530,8 @@ TTErr Scenario::TimeProcessMove(const TTValue& inputValue, TTValue& outputValue)
             
             if (!sErr) {
                 
-                // update each solver variable value
-                for (it = mVariablesMap.begin() ; it != mVariablesMap.end() ; it++)
-                    
-                    SolverVariablePtr(it->second)->update();
+                // update the solver variables of the edited part of the scenario
+                updateSolvedVariables();
                 
                 return kTTErrNone;
             }
@@ -1340,12 +1575,16 @@ TTErr Scenario::TimeProcessLimit(const TTValue& inputValue, TTValue& outputValue
                 sErr = constraint->limit(inputValue[1], inputValue[2]);
             }
             
+#ifndef NO_EXECUTION_GRAPH
+            // the bounds of the arcs of an interactive end event have to be patched
+            if (!sErr)
+                mDirtyTimeProcesses[aTimeProcess] = aTimeProcess;
+#endif
+            
             if (!sErr && !mLoading) {
                 
-                // update each solver variable value
-                for (it = mVariablesMap.begin() ; it != mVariablesMap.end() ; it++)
-                    
-                    SolverVariablePtr(it->second)->update();
+                // update the solver variables of the edited part of the scenario
+                updateSolvedVariables();
                 
                 return kTTErrNone;
             }
@@ -1373,6 +1612,11 @@ TTErr Scenario::TimeConditionCreate(const TTValue& inputValue, TTValue& outputVa
     // store time condition object and observers
     mTimeConditionList.append(aCacheElement);
     
+#ifndef NO_EXECUTION_GRAPH
+    // the execution graph have to be rebuilt
+    mGraphChanged = YES;
+#endif
+    
     // add a first case if
     
     // TODO : how conditions are constrained by the Solver ?
@@ -1409,6 +1653,11 @@ TTErr Scenario::TimeConditionRelease(const TTValue& inputValue, TTValue& outputV
                 // delete all observers
                 deleteTimeConditionCacheElement(aCacheElement);
                 
+#ifndef NO_EXECUTION_GRAPH
+                // the execution graph have to be rebuilt
+                mGraphChanged = YES;
+#endif
+                
                 // release the time condition
                 TTObjectBaseRelease(TTObjectBaseHandle(&aTimeCondition));
                 
@@ -1439,11 +1688,20 @@ void Scenario::makeTimeEventCacheElement(TTTimeEventPtr aTimeEvent, TTValue& new
     
 	// 0 : cache time event object
 	newCacheElement.append((TTObjectBasePtr)aTimeEvent);
+    
+#ifndef NO_EXECUTION_GRAPH
+    // observe the date of the time event to patch the execution graph
+    aTimeEvent->registerObserverForNotifications(*this);
+#endif
 }
 
 void Scenario::deleteTimeEventCacheElement(const TTValue& oldCacheElement)
 {
-    ;
+#ifndef NO_EXECUTION_GRAPH
+    TTObjectBasePtr aTimeEvent = oldCacheElement[0];
+    
+    aTimeEvent->unregisterObserverForNotifications(*this);
+#endif
 }
 
 void Scenario::makeTimeConditionCacheElement(TTTimeConditionPtr aTimeCondition, TTValue& newCacheElement)
@@ -1459,6 +1717,21 @@ void Scenario::deleteTimeConditionCacheElement(const TTValue& oldCacheElement)
     ;
 }
 
+void Scenario::updateSolvedVariables()
+{
+    SolverVariableIDMapIterator it;
+    const vector<int>&          solvedIDs = mEditionSolver->getSolvedVariables();
+    
+    // the range variables are not in the map
+    for (TTUInt32 i = 0; i < solvedIDs.size(); i++) {
+        
+        it = mVariablesIDMap.find(solvedIDs[i]);
+        
+        if (it != mVariablesIDMap.end())
+            it->second->update();
+    }
+}
+
 #if 0
 #pragma mark -
 #pragma mark Some Methods
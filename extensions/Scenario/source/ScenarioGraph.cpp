@@ -18,27 +18,155 @@
 #include "Scenario.h"
 #include "ScenarioGraph.h"
 
+#include <algorithm>
+
+#define SCENARIO_GRAPH_PLANS_MAX 32
+
+/** Find the node standing for all the nodes merged with a node (path halving keeps the next calls short) */
+static ScenarioGraphNodePtr ScenarioGraphNodeFind(ScenarioGraphNodePtr aNode)
+{
+    while (aNode->parent != NULL) {
+        
+        if (aNode->parent->parent != NULL)
+            aNode->parent = aNode->parent->parent;
+        
+        aNode = aNode->parent;
+    }
+    
+    return aNode;
+}
+
+/** Find the node standing for the transition of an event (NULL if only intervals use it) */
+static ScenarioGraphNodePtr ScenarioGraphNodeOf(GraphObjectMap& eventNodes, TTPtr anEvent)
+{
+    GraphObjectMapIterator it = eventNodes.find(anEvent);
+    
+    if (it == eventNodes.end())
+        return NULL;
+    
+    return ScenarioGraphNodeFind(ScenarioGraphNodePtr(it->second));
+}
+
+/** Merge the nodes standing for two groups of merged nodes : the event actions of the second group follow the ones of the first group */
+static void ScenarioGraphNodeMerge(ScenarioGraphNodePtr aNode, ScenarioGraphNodePtr nodeToMerge)
+{
+    if (aNode == nodeToMerge)
+        return;
+    
+    if (aNode->last != NULL)
+        aNode->last->next = nodeToMerge;
+    else
+        aNode->next = nodeToMerge;
+    
+    aNode->last = nodeToMerge->last != NULL ? nodeToMerge->last : nodeToMerge;
+    nodeToMerge->parent = aNode;
+}
+
 void Scenario::clearGraph()
 {
     // clear the former graph
+    releaseGraph();
+    
+    mExecutionGraph = new PetriNet();
+}
+
+void Scenario::releaseGraph()
+{
+    // the sub-scenarios stepped by the former graph are released before it
+    releaseSubScenarios();
+    
     if (mExecutionGraph != NULL) {
+        
+        if (mGraphHosted)
+            mParentScenario->mExecutionGraph->stopInternPetriNet(mExecutionGraph);
+        
 		delete mExecutionGraph;
 		mExecutionGraph = NULL;
 	}
     
-    mExecutionGraph = new PetriNet();
+    mGraphHosted = NO;
+    mGraphChanged = YES;
     
     // clear all maps
     mTransitionsMap.clear();
+    mTransitionEventsMap.clear();
 	mArcsMap.clear();
-    mMergedTransitionsMap.clear();
+    mStartArcsMap.clear();
+    mEndArcsMap.clear();
+    mArcProcessesMap.clear();
+    mInteractiveEventsMap.clear();
+    
+    // the plans kept aside belong to the former graph
+    clearGraphPlans();
 }
 
-void Scenario::compileGraph(TTUInt32 timeOffset)
+void Scenario::releaseSubScenarios()
 {
     TTTimeProcessPtr    aTimeProcess;
-    TTTimeEventPtr      aTimeEvent;
-    TTValue             v;
+    ScenarioPtr         aSubScenario;
+    
+    for (mTimeProcessList.begin(); mTimeProcessList.end(); mTimeProcessList.next()) {
+        
+        aTimeProcess = TTTimeProcessPtr(TTObjectBasePtr(mTimeProcessList.current()[0]));
+        
+        if (aTimeProcess->getName() != TTSymbol("Scenario"))
+            continue;
+        
+        aSubScenario = ScenarioPtr(aTimeProcess);
+        
+        if (aSubScenario->mParentScenario == this && aSubScenario->mGraphHosted)
+            aSubScenario->releaseGraph();
+    }
+}
+
+void Scenario::clearGraphPlans()
+{
+    GraphPlanMapIterator it;
+    
+    for (it = mGraphPlans.begin(); it != mGraphPlans.end(); it++)
+        delete it->second;
+    
+    mGraphPlans.clear();
+}
+
+TTErr Scenario::compileGraph(TTUInt32 timeOffset)
+{
+    TTTimeProcessPtr        aTimeProcess;
+    TTTimeEventPtr          aTimeEvent, startEvent, endEvent;
+    ExecutionPlan*          aPlan;
+    ScenarioGraphNodeVector nodes;
+    ScenarioGraphNodePtr    aNode, startNode, endNode;
+    GraphObjectMap          eventNodes;
+    GraphObjectMapIterator  it;
+    TTSymbol                intervalName = TTSymbol("Interval");
+    TTUInt32                i;
+    TTValue                 v;
+    
+    // the dates of the conditioned events only change with an edit
+    if (mGraphChanged || !mDirtyTimeEvents.empty())
+        sortConditionedEvents();
+    
+    // patch the former graph if only dates, duration bounds or the time offset changed since its compilation
+    if (isGraphPatchable()) {
+        
+        aPlan = mExecutionGraph->takePlan();
+        
+        // an edit makes all the plans kept aside out of date
+        if (!mDirtyTimeEvents.empty() || !mDirtyTimeProcesses.empty())
+            clearGraphPlans();
+        
+        // keep the plan aside for the next compilation with the same key (each plan is as big as the graph)
+        if (mDirtyTimeEvents.empty() && mDirtyTimeProcesses.empty() && mGraphPlans.size() < SCENARIO_GRAPH_PLANS_MAX)
+            mGraphPlans[mGraphPlanKey] = aPlan;
+        else
+            delete aPlan;
+        
+        // nothing to patch if nothing was edited and the same conditioned events are before the time offset
+        if (!mDirtyTimeEvents.empty() || !mDirtyTimeProcesses.empty() || getGraphPlanKey(timeOffset) != mGraphPlanKey)
+            patchGraph(timeOffset);
+        
+        return freezeGraph(timeOffset);
+    }
     
     // cf : ECOMachine::compilePetriNet
     
@@ -47,6 +175,9 @@ void Scenario::compileGraph(TTUInt32 timeOffset)
     // set the callback used to get ready event state back
     mExecutionGraph->addIsEventReadyCallback(&ScenarioGraphIsEventReadyCallBack);
     
+    // set the callback used to record the events processed by each step
+    mExecutionGraph->addStepInputCallback(&ScenarioGraphStepInputCallBack, this);
+    
 	// start the graph
 	Place*          startPlace = mExecutionGraph->createPlace();
 	TransitionPtr   startTransition = mExecutionGraph->createTransition();
@@ -64,28 +195,93 @@ void Scenario::compileGraph(TTUInt32 timeOffset)
     
 // TODO : sort the time process to order them in time (?)
     
-    // compile all time processes except the interval processes
+    // one node for each event of the time processes except the interval processes
+    // (the graph is built without merging nor deleting anything afterward : each step below goes once through the time processes or the nodes)
+    nodes.reserve(2 * mTimeProcessList.getSize());
+    
     for (mTimeProcessList.begin(); mTimeProcessList.end(); mTimeProcessList.next()) {
         
-        TransitionPtr previousTransition = startTransition;
+        aTimeProcess = TTTimeProcessPtr(TTObjectBasePtr(mTimeProcessList.current()[0]));
+        
+        if (aTimeProcess->getName() != intervalName) {
+            
+            startEvent = getTimeProcessStartEvent(aTimeProcess);
+            endEvent = getTimeProcessEndEvent(aTimeProcess);
+            
+            nodes.push_back(ScenarioGraphNode(startEvent));
+            eventNodes[startEvent] = &nodes.back();
+            
+            nodes.push_back(ScenarioGraphNode(endEvent));
+            eventNodes[endEvent] = &nodes.back();
+        }
+	}
+    
+    // merge the nodes of the intervals without duration
+    for (mTimeProcessList.begin(); mTimeProcessList.end(); mTimeProcessList.next()) {
         
         aTimeProcess = TTTimeProcessPtr(TTObjectBasePtr(mTimeProcessList.current()[0]));
         
-        if (aTimeProcess->getName() != TTSymbol("Interval"))
-            compileTimeProcess(aTimeProcess, &previousTransition, endTransition, timeOffset);
+        if (aTimeProcess->getName() == intervalName) {
+            
+            startEvent = getTimeProcessStartEvent(aTimeProcess);
+            endEvent = getTimeProcessEndEvent(aTimeProcess);
+            
+            startNode = ScenarioGraphNodeOf(eventNodes, startEvent);
+            endNode = ScenarioGraphNodeOf(eventNodes, endEvent);
+            
+            if (startNode && endNode && getTimeEventDate(endEvent) - getTimeEventDate(startEvent) <= 0)
+                ScenarioGraphNodeMerge(startNode, endNode);
+        }
 	}
     
+    // create one transition for all the merged nodes with the actions of their events
+    for (i = 0; i < nodes.size(); i++) {
+        
+        if (nodes[i].parent != NULL)
+            continue;
+        
+        nodes[i].transition = mExecutionGraph->createTransition();
+        
+        for (aNode = &nodes[i]; aNode != NULL; aNode = aNode->next)
+            nodes[i].transition->addExternAction(&ScenarioGraphTimeEventCallBack, aNode->event);
+    }
+    
+    for (it = eventNodes.begin(); it != eventNodes.end(); it++) {
+        
+        mTransitionsMap[it->first] = ScenarioGraphNodeFind(ScenarioGraphNodePtr(it->second))->transition;
+        
+        // the record finds the event of a deactivated transition without going through all the events (any merged event stands for the others)
+        mTransitionEventsMap.insert(GraphObjectMap::value_type(mTransitionsMap[it->first], it->first));
+    }
+    
 	// compile intervals processes
     for (mTimeProcessList.begin(); mTimeProcessList.end(); mTimeProcessList.next()) {
         
         aTimeProcess = TTTimeProcessPtr(TTObjectBasePtr(mTimeProcessList.current()[0]));
         
-        if (aTimeProcess->getName() == TTSymbol("Interval"))
-            compileInterval(aTimeProcess);
+        if (aTimeProcess->getName() == intervalName) {
+            
+            startNode = ScenarioGraphNodeOf(eventNodes, getTimeProcessStartEvent(aTimeProcess));
+            endNode = ScenarioGraphNodeOf(eventNodes, getTimeProcessEndEvent(aTimeProcess));
+            
+            if (startNode && endNode)
+                compileInterval(aTimeProcess, startNode, endNode);
+        }
 	}
     
-	// clean the graph
-//    mExecutionGrap->cleanGraph(endTransition);
+    // compile all time processes except the interval processes
+    i = 0;
+    
+    for (mTimeProcessList.begin(); mTimeProcessList.end(); mTimeProcessList.next()) {
+        
+        aTimeProcess = TTTimeProcessPtr(TTObjectBasePtr(mTimeProcessList.current()[0]));
+        
+        if (aTimeProcess->getName() != intervalName) {
+            
+            compileTimeProcess(aTimeProcess, ScenarioGraphNodeFind(&nodes[i]), ScenarioGraphNodeFind(&nodes[i + 1]), startTransition, endTransition, timeOffset);
+            i += 2;
+        }
+	}
     
 	// compile interactive events
 	for (mTimeEventList.begin(); mTimeEventList.end(); mTimeEventList.next()) {
@@ -95,29 +291,330 @@ void Scenario::compileGraph(TTUInt32 timeOffset)
         if (getTimeEventCondition(aTimeEvent) != NULL)
             compileInteractiveEvent(aTimeEvent, timeOffset);
 	}
+    
+    return freezeGraph(timeOffset);
 }
 
-void Scenario::compileTimeProcess(TTTimeProcessPtr aTimeProcess, TransitionPtr* previousTransition, TransitionPtr endTransition, TTUInt32 timeOffset)
+TTErr Scenario::freezeGraph(TTUInt32 timeOffset)
 {
-    TransitionPtr   currentTransition;
-    TransitionPtr   startTransition = NULL;
-    TransitionPtr   lastTransition = NULL;
-    Place*          currentPlace;
-    Arc*            arcFromPreviousTransitionToCurrentPlace;
-    Arc*            arcFromCurrentPlaceToTheEnd;
+    TTUInt32                key = getGraphPlanKey(timeOffset);
+    GraphPlanMapIterator    it = mGraphPlans.find(key);
+    PetriNetValidator       validator(mExecutionGraph);
+    TTErr                   err = kTTErrNone;
     
-    TTTimeEventPtr  startEvent = getTimeProcessStartEvent(aTimeProcess);
-    TTTimeEventPtr  endEvent = getTimeProcessEndEvent(aTimeProcess);
+    // a plan kept aside for the same key has already been checked and built
+    if (it != mGraphPlans.end()) {
+        
+        mExecutionGraph->freeze(it->second);
+        mGraphPlans.erase(key);
+    }
+    else {
+        
+        // freeze the graph into flat arrays for the execution : it is checked once here so the execution doesn't have to check it at each step
+        if (!mExecutionGraph->freeze(validator)) {
+            
+            // a wrong structure, wrong bounds or an unreachable event can't be played at all
+            if (validator.hasDefiniteErrors()) {
+                
+                for (TTUInt32 i = 0; i < validator.getErrors().size(); i++)
+                    TTLogError("Scenario::compileGraph : %s\n", validator.getErrors()[i].c_str());
+                
+                err = kTTErrGeneric;
+            }
+            
+            // the check of the dates is conservative : the graph is still played by its objects (which check it at each step)
+            else {
+                
+                for (TTUInt32 i = 0; i < validator.getErrors().size(); i++)
+                    TTLogMessage("Scenario::compileGraph : %s (the graph is not frozen)\n", validator.getErrors()[i].c_str());
+            }
+        }
+    }
     
-    // compile start event
-    currentTransition = mExecutionGraph->createTransition();
-    currentPlace = mExecutionGraph->createPlace();
-    startTransition = currentTransition;
+    // the next compilation will only patch what will change from now
+    mDirtyTimeEvents.clear();
+    mDirtyTimeProcesses.clear();
+    mGraphChanged = NO;
+    mGraphTimeOffset = timeOffset;
+    mGraphPlanKey = key;
+    
+    return err;
+}
+
+TTUInt32 Scenario::getGraphPlanKey(TTUInt32 timeOffset)
+{
+    TTUInt32 low = 0;
+    TTUInt32 high = mConditionedEvents.size();
+    TTUInt32 middle;
+    
+    // the time offset only decides which conditioned events are interactive (cf compileInteractiveEvent) :
+    // all the offsets with the same conditioned events before them give the same graph (the key is their number)
+    while (low < high) {
+        
+        middle = (low + high) / 2;
+        
+        if (mConditionedEvents[middle].date < timeOffset)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    
+    return low;
+}
+
+/** compare the date of two conditioned events (then their order in the time event list) */
+static bool ScenarioGraphConditionedEventCompare(const ScenarioGraphConditionedEvent& a, const ScenarioGraphConditionedEvent& b)
+{
+    return a.date < b.date || (a.date == b.date && a.order < b.order);
+}
+
+/** compare the order of two conditioned events in the time event list */
+static bool ScenarioGraphConditionedEventOrderCompare(const ScenarioGraphConditionedEvent& a, const ScenarioGraphConditionedEvent& b)
+{
+    return a.order < b.order;
+}
+
+void Scenario::sortConditionedEvents()
+{
+    TTTimeEventPtr  aTimeEvent;
+    TTUInt32        order = 0;
+    
+    mConditionedEvents.clear();
+    
+    for (mTimeEventList.begin(); mTimeEventList.end(); mTimeEventList.next()) {
+        
+        aTimeEvent = TTTimeEventPtr(TTObjectBasePtr(mTimeEventList.current()[0]));
+        
+        if (getTimeEventCondition(aTimeEvent) != NULL)
+            mConditionedEvents.push_back(ScenarioGraphConditionedEvent(getTimeEventDate(aTimeEvent), order, aTimeEvent));
+        
+        order++;
+    }
+    
+    std::sort(mConditionedEvents.begin(), mConditionedEvents.end(), ScenarioGraphConditionedEventCompare);
+}
+
+TTBoolean Scenario::isGraphPatchable()
+{
+    TTTimeProcessPtr    aTimeProcess;
+    TTTimeEventPtr      startEvent, endEvent;
+    TTBoolean           merged;
+    
+    // an unfrozen graph have been executed by its objects (or not compiled at all)
+    if (mGraphChanged || mExecutionGraph == NULL || !mExecutionGraph->isFrozen())
+        return NO;
+    
+    // an interval can't get (or lose) a duration without merging (or splitting) its transitions
+    if (!mDirtyTimeEvents.empty()) {
+        
+        for (mTimeProcessList.begin(); mTimeProcessList.end(); mTimeProcessList.next()) {
+            
+            aTimeProcess = TTTimeProcessPtr(TTObjectBasePtr(mTimeProcessList.current()[0]));
+            
+            if (aTimeProcess->getName() != TTSymbol("Interval"))
+                continue;
+            
+            startEvent = getTimeProcessStartEvent(aTimeProcess);
+            endEvent = getTimeProcessEndEvent(aTimeProcess);
+            
+            if (mDirtyTimeEvents.find(startEvent) == mDirtyTimeEvents.end() && mDirtyTimeEvents.find(endEvent) == mDirtyTimeEvents.end())
+                continue;
+            
+            merged = mEndArcsMap[aTimeProcess] == NULL;
+            
+            if (merged != (getTimeEventDate(endEvent) - getTimeEventDate(startEvent) <= 0))
+                return NO;
+        }
+    }
+    
+    return YES;
+}
+
+void Scenario::patchGraph(TTUInt32 timeOffset)
+{
+    TTTimeProcessPtr        aTimeProcess;
+    TTTimeEventPtr          aTimeEvent, startEvent, endEvent;
+    TransitionPtr           aTransition;
+    Arc*                    anArc;
+    ExtendedInt             timeValue;
+    TTBoolean               interactive;
+    GraphObjectMap          patchedTransitions;
+    GraphObjectMapIterator  it;
+    TTUInt32                i, first, last;
+    std::vector<TTTimeEventPtr>         movedEvents;
+    ScenarioGraphConditionedEventVector patchedEvents;
+    
+    // find the transitions of the time processes whose events moved or whose duration bounds changed
+    // (this goes through all the time processes, but only after an edit)
+    for (mTimeProcessList.begin(); mTimeProcessList.end() && (!mDirtyTimeProcesses.empty() || !mDirtyTimeEvents.empty()); mTimeProcessList.next()) {
+        
+        aTimeProcess = TTTimeProcessPtr(TTObjectBasePtr(mTimeProcessList.current()[0]));
+        
+        startEvent = getTimeProcessStartEvent(aTimeProcess);
+        endEvent = getTimeProcessEndEvent(aTimeProcess);
+        
+        if (mDirtyTimeProcesses.find(aTimeProcess) == mDirtyTimeProcesses.end() &&
+            mDirtyTimeEvents.find(startEvent) == mDirtyTimeEvents.end() &&
+            mDirtyTimeEvents.find(endEvent) == mDirtyTimeEvents.end())
+            continue;
+        
+        // the arc from the start of the graph is removed when an interval ends at the start event
+        it = mStartArcsMap.find(aTimeProcess);
+        
+        if (it != mStartArcsMap.end() && it->second)
+            patchedTransitions[((Arc*)it->second)->getTo()] = ((Arc*)it->second)->getTo();
+        
+        // an interval without duration has no arc
+        it = mEndArcsMap.find(aTimeProcess);
+        
+        if (it != mEndArcsMap.end() && it->second)
+            patchedTransitions[((Arc*)it->second)->getTo()] = ((Arc*)it->second)->getTo();
+    }
+    
+    // find the transitions of the events which become interactive (or not) : the moved events
+    for (it = mDirtyTimeEvents.begin(); it != mDirtyTimeEvents.end(); it++)
+        movedEvents.push_back(TTTimeEventPtr(TTObjectBasePtr(it->first)));
+    
+    // and the conditioned events between the former and the new time offset (their dates didn't change if they didn't move)
+    first = getGraphPlanKey(timeOffset < mGraphTimeOffset ? timeOffset : mGraphTimeOffset);
+    last = getGraphPlanKey(timeOffset < mGraphTimeOffset ? mGraphTimeOffset : timeOffset);
+    
+    for (i = first; i < last; i++)
+        movedEvents.push_back(TTTimeEventPtr(mConditionedEvents[i].event));
+    
+    for (i = 0; i < movedEvents.size(); i++) {
+        
+        aTimeEvent = movedEvents[i];
+        
+        interactive = getTimeEventCondition(aTimeEvent) != NULL && getTimeEventDate(aTimeEvent) >= timeOffset;
+        it = mInteractiveEventsMap.find(aTimeEvent);
+        
+        if (it != mInteractiveEventsMap.end() && !interactive)
+            patchedTransitions[it->second] = it->second;
+        
+        if (it == mInteractiveEventsMap.end() && interactive)
+            patchedTransitions[mTransitionsMap[aTimeEvent]] = mTransitionsMap[aTimeEvent];
+    }
+    
+    if (patchedTransitions.empty())
+        return;
+    
+    // set the patched transitions back as compileTimeProcess and compileInterval make them
+    for (it = patchedTransitions.begin(); it != patchedTransitions.end(); it++) {
+        
+        aTransition = TransitionPtr(it->first);
+        aTransition->setEvent(STATIC_EVENT);
+        
+        ArcRange incomingArcs = aTransition->inGoingArcsOf();
+        
+        for (unsigned int i = 0; i < incomingArcs.size(); ++i) {
+            
+            anArc = incomingArcs[i];
+            
+            GraphObjectMapIterator processIt = mArcProcessesMap.find(anArc);
+            
+            if (processIt == mArcProcessesMap.end())
+                continue;
+            
+            aTimeProcess = TTTimeProcessPtr(processIt->second);
+            startEvent = getTimeProcessStartEvent(aTimeProcess);
+            endEvent = getTimeProcessEndEvent(aTimeProcess);
+            
+            if (mStartArcsMap.find(aTimeProcess) != mStartArcsMap.end() && mStartArcsMap[aTimeProcess] == anArc)
+                timeValue.setAsInteger(getTimeEventDate(startEvent));
+            else
+                timeValue.setAsInteger(getTimeEventDate(endEvent) - getTimeEventDate(startEvent));
+            
+            anArc->changeRelativeTime(timeValue, plusInfinity);
+        }
+    }
     
-    compileTimeEvent(startEvent, getTimeEventDate(startEvent), *previousTransition, currentTransition, currentPlace);
+    // then compile their interactive events again, in the same order as compileGraph
+    // (only the conditioned events can be interactive : this goes through them, not through all the events)
+    for (i = 0; i < mConditionedEvents.size(); i++) {
+        
+        if (patchedTransitions.find(mTransitionsMap[mConditionedEvents[i].event]) != patchedTransitions.end()) {
+            
+            mInteractiveEventsMap.erase(mConditionedEvents[i].event);
+            patchedEvents.push_back(mConditionedEvents[i]);
+        }
+    }
     
-    mTransitionsMap[startEvent] = currentTransition;
-    *previousTransition = currentTransition;
+    std::sort(patchedEvents.begin(), patchedEvents.end(), ScenarioGraphConditionedEventOrderCompare);
+    
+    for (i = 0; i < patchedEvents.size(); i++)
+        compileInteractiveEvent(TTTimeEventPtr(patchedEvents[i].event), timeOffset);
+}
+
+TTErr Scenario::EventDateChanged(const TTValue& inputValue, TTValue& outputValue)
+{
+    TTObjectBasePtr aTimeEvent;
+    
+    if (inputValue.size() == 1) {
+        
+        if (inputValue[0].type() == kTypeObject) {
+            
+            aTimeEvent = inputValue[0];
+            mDirtyTimeEvents[aTimeEvent] = aTimeEvent;
+            
+            return kTTErrNone;
+        }
+    }
+    
+    return kTTErrGeneric;
+}
+
+TTErr Scenario::GraphInfo(const TTValue& inputValue, TTValue& outputValue)
+{
+    TTTimeProcessPtr        aTimeProcess;
+    GraphObjectMapIterator  it;
+    
+    if (mExecutionGraph == NULL)
+        return kTTErrGeneric;
+    
+    outputValue.clear();
+    outputValue.append(TTUInt32(mExecutionGraph->getTransitions().size()));
+    outputValue.append(TTUInt32(mExecutionGraph->getPlaces().size()));
+    
+    for (mTimeProcessList.begin(); mTimeProcessList.end(); mTimeProcessList.next()) {
+        
+        aTimeProcess = TTTimeProcessPtr(TTObjectBasePtr(mTimeProcessList.current()[0]));
+        
+        it = mStartArcsMap.find(aTimeProcess);
+        
+        if (it != mStartArcsMap.end() && it->second)
+            outputValue.append(TTInt32(((Arc*)it->second)->getRelativeMinValue().getValue()));
+        else
+            outputValue.append(TTInt32(-1));
+        
+        it = mEndArcsMap.find(aTimeProcess);
+        
+        if (it != mEndArcsMap.end() && it->second)
+            outputValue.append(TTInt32(((Arc*)it->second)->getRelativeMinValue().getValue()));
+        else
+            outputValue.append(TTInt32(-1));
+    }
+    
+    return kTTErrNone;
+}
+
+void Scenario::compileTimeProcess(TTTimeProcessPtr aTimeProcess, ScenarioGraphNodePtr startNode, ScenarioGraphNodePtr endNode, TransitionPtr startTransition, TransitionPtr endTransition, TTUInt32 timeOffset)
+{
+    Arc*            anArc;
+    
+    TTTimeEventPtr  startEvent = getTimeProcessStartEvent(aTimeProcess);
+    TTTimeEventPtr  endEvent = getTimeProcessEndEvent(aTimeProcess);
+    
+    // compile start event : an interval with a duration ending at the start event replaces the arc from the start of the graph
+    if (startNode->hasIntervalIn)
+        mStartArcsMap[aTimeProcess] = NULL;
+    else {
+        
+        anArc = compileArc(startTransition, startNode->transition, getTimeEventDate(startEvent));
+        
+        mStartArcsMap[aTimeProcess] = anArc;
+        mArcProcessesMap[anArc] = aTimeProcess;
+    }
     
     // compile intermediate events
 /*
@@ -127,63 +624,25 @@ void Scenario::compileTimeProcess(TTTimeProcessPtr aTimeProcess, TransitionPtr*
     ExtendedInt intermediatePointValue;
     intermediatePointValue.setAsInteger(aTimeProcess->getControlPoint(controlPointID->at(j))->beginValue() - aTimeProcess->getControlPoint(controlPointID->at(j-1))->beginValue());
     
-    compileTimeEvent(anEvent, previousDate - currentDate, *previousTransition, currentTransition, currentPlace);
+    compileArc(previousTransition, currentTransition, previousDate - currentDate);
     
     mTransitionsMap[intermediateEvent] = currentTransition;
     previousTransition = currentTransition;
 */
     
     // compile end event
-    currentTransition = mExecutionGraph->createTransition();
-    currentPlace = mExecutionGraph->createPlace();
-    lastTransition = currentTransition;
-    
-    compileTimeEvent(endEvent, getTimeEventDate(endEvent) - getTimeEventDate(startEvent), *previousTransition, currentTransition, currentPlace);  // normally it is not the startDate but the last intermediate event date
-    
-    mTransitionsMap[endEvent] = currentTransition;
-    *previousTransition = currentTransition;
-    
-/* IS THIS RELATIVE TO COMPILATION OF SUB SCENARIO ?
-note : it was in compileEvent
-     
-     // after compiling the end event
-     // if this is not the last time process
-     if (mTimeProcessList.end()) {
-     
-        std::vector<unsigned int> aTimeProcessIdToStop;
-     
-        unsigned int currentTime = timeOffset > startDate ? timeOffset - startDate : 0;
-        PetriNet* currentPetriNet = compileScenario(hierarchyStoryLine[aTimeProcessId], hierarchyStoryLine, aTimeProcessIdToStop, currentTime, triggerAction);
-     
-        mExecutionGraph->addInternPetriNet(startTransition, lastTransition, currentPetriNet);
-     
-        lastTransition->setmExecutionGraphToEnd(currentPetriNet);
-     
-        if (endDate - startDate >= timeOffset) {
-     
-            lastTransition->setMustWaitThePetriNetToEnd(true);
-     
-            arcList incomingArcs = currentTransition->inGoingArcsOf();
-            for (unsigned int k = 0; k < incomingArcs.size(); ++k) {
-                incomingArcs[k]->changeRelativeTime(incomingArcs[k]->getRelativeMinValue(), plusInfinity);
-            }
-        }
-     
-        currentControlPointInformations->m_processIdToStop = aTimeProcessIdToStop;
-     
-        for (unsigned int k = 0; k < aTimeProcessIdToStop.size(); ++k)
-            processIdToStop.push_back(aTimeProcessIdToStop[k]);
-     
-     }
-*/
+    anArc = compileArc(startNode->transition, endNode->transition, getTimeEventDate(endEvent) - getTimeEventDate(startEvent));  // normally it is not the startDate but the last intermediate event date
     
-    // close the compilation of the process
-    currentPlace = mExecutionGraph->createPlace();
+    mEndArcsMap[aTimeProcess] = anArc;
+    mArcProcessesMap[anArc] = aTimeProcess;
     
-    arcFromPreviousTransitionToCurrentPlace = mExecutionGraph->createArc(*previousTransition, currentPlace);
+    // a sub-scenario is only compiled when this graph reaches its start event : then this graph steps its graph until its end event (cf ProcessStart)
+    if (aTimeProcess->getName() == TTSymbol("Scenario"))
+        ScenarioPtr(aTimeProcess)->mParentScenario = this;
     
-    arcFromCurrentPlaceToTheEnd = mExecutionGraph->createArc(currentPlace, endTransition);
-    arcFromCurrentPlaceToTheEnd->changeRelativeTime(integer0, plusInfinity);
+    // close the compilation of the process : an interval with a duration starting at the end event replaces the arc to the end of the graph
+    if (!endNode->hasIntervalOut)
+        compileArc(endNode->transition, endTransition, 0);
     
 // note : this is useless as we can find it by asking the duration
 //  aTimeProcess->setWrittenTime(aTimeProcess->lengthValue());
@@ -197,96 +656,39 @@ note : it was in compileEvent
         ;// TODO : aTimeProcess->computeCurves(endDate - startDate);
 }
 
-void Scenario::compileInterval(TTTimeProcessPtr aTimeProcess)
+void Scenario::compileInterval(TTTimeProcessPtr aTimeProcess, ScenarioGraphNodePtr startNode, ScenarioGraphNodePtr endNode)
 {
-    TransitionPtr           startTransition;
-    TransitionPtr           endTransition;
-    Place*                  currentPlace;
-    Arc*                    arcFromstartTransitionToCurrentPlace;
-    Arc*                    arcFromCurrentPlaceToendTransition;
-    
-    ExtendedInt             intervalValue;
+    Arc*            anArc;
     
     TTTimeEventPtr  startEvent = getTimeProcessStartEvent(aTimeProcess);
     TTTimeEventPtr  endEvent = getTimeProcessEndEvent(aTimeProcess);
     
-// CB now unused    
-//  GraphObjectMapIterator  mergeIterator; 
-    
-
 // note : this is useless because it is checked during edition
 //  if (startEvent->getContainingBoxId() != endEvent->getContainingBoxId()) {
     
-    // retreive start transition
-    startTransition = TransitionPtr(mTransitionsMap[startEvent]);
-    
-/* CB Now stored directly in mTransitionsMap
-    mergeIterator = mMergedTransitionsMap.find(startTransition);
-    
-    if (mergeIterator != mMergedTransitionsMap.end())
-     startTransition = TransitionPtr(mergeIterator->second);
-*/
-    
-    // retreive end transition
-    endTransition = TransitionPtr(mTransitionsMap[endEvent]);
-    
-/* CB Now stored directly in mTransitionsMap
-    mergeIterator = mMergedTransitionsMap.find(endTransition);
-    
-    if (mergeIterator != mMergedTransitionsMap.end())
-        endTransition = TransitionPtr(mergeIterator->second);
-*/
-    
-    // if the interval have no duration
+    // if the interval have no duration : its nodes have been merged into one transition
     if (getTimeEventDate(endEvent) - getTimeEventDate(startEvent) <= 0) {
         
-        startTransition->merge(endTransition);
-        mTransitionsMap[endEvent] = startTransition;
-        
-// CB Now stored directly in mTransitionsMap
-//      mMergedTransitionsMap[endTransition] = startTransition;
-    }
-    else {
-        
-        currentPlace = mExecutionGraph->createPlace();
-        
-        intervalValue.setAsInteger(getTimeEventDate(endEvent) - getTimeEventDate(startEvent));
-        
-        arcFromstartTransitionToCurrentPlace = mExecutionGraph->createArc(startTransition, currentPlace);
-        
-        arcFromCurrentPlaceToendTransition = mExecutionGraph->createArc(currentPlace, endTransition);
-        arcFromCurrentPlaceToendTransition->changeRelativeTime(intervalValue, plusInfinity);
-        
-        mArcsMap[arcFromCurrentPlaceToendTransition] = aTimeProcess;
-        
-        // First cleaning
-        petriNetNodeList placesAfterStartTransition = startTransition->returnSuccessors();
-        for (unsigned j = 0; j < placesAfterStartTransition.size(); ++j) {
-            
-            Place* placeToCheckIfLinkedWithEndTransition = (Place*) placesAfterStartTransition[j];
-            TransitionPtr transitionToCheckIfEqualToEndTransition = (TransitionPtr) placeToCheckIfLinkedWithEndTransition->returnSuccessors()[0];
-            
-            if (mExecutionGraph->getEndPlace()->haveArcFrom(transitionToCheckIfEqualToEndTransition))
-                mExecutionGraph->deleteItem(placeToCheckIfLinkedWithEndTransition);
-            
-        }
-        
-        petriNetNodeList placesBeforeEndTransition = endTransition->returnPredecessors();
-        for (unsigned j = 0; j < placesBeforeEndTransition.size() ; ++j) {
-            
-            Place* placeToCheckIfLinkedWithStartTransition = (Place*) placesBeforeEndTransition[j];
-            TransitionPtr transitionToCheckIfEqualToStartTransition = (TransitionPtr) placeToCheckIfLinkedWithStartTransition->returnPredecessors()[0];
-            
-            if (mExecutionGraph->getStartPlace()->haveArcTo(transitionToCheckIfEqualToStartTransition))
-                mExecutionGraph->deleteItem(placeToCheckIfLinkedWithStartTransition);
-            
-        }
+        mEndArcsMap[aTimeProcess] = NULL;
+        return;
     }
+    
+    anArc = compileArc(startNode->transition, endNode->transition, getTimeEventDate(endEvent) - getTimeEventDate(startEvent));
+    
+    mArcsMap[anArc] = aTimeProcess;
+    mEndArcsMap[aTimeProcess] = anArc;
+    mArcProcessesMap[anArc] = aTimeProcess;
+    
+    // the start transition doesn't need to be closed to the end of the graph
+    // and the end transition doesn't need to be started from the start of the graph (cf compileTimeProcess)
+    startNode->hasIntervalOut = YES;
+    endNode->hasIntervalIn = YES;
 }
 
-void Scenario::compileTimeEvent(TTTimeEventPtr aTimeEvent, TTUInt32 time, TransitionPtr previousTransition, TransitionPtr currentTransition, Place* currentPlace)
+Arc* Scenario::compileArc(TransitionPtr previousTransition, TransitionPtr currentTransition, TTUInt32 time)
 {
     ExtendedInt timeValue;
+    Place*      currentPlace = mExecutionGraph->createPlace();
     Arc*        arcFromCurrentPlaceToCurrentTransition = mExecutionGraph->createArc(currentPlace, currentTransition);
     
     // create arc from previous transition to current place
@@ -295,8 +697,7 @@ void Scenario::compileTimeEvent(TTTimeEventPtr aTimeEvent, TTUInt32 time, Transi
     timeValue.setAsInteger(time);
     arcFromCurrentPlaceToCurrentTransition->changeRelativeTime(timeValue, plusInfinity);
     
-    // prepare transition
-    currentTransition->addExternAction(&ScenarioGraphTimeEventCallBack, aTimeEvent);
+    return arcFromCurrentPlaceToCurrentTransition;
 }
 
 void Scenario::compileInteractiveEvent(TTTimeEventPtr aTimeEvent, TTUInt32 timeOffset)
@@ -306,8 +707,6 @@ void Scenario::compileInteractiveEvent(TTTimeEventPtr aTimeEvent, TTUInt32 timeO
     
     TTBoolean     mute;
     
-    GraphObjectMapIterator  mergeIterator;
-    
     // TODO : get event mute state
     mute = NO;
     
@@ -315,15 +714,13 @@ void Scenario::compileInteractiveEvent(TTTimeEventPtr aTimeEvent, TTUInt32 timeO
         
         // retreive transition
         currentTransition = TransitionPtr(mTransitionsMap[aTimeEvent]);
-        mergeIterator = mMergedTransitionsMap.find(currentTransition);
-        
-        if (mergeIterator != mMergedTransitionsMap.end())
-            currentTransition = TransitionPtr(mergeIterator->second);
         
         // prepare transition
         currentTransition->setEvent(aTimeEvent);
         currentTransition->setMustWaitThePetriNetToEnd(false);
         
+        mInteractiveEventsMap[aTimeEvent] = currentTransition;
+        
 /* IS THIS USEFULL ?
          if (aTimeEvent->getType() == TRIGGER_END_TEMPO_CHANGE) {
          
@@ -347,7 +744,7 @@ void Scenario::compileInteractiveEvent(TTTimeEventPtr aTimeEvent, TTUInt32 timeO
 */
         
         // prepare transition for incoming ranged interval
-        arcList incomingArcs = currentTransition->inGoingArcsOf();
+        ArcRange incomingArcs = currentTransition->inGoingArcsOf();
         for (unsigned int i = 0; i < incomingArcs.size(); ++i) {
             
             currentArc = incomingArcs[i];
@@ -0,0 +1,433 @@
+/** @file
+ *
+ * @ingroup scoreExtension
+ *
+ * @brief Scenario Record file defines specific methods to record the inputs of the execution graph and to replay them
+ *
+ * @see Scenario, ScenarioRecord
+ *
+ * @authors Théo de la Hogue & Clément Bossut
+ *
+ * @copyright Copyright © 2013, Théo de la Hogue & Clément Bossut @n
+ * This code is licensed under the terms of the "CeCILL-C" @n
+ * http://www.cecill.info
+ */
+
+#ifndef NO_EXECUTION_GRAPH
+
+#include "Scenario.h"
+#include "ScenarioRecord.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define SCENARIO_RECORD_LINE_SIZE 4096
+
+/** the name of each ScenarioRecordKind into a record file */
+static const char* sScenarioRecordKindNames[] = {"step", "trigger", "dispose", "value"};
+
+TTErr Scenario::Record(const TTValue& inputValue, TTValue& outputValue)
+{
+    TTObjectBasePtr aTimeCondition;
+    TTUInt32        i;
+    TTErr           err;
+
+    // stop the record and write it
+    if (inputValue.size() == 0) {
+
+        if (!mRecording)
+            return kTTErrNone;
+
+        mRecordMutex->lock();
+        mRecordValueMutex->lock();
+        mRecording = NO;
+        mRecordValueMutex->unlock();
+        mRecordMutex->unlock();
+
+        for (mTimeConditionList.begin(); mTimeConditionList.end(); mTimeConditionList.next()) {
+
+            aTimeCondition = mTimeConditionList.current()[0];
+            aTimeCondition->unregisterObserverForNotifications(*this);
+        }
+
+        err = writeRecord(mRecordPath);
+
+        clearRecord();
+
+        return err;
+    }
+
+    // start to record
+    if (inputValue.size() == 1) {
+
+        if (inputValue[0].type() == kTypeSymbol && !mRecording && !mReplaying) {
+
+            mRecordPath = inputValue[0];
+
+            // allocate the chunks now : the execution thread only fills them
+            clearRecord();
+
+            for (i = 0; i < SCENARIO_RECORD_CHUNK_COUNT; i++)
+                mRecordedChunks.push_back(new ScenarioRecordEntry[SCENARIO_RECORD_CHUNK_SIZE]);
+
+            // observe the values received by the time conditions
+            for (mTimeConditionList.begin(); mTimeConditionList.end(); mTimeConditionList.next()) {
+
+                aTimeCondition = mTimeConditionList.current()[0];
+                aTimeCondition->registerObserverForNotifications(*this);
+            }
+
+            mRecordMutex->lock();
+            mRecording = YES;
+            mRecordMutex->unlock();
+
+            return kTTErrNone;
+        }
+    }
+
+    return kTTErrGeneric;
+}
+
+TTErr Scenario::Replay(const TTValue& inputValue, TTValue& outputValue)
+{
+    TTSymbol    path;
+    TTErr       err;
+
+    // stop the replay (the triggers and the disposes are listened again)
+    if (inputValue.size() == 0) {
+
+        mReplaying = NO;
+        return kTTErrNone;
+    }
+
+    // start to replay
+    if (inputValue.size() == 1) {
+
+        if (inputValue[0].type() == kTypeSymbol && !mRecording && !mReplaying) {
+
+            // the recorded steps have to be replayed from the first one
+            if (mExecutionGraph && mExecutionGraph->isRunning()) {
+
+                TTLogError("Scenario::Replay : the scenario is running\n");
+                return kTTErrGeneric;
+            }
+
+            path = inputValue[0];
+
+            err = readRecord(path);
+
+            if (!err) {
+
+                mReplayPosition = 0;
+                mReplaying = YES;
+            }
+
+            return err;
+        }
+    }
+
+    return kTTErrGeneric;
+}
+
+TTErr Scenario::ConditionValueReceived(const TTValue& inputValue, TTValue& outputValue)
+{
+    ScenarioRecordValue entry;
+
+    if (!mRecording || inputValue.size() < 2 || !mExecutionGraph)
+        return kTTErrNone;
+
+    entry.step = mExecutionGraph->getNbOfSteps();
+    entry.time = mExecutionGraph->getCurrentTimeInMs();
+    entry.object = inputValue[0];
+    entry.value.copyFrom(inputValue, 1);
+
+    // the receivers can call back from several threads (the execution thread doesn't wait for them)
+    mRecordValueMutex->lock();
+
+    if (mRecording)
+        mRecordedValues.push_back(entry);
+
+    mRecordValueMutex->unlock();
+
+    return kTTErrNone;
+}
+
+void Scenario::recordStep(TTUInt32 time)
+{
+    recordEntry(time, kScenarioRecordStep, NULL);
+}
+
+void Scenario::recordEntry(TTUInt32 time, TTUInt32 kind, TTObjectBasePtr object)
+{
+    ScenarioRecordEntry*    entry;
+    TTUInt32                chunk;
+
+    mRecordMutex->lock();
+
+    if (mRecording) {
+
+        chunk = mRecordedSize / SCENARIO_RECORD_CHUNK_SIZE;
+
+        // only when all the chunks are full the execution thread allocates one (the former entries don't move)
+        if (chunk == mRecordedChunks.size())
+            mRecordedChunks.push_back(new ScenarioRecordEntry[SCENARIO_RECORD_CHUNK_SIZE]);
+
+        entry = &mRecordedChunks[chunk][mRecordedSize % SCENARIO_RECORD_CHUNK_SIZE];
+        entry->step = mExecutionGraph->getNbOfSteps();
+        entry->time = time;
+        entry->kind = kind;
+        entry->object = object;
+
+        mRecordedSize++;
+    }
+
+    mRecordMutex->unlock();
+}
+
+void Scenario::clearRecord()
+{
+    for (TTUInt32 i = 0; i < mRecordedChunks.size(); i++)
+        delete [] mRecordedChunks[i];
+
+    mRecordedChunks.clear();
+    mRecordedSize = 0;
+    mRecordedValues.clear();
+}
+
+TTErr Scenario::writeRecord(TTSymbol path)
+{
+    FILE*                   file;
+    ScenarioRecordEntry*    entry;
+    TTValue                 v;
+    TTSymbol                name;
+    TTString                value;
+    TTUInt32                i, j = 0;
+
+    file = fopen(path.c_str(), "w");
+
+    if (file == NULL) {
+
+        TTLogError("Scenario::Record : can't write %s\n", path.c_str());
+        return kTTErrGeneric;
+    }
+
+    // the names of the events are only looked up now
+    for (i = 0; i <= mRecordedSize; i++) {
+
+        entry = i < mRecordedSize ? &mRecordedChunks[i / SCENARIO_RECORD_CHUNK_SIZE][i % SCENARIO_RECORD_CHUNK_SIZE] : NULL;
+
+        // the values received during a step are written before the inputs of the next step
+        while (j < mRecordedValues.size() && (entry == NULL || mRecordedValues[j].step < entry->step)) {
+
+            mRecordedValues[j].object->getAttributeValue(kTTSym_name, v);
+            name = v[0];
+
+            v = mRecordedValues[j].value;
+            v.toString();
+            value = TTString(v[0]);
+
+            fprintf(file, "%u %u value %s %s\n", mRecordedValues[j].step, mRecordedValues[j].time, name.c_str(), value.c_str());
+            j++;
+        }
+
+        if (entry == NULL)
+            break;
+
+        if (entry->object) {
+
+            entry->object->getAttributeValue(kTTSym_name, v);
+            name = v[0];
+
+            fprintf(file, "%u %u %s %s\n", entry->step, entry->time, sScenarioRecordKindNames[entry->kind], name.c_str());
+        }
+        else
+            fprintf(file, "%u %u %s\n", entry->step, entry->time, sScenarioRecordKindNames[entry->kind]);
+    }
+
+    fclose(file);
+
+    return kTTErrNone;
+}
+
+TTErr Scenario::readRecord(TTSymbol path)
+{
+    FILE*               file;
+    char                line[SCENARIO_RECORD_LINE_SIZE];
+    char                kind[32];
+    char                name[SCENARIO_RECORD_LINE_SIZE];
+    ScenarioRecordEntry entry;
+    TTObjectBasePtr     aTimeEvent;
+    TTValue             v;
+    TTSymbol            eventName, aName;
+    TTUInt32            lineNumber = 0;
+    TTUInt32            i;
+
+    file = fopen(path.c_str(), "r");
+
+    if (file == NULL) {
+
+        TTLogError("Scenario::Replay : can't read %s\n", path.c_str());
+        return kTTErrGeneric;
+    }
+
+    mReplayedSteps.clear();
+
+    while (fgets(line, SCENARIO_RECORD_LINE_SIZE, file)) {
+
+        lineNumber++;
+        name[0] = 0;
+
+        if (sscanf(line, "%u %u %31s %s", &entry.step, &entry.time, kind, name) < 3) {
+
+            TTLogError("Scenario::Replay : line %u of %s is not valid\n", lineNumber, path.c_str());
+            fclose(file);
+            return kTTErrGeneric;
+        }
+
+        for (i = kScenarioRecordStep; i <= kScenarioRecordValue; i++)
+            if (!strcmp(kind, sScenarioRecordKindNames[i]))
+                break;
+
+        if (i > kScenarioRecordValue) {
+
+            TTLogError("Scenario::Replay : line %u of %s : unknown kind %s\n", lineNumber, path.c_str(), kind);
+            fclose(file);
+            return kTTErrGeneric;
+        }
+
+        entry.kind = i;
+        entry.object = NULL;
+
+        // the received values are only there to be read : their effect is recorded as triggers and disposes
+        if (entry.kind == kScenarioRecordValue)
+            continue;
+
+        // find the time event by its name
+        if (entry.kind != kScenarioRecordStep) {
+
+            eventName = TTSymbol(name);
+
+            for (mTimeEventList.begin(); mTimeEventList.end(); mTimeEventList.next()) {
+
+                aTimeEvent = mTimeEventList.current()[0];
+                aTimeEvent->getAttributeValue(kTTSym_name, v);
+                aName = v[0];
+
+                if (aName == eventName) {
+                    entry.object = aTimeEvent;
+                    break;
+                }
+            }
+
+            if (entry.object == NULL) {
+
+                TTLogError("Scenario::Replay : line %u of %s : no event named %s\n", lineNumber, path.c_str(), name);
+                fclose(file);
+                return kTTErrGeneric;
+            }
+        }
+
+        mReplayedSteps.push_back(entry);
+    }
+
+    fclose(file);
+
+    // the triggers and the disposes are processed by the step written after them (a truncated record could miss it)
+    if (mReplayedSteps.size() && mReplayedSteps.back().kind != kScenarioRecordStep) {
+
+        TTLogError("Scenario::Replay : %s doesn't end with a step\n", path.c_str());
+        mReplayedSteps.clear();
+        return kTTErrGeneric;
+    }
+
+    return kTTErrNone;
+}
+
+TTErr Scenario::replaySteps(TTFloat64 scoreTime, TTFloat64 offset)
+{
+    TTUInt32    time;
+    TTBoolean   running = YES;
+
+    // make all the recorded steps which are due
+    while (mReplayPosition < mReplayedSteps.size() && mReplayedSteps[mReplayPosition].time <= scoreTime) {
+
+        // the record and the graph have to make the same steps
+        if (mReplayedSteps[mReplayPosition].step != mExecutionGraph->getNbOfSteps() + 1) {
+
+            TTLogError("Scenario::Replay : the step %u doesn't match the record\n", mExecutionGraph->getNbOfSteps() + 1);
+            mReplaying = NO;
+            return kTTErrGeneric;
+        }
+
+        // give the events processed by this step
+        while (mReplayPosition < mReplayedSteps.size() && mReplayedSteps[mReplayPosition].kind != kScenarioRecordStep) {
+
+            if (mReplayedSteps[mReplayPosition].kind == kScenarioRecordTrigger)
+                mExecutionGraph->putAnEvent(TTPtr(mReplayedSteps[mReplayPosition].object));
+            else
+                mExecutionGraph->deactivateTransition(TransitionPtr(mTransitionsMap[mReplayedSteps[mReplayPosition].object]));
+
+            mReplayPosition++;
+        }
+
+        if (mReplayPosition >= mReplayedSteps.size())
+            break;
+
+        time = mReplayedSteps[mReplayPosition].time;
+        mReplayPosition++;
+
+        running = mExecutionGraph->makeOneStep(time);
+
+        if (!running)
+            break;
+    }
+
+    // at the end of the record, the clock drives the graph again
+    if (mReplayPosition >= mReplayedSteps.size())
+        mReplaying = NO;
+
+    if (!running) {
+
+        mReplaying = NO;
+
+        // Make the end happen
+        return getEndEvent()->sendMessage(kTTSym_Happen);
+    }
+
+    // ask the scheduler to call back at the time of the next recorded step
+    if (mReplaying)
+        mScheduler->setAttributeValue(TTSymbol("wakeUp"), TTFloat64(mReplayedSteps[mReplayPosition].time + offset));
+    else
+        mScheduler->setAttributeValue(TTSymbol("wakeUp"), TTFloat64(0.));
+
+    return kTTErrNone;
+}
+
+void ScenarioGraphStepInputCallBack(TTPtr arg, TTPtr input, TTBoolean isAnEvent)
+{
+    ScenarioPtr             aScenario = (ScenarioPtr) arg;
+    GraphObjectMapIterator  it;
+    TTUInt32                time;
+
+    if (!aScenario->mRecording)
+        return;
+
+    time = aScenario->mExecutionGraph->getCurrentTimeInMs();
+
+    if (isAnEvent) {
+
+        aScenario->recordEntry(time, kScenarioRecordTrigger, TTObjectBasePtr(input));
+    }
+    else {
+
+        // find the event of the deactivated transition
+        it = aScenario->mTransitionEventsMap.find(input);
+
+        if (it == aScenario->mTransitionEventsMap.end())
+            return;
+
+        aScenario->recordEntry(time, kScenarioRecordDispose, TTObjectBasePtr(it->second));
+    }
+}
+
+#endif // NO_EXECUTION_GRAPH
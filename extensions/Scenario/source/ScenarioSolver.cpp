@@ -15,6 +15,8 @@
 
 #include "ScenarioSolver.h"
 
+#include <algorithm>
+
 SolverVariable::SolverVariable(SolverPtr aSolver, TTTimeEventPtr anEvent, SolverValue max):
 event(anEvent), solver(aSolver)
 {
@@ -90,6 +92,10 @@ solver(aSolver)
         endDate = vA[0];
     }
     
+    // the variables know the constraints to move with them
+    startVariable->constraints.push_back(this);
+    endVariable->constraints.push_back(this);
+    
     if (max == 0 || endDate > max)
         return;
     
@@ -103,6 +109,9 @@ solver(aSolver)
 
 SolverConstraint::~SolverConstraint()
 {
+    startVariable->constraints.erase(std::remove(startVariable->constraints.begin(), startVariable->constraints.end(), this), startVariable->constraints.end());
+    endVariable->constraints.erase(std::remove(endVariable->constraints.begin(), endVariable->constraints.end(), this), endVariable->constraints.end());
+    
     // remove FINISHES allen relation between the startVariable and the endVariable from the solver
     solver->removeConstraint(ID);
 }
@@ -170,7 +179,7 @@ solver(aSolver), minBoundID(0), maxBoundID(0)
     
     // update the solver in case of reversed relation
     if (!ordered)
-        solver->updateVariablesValues();
+        solver->updateVariablesValues(IDs, 2);
 }
 
 SolverRelation::~SolverRelation()
@@ -233,7 +242,8 @@ SolverError SolverRelation::limit(SolverValue newDurationMin, SolverValue newDur
         maxBoundID = solver->addConstraint(IDs, coefs, 2, LQ_RELATION, newDurationMax);
     
     // update the solver in any case
-    solver->updateVariablesValues();
+    // (only the variables connected to the relation can change)
+    solver->updateVariablesValues(IDs, 2);
     
     return SolverErrorNone;
 }
\ No newline at end of file
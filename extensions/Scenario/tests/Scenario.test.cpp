@@ -0,0 +1,108 @@
+/** @file
+ *
+ * @ingroup scoreExtension
+ *
+ * @brief Unit test for the Scenario extension
+ *
+ * @see Scenario, TemporalNetwork
+ *
+ * @authors Score contributors
+ *
+ * @copyright Copyright © 2026, Score contributors @n
+ * This code is licensed under the terms of the "CeCILL-C" @n
+ * http://www.cecill.info
+ */
+
+#include "Scenario.test.h"
+#include "temporalNetwork.hpp"
+
+#define thisTTClass			ScenarioTest
+#define thisTTClassName		"scenario.test"
+#define thisTTClassTags		"test, scenario"
+
+TT_BASE_OBJECT_CONSTRUCTOR
+{;}
+
+ScenarioTest::~ScenarioTest()
+{;}
+
+void ScenarioTestTemporalNetwork(int& errorCount, int& testAssertionCount);
+
+void ScenarioTestMain(int& errorCount, int& testAssertionCount)
+{
+	TTTestLog("\n");
+	TTTestLog("Testing Scenario");
+    
+    ScenarioTestTemporalNetwork(errorCount, testAssertionCount);
+}
+
+/** Move the first date of a chain of 10 dates linked by rigid intervals of 10 : the move is propagated along the chain,
+    a move pushing the last date out of its domain is refused, and a cycle of intervals which can't be satisfied is reported */
+void ScenarioTestTemporalNetwork(int& errorCount, int& testAssertionCount)
+{
+    TemporalNetwork chain, cycle;
+    vector<int>     ids;
+    TTBoolean       consistent = YES, moved;
+    TTUInt32        i;
+    
+    TTTestLog("\n");
+	TTTestLog("Testing the temporal network");
+    
+    for (i = 0; i < 10; i++) {
+        
+        chain.setNode(i, 0, 1000, i * 10);
+        ids.push_back(i);
+    }
+    
+    for (i = 0; i < 9; i++) {
+        
+        chain.addEdge(i, i, i + 1, 10, 10);
+        consistent = consistent && chain.propagate(i, i + 1, 10);
+    }
+    
+    TTTestAssertion("Chain consistent", consistent, testAssertionCount, errorCount);
+    
+    // fix the first date at 50 : the other dates follow it
+    for (i = 0; i < 10; i++)
+        chain.suggest(i, i == 0 ? 50 : i * 10, 0, 1000, i == 0);
+    
+    moved = chain.solve(ids);
+    
+    for (i = 0; moved && i < 10; i++)
+        moved = chain.getValue(i) == TTInt32(50 + i * 10);
+    
+    TTTestAssertion("Fixed date moved along the chain", moved, testAssertionCount, errorCount);
+    
+    // fix the first date at 950 : the last date would be 1040
+    for (i = 0; i < 10; i++)
+        chain.suggest(i, i == 0 ? 950 : chain.getValue(i), 0, 1000, i == 0);
+    
+    TTTestAssertion("Infeasible move refused", !chain.solve(ids), testAssertionCount, errorCount);
+    
+    // b = a + 5 and c = b + 5 then a = c : the last edge closes a negative cycle
+    cycle.setNode(0, 0, 100000, 0);
+    cycle.setNode(1, 0, 100000, 5);
+    cycle.setNode(2, 0, 100000, 10);
+    
+    cycle.addEdge(0, 0, 1, 5, 5);
+    consistent = cycle.propagate(0, 1, 3);
+    
+    cycle.addEdge(1, 1, 2, 5, 5);
+    consistent = consistent && cycle.propagate(1, 2, 3);
+    
+    TTTestAssertion("Cycle consistent before closing it", consistent, testAssertionCount, errorCount);
+    
+    cycle.addEdge(2, 2, 0, 0, 0);
+    
+    TTTestAssertion("Negative cycle reported", !cycle.propagate(2, 0, 3), testAssertionCount, errorCount);
+}
+
+TTErr ScenarioTest::test(TTValue& returnedTestInfo)
+{
+	int	errorCount = 0;
+	int testAssertionCount = 0;
+	
+	ScenarioTestMain(errorCount, testAssertionCount);
+	
+	return TTTestFinish(testAssertionCount, errorCount, returnedTestInfo);
+}
@@ -0,0 +1,32 @@
+/** @file
+ *
+ * @ingroup scoreExtension
+ *
+ * @brief Unit test for the Scenario extension
+ *
+ * @details The unit test checks the Simple Temporal Network used by the edition solver @n@n
+ *
+ * @see Scenario, TemporalNetwork
+ *
+ * @authors Score contributors
+ *
+ * @copyright Copyright © 2026, Score contributors @n
+ * This code is licensed under the terms of the "CeCILL-C" @n
+ * http://www.cecill.info
+ */
+
+#ifndef __SCENARIO_TEST_H__
+#define __SCENARIO_TEST_H__
+
+#include "TTObjectBase.h"
+#include "TTUnitTest.h"
+
+/**	Provide unit tests for the Scenario extension */
+class ScenarioTest : public TTObjectBase {
+	TTCLASS_SETUP(ScenarioTest)
+		
+	virtual TTErr test(TTValue& returnedTestInfo);
+};
+
+
+#endif // __SCENARIO_TEST_H__
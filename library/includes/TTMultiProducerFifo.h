@@ -0,0 +1,183 @@
+/** @file
+ *
+ * @ingroup scoreLibrary
+ *
+ * @brief a bounded First-in/First-out buffer for many writing threads and one reading thread
+ *
+ * @details The TTMultiProducerFifo class extends the TTFifo principle (a power of two number of slots, no lock, no allocation once created)
+ * to several writing threads : each slot has its own sequence counter and the writers reserve a slot with a compare and swap. @n
+ * Only one thread can read the buffer. @n@n
+ *
+ * @see TTFifo, TTTimeClock
+ *
+ * @authors Théo de la Hogue & Clément Bossut
+ *
+ * @copyright Copyright © 2013, Théo de la Hogue & Clément Bossut @n
+ * This code is licensed under the terms of the "CeCILL-C" @n
+ * http://www.cecill.info
+ */
+
+#ifndef __TT_MULTI_PRODUCER_FIFO_H__
+#define __TT_MULTI_PRODUCER_FIFO_H__
+
+#include "TTBase.h"
+#include "TTLimits.h"
+
+#include <vector>
+
+#ifdef TT_PLATFORM_WIN
+#include <intrin.h>
+#pragma intrinsic (_InterlockedCompareExchange)
+#pragma intrinsic (_InterlockedExchange)
+#endif
+
+/** Compare the value with an old value and replace it by a new value if they are equal (with a full barrier)
+ @return                        YES if the value have been replaced */
+inline TTBoolean TTAtomicCompareAndSwapWithBarrier(TTAtomicUInt& value, TTUInt32 oldValue, TTUInt32 newValue)
+{
+#ifdef TT_PLATFORM_WIN
+	return _InterlockedCompareExchange((volatile long*)&value, (long)newValue, (long)oldValue) == (long)oldValue;
+#else
+	return __sync_bool_compare_and_swap(&value, oldValue, newValue);
+#endif
+}
+
+/** Order all the memory accesses done before this call before all the ones done after */
+inline void TTAtomicMemoryBarrier()
+{
+#ifdef TT_PLATFORM_WIN
+	long barrier;
+	_InterlockedExchange(&barrier, 0);
+#else
+	__sync_synchronize();
+#endif
+}
+
+/**	a bounded First-in/First-out buffer that is non-blocking and thread-safe for writing from several threads
+ and reading from another single thread.
+
+ @see TTFifo
+ */
+template<class T>
+class TTMultiProducerFifo {
+
+protected:
+
+	/** Define a slot of the buffer with its sequence counter :
+	 when the sequence equals the write position the slot is free, when it equals the write position + 1 the item is ready to be read */
+	struct TTMultiProducerFifoSlot {
+		TTAtomicUInt					sequence;
+		T								item;
+	};
+
+	typedef std::vector<TTMultiProducerFifoSlot>	TTMultiProducerFifoSlotVector;
+
+	TTAtomicUInt						mWritePosition;			///< the next position to write -- modified by all the producers
+	TTUInt32							mReadPosition;			///< the next position to read -- only modified by the consumer
+	TTUInt32							mSlotCount;				///< count of slots -- power of 2, used as a bitmask
+	TTMultiProducerFifoSlotVector		mSlots;
+
+public:
+
+	/** Create the buffer
+	 @param	slotCount					if it is not a power of two, it will be increased to the next-higher power of two */
+	TTMultiProducerFifo(TTUInt32 slotCount) :
+	mWritePosition(0),
+	mReadPosition(0)
+	{
+		TTLimitPowerOfTwo(slotCount);
+
+		mSlotCount = slotCount;
+		mSlots.resize(mSlotCount);
+
+		for (TTUInt32 i = 0; i < mSlotCount; i++)
+			mSlots[i].sequence = i;
+	}
+
+	virtual ~TTMultiProducerFifo()
+	{
+		;
+	}
+
+	int size()
+	{
+		return mSlotCount;
+	}
+
+	enum TTMultiProducerFifoWriteStatus {
+		kBufferWriteSuccessful = 0,
+		kBufferFull
+	};
+
+	/** Copy an item into the buffer (from any thread) */
+	TTMultiProducerFifoWriteStatus push(const T& item)
+	{
+		TTMultiProducerFifoSlot*	slot;
+		TTUInt32					position, sequence;
+		TTInt32						difference;
+
+		position = mWritePosition;
+
+		// reserve a slot
+		while (true) {
+
+			slot = &mSlots[position & (mSlotCount - 1)];	// fast modulo for power of 2
+			sequence = slot->sequence;
+			difference = TTInt32(sequence - position);
+
+			// the slot is free : try to take it before another producer
+			if (difference == 0) {
+
+				if (TTAtomicCompareAndSwapWithBarrier(mWritePosition, position, position + 1))
+					break;
+
+				position = mWritePosition;
+			}
+
+			// the slot have not been read yet : the buffer is full
+			else if (difference < 0)
+				return kBufferFull;
+
+			// another producer took the slot
+			else
+				position = mWritePosition;
+		}
+
+		slot->item = item;								// copy
+
+		TTAtomicMemoryBarrier();
+		slot->sequence = position + 1;					// the item is ready to be read
+
+		return kBufferWriteSuccessful;
+	}
+
+	enum TTMultiProducerFifoReadStatus {
+		kBufferReadSuccessful = 0,
+		kBufferEmpty
+	};
+
+	/** Copy the next item and pop it from the buffer (from the reading thread only) */
+	TTMultiProducerFifoReadStatus pop(T& item)
+	{
+		TTMultiProducerFifoSlot*	slot;
+		TTUInt32					position = mReadPosition;
+
+		slot = &mSlots[position & (mSlotCount - 1)];	// fast modulo for power of 2
+
+		// the slot is still free or a producer is writing it
+		if (TTInt32(slot->sequence - (position + 1)) < 0)
+			return kBufferEmpty;
+
+		TTAtomicMemoryBarrier();
+		item = slot->item;								// copy
+		slot->item = T();								// don't keep a copy of the item into the buffer
+
+		TTAtomicMemoryBarrier();
+		slot->sequence = position + mSlotCount;			// the slot is free for the next round
+		mReadPosition = position + 1;
+
+		return kBufferReadSuccessful;
+	}
+};
+
+#endif // __TT_MULTI_PRODUCER_FIFO_H__
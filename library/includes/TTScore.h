@@ -54,5 +54,6 @@
 #include "TTScoreSymbolCache.h"
 
 #include "TTScore.test.h"
+#include "TTScore.benchmark.h"
 
 #endif // __TT_SCORE_H__
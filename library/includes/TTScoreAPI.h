@@ -17,8 +17,10 @@
 
 #include "TTScore.h"
 #include "Expression.h"
+#include "TTTimeClock.h"
 #include "TTTimeEvent.h"
 #include "TTTimeProcess.h"
+#include "TTTimeRender.h"
 #include "TTTimeContainer.h"
 #include "TTTimeCondition.h"
 
@@ -149,6 +151,40 @@ TTErr TTSCORE_EXPORT TTScoreTimeProcessEndCallbackCreate(TTTimeProcessPtr timePr
  @return                        kTTErrGeneric if the deletion fails */
 TTErr TTSCORE_EXPORT TTScoreTimeProcessEndCallbackRelease(TTTimeProcessPtr timeProcess, TTObjectBasePtr *endCallback);
 
+/*
+    Functions for the clock
+ */
+
+/** Drive the clock of all time processes by the host instead of an internal thread
+ @param external                YES to advance the time only when TTScoreClockTick is called
+ @return                        kTTErrGeneric if the operation fails */
+TTErr TTSCORE_EXPORT TTScoreClockSetExternal(const TTBoolean external);
+
+/** Run the clock of all time processes with a real time priority on a dedicated cpu (Linux only)
+ @param priority                a SCHED_FIFO priority (0 to use the default scheduling policy)
+ @param cpu                     the index of a cpu (-1 to run on any cpu)
+ @return                        kTTErrGeneric if the platform doesn't support it */
+TTErr TTSCORE_EXPORT TTScoreClockSetRealTime(const TTInt32 priority, const TTInt32 cpu = -1);
+
+/** Advance the clock of all time processes
+ @param deltaTime               the time elapsed (in ms)
+ @return                        kTTErrGeneric if the clock is not driven by the host */
+TTErr TTSCORE_EXPORT TTScoreClockTick(const TTFloat64 deltaTime);
+
+/** Advance the clock of all time processes of a number of samples
+ @param sampleCount             the number of samples elapsed
+ @param sampleRate              the sample rate (in Hz)
+ @return                        kTTErrGeneric if the clock is not driven by the host */
+TTErr TTSCORE_EXPORT TTScoreClockTick(const TTUInt32 sampleCount, const TTUInt32 sampleRate);
+
+/** Render a time container offline as fast as possible
+ @param timeContainer           the time container to render
+ @param outputFile              the path of the file where to write the timestamped outputs
+ @param inputFile               the path of a file containing the triggers to do (optional)
+ @param step                    the time (in ms) the clock advances at each render step (default : 1.)
+ @return                        kTTErrGeneric if the render fails */
+TTErr TTSCORE_EXPORT TTScoreRender(TTTimeContainerPtr timeContainer, const std::string outputFile, const std::string inputFile = "", const TTFloat64 step = 1.);
+
 #if 0
 #pragma mark -
 #pragma mark some internal functions
@@ -25,6 +25,7 @@ extern TTSCORE_EXPORT TTSymbol  kTTSym_TimeEvent;
 
 // notifications
 extern TTSCORE_EXPORT TTSymbol  kTTSym_ConditionReadyChanged;
+extern TTSCORE_EXPORT TTSymbol  kTTSym_ConditionValueReceived;
 extern TTSCORE_EXPORT TTSymbol	kTTSym_EventDateChanged;
 extern TTSCORE_EXPORT TTSymbol	kTTSym_EventStatusChanged;
 extern TTSCORE_EXPORT TTSymbol	kTTSym_ProcessStarted;
@@ -0,0 +1,282 @@
+/** @file
+ *
+ * @ingroup scoreLibrary
+ *
+ * @brief a scheduler driven by a clock shared between all time processes
+ *
+ * @details The TTTimeClock class is a Scheduler without its own thread :
+ * each running TTTimeClock is registered into a single clock service which ticks all of them from one thread, in the order they started. @n
+ * This keeps the number of threads constant whatever the number of time processes is
+ * and avoids independent timing loops to drift apart. @n
+ * The clock service can also be driven by the host (an audio callback, a test, ...) : in this external mode
+ * there is no thread and no wall clock, the time only advances when the host calls TTTimeClock::tick. @n
+ * On Linux, the clock service thread sleeps to absolute deadlines of a monotonic clock
+ * and it can run with a SCHED_FIFO priority on a dedicated cpu. @n
+ * The clock service thread doesn't tick at a fixed rate : it sleeps until the nearest date one of the clocks needs a tick
+ * (see wakeUp attribute) or until it is woken up by an external trigger, so it uses no cpu while all clocks are paused, stopped or waiting. @n
+ * The position of a clock can follow a speed curve (see TTTimeSpeedMap) and a clock can follow the speed of a master clock
+ * (the clock of its container) which is read at each tick instead of being propagated at each change. @n
+ * The control messages (Start, Play, Stop, Pause, Resume, Goto, ...) sent from other threads are posted into a lock-free command queue
+ * and they are applied at the beginning of the next tick by the thread which ticks the clocks (see TTTimeClock::post). @n@n
+ *
+ * @see TTTimeProcess, Scheduler
+ *
+ * @authors Théo de la Hogue & Clément Bossut
+ *
+ * @copyright Copyright © 2013, Théo de la Hogue & Clément Bossut @n
+ * This code is licensed under the terms of the "CeCILL-C" @n
+ * http://www.cecill.info
+ */
+
+#ifndef __TT_TIME_CLOCK_H__
+#define __TT_TIME_CLOCK_H__
+
+#include "TTScore.h"
+#include "TTThread.h"
+#include "TTMutex.h"
+#include "TTMultiProducerFifo.h"
+#include "TTTimeSpeedMap.h"
+
+#include <vector>
+
+class TTTimeClock;
+typedef TTTimeClock* TTTimeClockPtr;
+
+/** Define a vector to store the clocks to tick in a defined order */
+typedef std::vector<TTTimeClockPtr>     TTTimeClockVector;
+
+/** Define a structure to store a message to send to an object at the next tick of the clock service */
+struct TTTimeClockCommand {
+
+    TTObjectBasePtr                 object;                         ///< the object to send the message to (referenced until the message is sent)
+    TTSymbol                        message;                        ///< the name of the message
+    TTValue                         argument;                       ///< the argument of the message
+
+    TTTimeClockCommand() : object(NULL) {};
+};
+
+/** Define a queue to post commands from any thread to the clock service */
+typedef TTMultiProducerFifo<TTTimeClockCommand>     TTTimeClockCommandQueue;
+
+/**	a scheduler driven by a clock shared between all time processes
+
+ A TTTimeClock provides the same attributes and messages than any Scheduler plugin (duration, offset, speed, progression, realTime, Go, Stop, Pause, Resume)
+ but it is ticked by the clock service instead of having its own thread.
+
+ @see TTTimeProcess, Scheduler
+ */
+class TTSCORE_EXPORT TTTimeClock : public Scheduler {
+
+    TTCLASS_SETUP(TTTimeClock)
+
+    TTFloat64                   mGranularity;                   ///< ATTRIBUTE : the minimal time (in ms) between two callback calls
+    TTFloat64                   mWakeUp;                        ///< ATTRIBUTE : the position (in ms) when the callback needs to be called again (0 to call it each granularity, < 0 to call it only when the clock service is woken up)
+    TTObjectBasePtr             mMaster;                        ///< ATTRIBUTE : a clock to follow the speed of (the clock of the container)
+
+    TTTimeSpeedMap              mSpeedMap;                      ///< the speed curve to follow (the speed attribute is ignored when it is not empty)
+    TTFloat64                   mStartWallDate;                 ///< the wall date (in ms) of the speed curve when the realTime was 0
+
+    TTFloat64                   mPosition;                      ///< the current date (in ms) of the clock including speed factor and offset
+    TTFloat64                   mLastCallback;                  ///< the realTime (in ms) of the last callback call
+
+    TTUInt32                    mIndex;                         ///< the index of the clock into the registered clocks vector
+    TTBoolean                   mRegistered;                    ///< is the clock registered into the clock service ?
+    TTBoolean                   mCallbackRequested;             ///< does the callback have to be called at the next tick whatever the wakeUp date is ?
+
+    /** Get specific parameters names needed by this scheduler
+     @param	value           the returned parameter names
+     @return                kTTErrNone */
+	TTErr           getParameterNames(TTValue& value);
+
+    /** Register the clock into the clock service and start it from the offset
+     a clock without duration ends at its first tick (the callback is called once with a progression of 1)
+     @return                kTTErrNone */
+    TTErr           Go();
+
+    /** Stop the clock and unregister it from the clock service
+     @return                kTTErrNone */
+    TTErr           Stop();
+
+    /** Pause the clock progression
+     @return                kTTErrNone */
+    TTErr           Pause();
+
+    /** Resume the clock progression
+     @return                kTTErrNone */
+    TTErr           Resume();
+
+    /** Advance the clock of the last time elapsed in the clock service
+     @return                kTTErrNone */
+    TTErr           Tick();
+    
+    /** Advance the clock of a given time, whatever the clock service mode is
+     @param	inputValue      a time (in ms) or a number of samples and a sample rate
+     @param	outputValue     nothing
+     @return                kTTErrGeneric if the input value is not valid */
+    TTErr           Step(const TTValue& inputValue, TTValue& outputValue);
+
+    /** Advance the clock of a time elapsed and call the progression callback if needed
+     @param	deltaTime       a time (in ms) without speed factor consideration
+     @return                kTTErrNone */
+    TTErr           advance(TTFloat64 deltaTime);
+
+    /** Get the time (in ms) before the clock needs to be ticked
+     @return                the remaining time or DBL_MAX if the clock doesn't need to be ticked */
+    TTFloat64       getRemainingTime();
+
+    /** Get the time (in ms) before the clock reaches a position
+     @param	position        a position (in ms)
+     @return                the time or DBL_MAX if the clock doesn't move forward */
+    TTFloat64       getTimeToPosition(TTFloat64 position);
+
+    /** Get how late (in ms) was the last tick of the clock service thread
+     @param	value           the returned lateness
+     @return                kTTErrNone */
+    TTErr           getLateness(TTValue& value);
+    
+    /** Get how late (in ms) the clock service thread have been since it started
+     @param	value           the returned drift
+     @return                kTTErrNone */
+    TTErr           getDrift(TTValue& value);
+
+    /** Set the granularity attribute
+     @param	value           a new granularity (in ms)
+     @return                kTTErrGeneric if the value is not a single TTFloat64 > 0. */
+    TTErr           setGranularity(const TTValue& value);
+
+    /** Set the wakeUp attribute and wake up the clock service thread to consider it
+     @param	value           a position (in ms), 0 or a negative value
+     @return                kTTErrGeneric if the value is not a single TTFloat64 */
+    TTErr           setWakeUp(const TTValue& value);
+
+    /** Set the master attribute
+     @param	value           a TimeClock object or NULL
+     @return                kTTErrGeneric if the object is not a TimeClock */
+    TTErr           setMaster(const TTValue& value);
+
+    /** Get the speed curve
+     @param	value           the returned list of <position in ms, speed> couples
+     @return                kTTErrNone */
+    TTErr           getSpeedMap(TTValue& value);
+
+    /** Set the speed curve keeping the current position
+     @param	value           a list of <position in ms, speed> couples (an empty list to use the speed attribute again)
+     @return                kTTErrGeneric if the speed curve is not valid */
+    TTErr           setSpeedMap(const TTValue& value);
+
+
+    static TTTimeClockVector    sClocks;                        ///< all the clocks registered into the clock service
+    static TTUInt32             sClocksToRemove;                ///< how many clocks have been unregistered since the last tick
+    static TTFloat64            sDeltaTime;                     ///< the time (in ms) elapsed since the last tick of the clock service
+    static TTUInt32             sPeriod;                        ///< the time (in ms) the clock service sleeps between two ticks
+    static TTUInt32             sInstanceCount;                 ///< how many clocks exist
+    static TTThreadPtr          sThread;                        ///< the clock service thread
+    static std::vector<TTThreadPtr> sStoppedThreads;            ///< the clock service threads stopped from a tick which still have to be waited
+    static TTBoolean            sThreadRunning;                 ///< is the clock service thread running ? (protected by the wake up mutex)
+    static TTUInt32             sThreadGeneration;              ///< which clock service thread is running (protected by the wake up mutex)
+    static TTMutexPtr           sMutex;                         ///< to protect the registered clocks vector
+    static TTBoolean            sExternal;                      ///< is the clock service driven by the host instead of its own thread ?
+    static TTInt32              sPriority;                      ///< the SCHED_FIFO priority of the clock service thread (0 means no real time priority)
+    static TTInt32              sCpu;                           ///< the cpu where to run the clock service thread (-1 means any cpu)
+    static TTBoolean            sRealTimeChanged;               ///< have the priority or the cpu changed since the last tick ?
+    static TTFloat64            sLateness;                      ///< how late (in ms) was the last tick (protected by the wake up mutex)
+    static TTFloat64            sDrift;                         ///< how late (in ms) the clock service thread have been since it started (protected by the wake up mutex)
+    static TTBoolean            sWakeRequested;                 ///< has the clock service thread been woken up since the last tick ? (protected by the wake up mutex)
+    static TTBoolean            sWoken;                         ///< is the current tick due to a wake up ?
+    static TTTimeClockCommandQueue* sCommands;                  ///< the commands posted to be applied at the next tick
+
+    /** Register a clock into the clock service (and launch the clock service thread if needed)
+     @param	aClock          a clock to tick
+     @return                kTTErrNone */
+    static TTErr    registerClock(TTTimeClockPtr aClock);
+
+    /** Unregister a clock from the clock service
+     @param	aClock          a clock to stop ticking
+     @return                kTTErrGeneric if the clock is not registered */
+    static TTErr    unregisterClock(TTTimeClockPtr aClock);
+
+    /** Send all the posted commands to their object
+     note : this is done at the beginning of each tick */
+    static void     applyCommands();
+
+    /** Tick all registered clocks in their registration order
+     @param	deltaTime       the time (in ms) elapsed since the last tick */
+    static void     tickClocks(TTFloat64 deltaTime);
+
+    /** Get the time (in ms) before one of the registered clocks needs to be ticked
+     @return                the remaining time or DBL_MAX if no clock needs to be ticked */
+    static TTFloat64 getNextTickTime();
+
+    /** Launch the clock service thread if it is needed and not running
+     note : the mutex have to be locked before */
+    static void     launchThread();
+
+    /** Stop the clock service thread
+     note : the mutex have to be locked before and the returned thread have to be waited and deleted after unlocking it
+     @return                the thread to wait (or NULL if there was no thread) */
+    static TTThreadPtr haltThread();
+
+    /** Wait and delete the clock service threads which have been stopped from a tick
+     note : the mutex have to be unlocked and nothing is done when it is called from a tick (the thread can't wait for itself) */
+    static void     joinStoppedThreads();
+
+public:
+
+    /** Drive the clock service by the host instead of its own thread
+     in the external mode, the time only advances when tick is called (no thread, no wall clock)
+     @param	external        YES to drive the clock service by the host, NO to use the internal thread
+     @return                kTTErrNone */
+    static TTErr    setExternal(TTBoolean external);
+
+    /** Is the clock service driven by the host ?
+     @return                YES if the clock service is in external mode */
+    static TTBoolean isExternal();
+
+    /** Run the clock service thread with a real time priority and on a dedicated cpu
+     note : this is only available on Linux
+     @param	priority        a SCHED_FIFO priority (0 to use the default scheduling policy)
+     @param	cpu             the index of a cpu (-1 to run on any cpu)
+     @return                kTTErrGeneric if the platform doesn't support it */
+    static TTErr    setRealTime(TTInt32 priority, TTInt32 cpu);
+
+    /** Wake up the clock service thread to tick the clocks as soon as possible
+     each clock with a wakeUp date calls its callback at the next tick :
+     this have to be called when something happens outside the clock service (an interactive event, a speed change, ...) */
+    static void     wake();
+
+    /** Is the calling thread the one which is ticking the clocks right now ?
+     the control messages have to be posted when it is not
+     @return                YES if the calling thread is ticking the clocks */
+    static TTBoolean isExecutionThread();
+
+    /** Post a message to send to an object at the beginning of the next tick (from any thread)
+     the object is referenced until the message is sent
+     @param	anObject        an object
+     @param	aMessage        a message name
+     @param	anArgument      an argument for the message
+     @return                kTTErrGeneric if the command queue is full */
+    static TTErr    post(TTObjectBasePtr anObject, TTSymbol aMessage, const TTValue& anArgument = TTValue());
+
+    /** Advance all registered clocks of a time
+     this method is meant to be called by the host in external mode
+     @param	deltaTime       a time (in ms)
+     @return                kTTErrGeneric if the clock service is not in external mode */
+    static TTErr    tick(TTFloat64 deltaTime);
+
+    /** Advance all registered clocks of a number of samples
+     this method is meant to be called by the host in external mode (from an audio callback for example)
+     @param	sampleCount     a number of samples
+     @param	sampleRate      the sample rate (in Hz)
+     @return                kTTErrGeneric if the clock service is not in external mode or if the sample rate is 0 */
+    static TTErr    tick(TTUInt32 sampleCount, TTUInt32 sampleRate);
+
+    friend void* TTTimeClockThreadCallback(void* anArgument);
+    friend struct TTTimeClockShutdown;
+};
+
+/** The clock service thread callback
+ @param	anArgument          the generation of the thread
+ @return                    NULL */
+void* TTTimeClockThreadCallback(void* anArgument);
+
+#endif // __TT_TIME_CLOCK_H__
@@ -42,6 +42,17 @@ private :
      @return                kTTErrGeneric if mTimeProcessList is empty */
     TTErr           getTimeProcesses(TTValue& value);
     
+    /** Get the speed curve of the container scheduler
+     @param value           the returned list of <date in ms, speed> couples
+     @return                kTTErrNone */
+    TTErr           getSpeedMap(TTValue& value);
+    
+    /** Set the speed curve of the container scheduler
+     the time processes of the container follow it too
+     @param value           a list of <date in ms, speed> couples (an empty list to use a constant speed again)
+     @return                kTTErrGeneric if the speed curve is not valid */
+    TTErr           setSpeedMap(const TTValue& value);
+    
     /** Get all time events objects
      @param value           all time events objects
      @return                kTTErrGeneric if mTimeEventList is empty */
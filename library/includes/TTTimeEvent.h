@@ -19,6 +19,7 @@
 #define __TT_TIME_EVENT_H__
 
 #include "TTScore.h"
+#include "TTTimeRender.h"
 
 /** \ingroup enums
  Event status flag
@@ -88,6 +89,10 @@ private :
      @return                an error code returned by the happen method */
     TTErr           Dispose();
     
+    /** Write each command of the state into the running render file instead of recalling the state
+     @return                kTTErrNone */
+    TTErr           RenderState();
+    
     /**  needed to be handled by a TTXmlHandler
      @param	inputValue      ..
      @param	outputValue     ..
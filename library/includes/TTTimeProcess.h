@@ -20,6 +20,7 @@
 
 #include "TTScore.h"
 #include "TTTimeEvent.h"
+#include "TTTimeClock.h"
 
 /**	a class to define a process
  
@@ -48,7 +49,7 @@ protected :
     TTUInt32                        mVerticalPosition;              ///< the Y axe position of the process (useful for gui)
     TTUInt32                        mVerticalSize;                  ///< the Y axe size of the process (useful for gui)
     
-    TTObjectBasePtr                 mScheduler;                     ///< the scheduler object which handles the time process execution
+    TTObjectBasePtr                 mScheduler;                     ///< the scheduler object which handles the time process execution (a TTTimeClock ticked by the shared clock service)
     
     TTBoolean                       mRunning;                       ///< a boolean to get the running state of the process
                                                                     ///< it is related to the running state of the scheduler
@@ -0,0 +1,96 @@
+/** @file
+ *
+ * @ingroup scoreLibrary
+ *
+ * @brief a class to render a time container offline
+ *
+ * @details The TTTimeRender class allows to play a time container as fast as possible without sending anything on the network :
+ * every address and value which would have been sent by the time events states and the time processes is written into a timestamped file instead. @n
+ * The interactive events can be triggered from a script file where each line is made of a date (in ms) and an event name. @n@n
+ *
+ * @see TTTimeContainer, TTTimeClock
+ *
+ * @authors Théo de la Hogue & Clément Bossut
+ *
+ * @copyright Copyright © 2013, Théo de la Hogue & Clément Bossut @n
+ * This code is licensed under the terms of the "CeCILL-C" @n
+ * http://www.cecill.info
+ */
+
+#ifndef __TT_TIME_RENDER_H__
+#define __TT_TIME_RENDER_H__
+
+#include "TTScore.h"
+
+#include <stdio.h>
+#include <vector>
+
+/** Define a structure to store a trigger read from the input file */
+struct TTTimeRenderTrigger {
+
+    TTFloat64                       date;                           ///< when the trigger have to be done (in ms)
+    TTSymbol                        name;                           ///< the name of the time event to trigger
+};
+
+/** Define a vector to store the triggers in time order */
+typedef std::vector<TTTimeRenderTrigger>    TTTimeRenderTriggerVector;
+
+/**	a class to render a time container offline
+
+ The TTTimeRender class drives the clock of all time processes by itself (see TTTimeClock external mode)
+ and catches all outputs into a file instead of sending them.
+
+ @see TTTimeContainer, TTTimeClock
+ */
+class TTSCORE_EXPORT TTTimeRender : public TTObjectBase {
+
+    TTCLASS_SETUP(TTTimeRender)
+
+private :
+
+    TTObjectBasePtr                 mContainer;                     ///< ATTRIBUTE : the time container to render
+    TTFloat64                       mStep;                          ///< ATTRIBUTE : the time (in ms) the clock advances at each render step
+    TTSymbol                        mInputFile;                     ///< ATTRIBUTE : the path of a file containing the triggers to do (optional)
+    TTSymbol                        mOutputFile;                    ///< ATTRIBUTE : the path of the file where to write the outputs
+
+    TTFloat64                       mDate;                          ///< the current date of the render (in ms)
+    FILE*                           mOutput;                        ///< the output file while rendering
+
+    TTTimeRenderTriggerVector       mTriggers;                      ///< the triggers read from the input file
+
+    /** Set the step attribute
+     @param	value           a new step (in ms)
+     @return                kTTErrGeneric if the value is not a single TTFloat64 > 0. */
+    TTErr           setStep(const TTValue& value);
+
+    /** Render the time container from the beginning to the end
+     @return                an error code if the render fails */
+    TTErr           Render();
+
+    /** Read the triggers from the input file
+     each line of the file is : <date in ms> <time event name>
+     @return                kTTErrGeneric if the file can't be opened */
+    TTErr           readTriggers();
+
+    /** Write an address and a value into the output file with the current date
+     @param	address         an address
+     @param	value           a value */
+    void            write(const TTSymbol& address, const TTValue& value);
+
+    friend TTBoolean TTSCORE_EXPORT TTTimeRenderIsRunning();
+    friend void TTSCORE_EXPORT TTTimeRenderOutput(const TTSymbol& address, const TTValue& value);
+};
+
+typedef TTTimeRender* TTTimeRenderPtr;
+
+/** Is an offline render running ?
+ when it is, time events and time processes have to call TTTimeRenderOutput instead of sending their outputs
+ @return                    YES if a render is running */
+TTBoolean TTSCORE_EXPORT TTTimeRenderIsRunning();
+
+/** Write an output into the running render file
+ @param	address             an address
+ @param	value               the value which would have been sent to the address */
+void TTSCORE_EXPORT TTTimeRenderOutput(const TTSymbol& address, const TTValue& value);
+
+#endif // __TT_TIME_RENDER_H__
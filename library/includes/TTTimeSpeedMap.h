@@ -0,0 +1,105 @@
+/** @file
+ *
+ * @ingroup scoreLibrary
+ *
+ * @brief a TTTimeSpeedMap is a piecewise speed curve to convert score time into wall time and back
+ *
+ * @details The TTTimeSpeedMap class stores a list of points made of a score date and a speed : between two points the speed changes linearly with the score time.
+ * Before the first point and after the last point the speed is constant. @n
+ * The wall time to reach each point is cumulated when the points are set so any conversion between score time and wall time
+ * only needs a binary search (O(log n)) and a closed form on one segment. @n@n
+ *
+ * @see TTTimeClock
+ *
+ * @authors Théo de la Hogue & Clément Bossut
+ *
+ * @copyright Copyright © 2013, Théo de la Hogue & Clément Bossut @n
+ * This code is licensed under the terms of the "CeCILL-C" @n
+ * http://www.cecill.info
+ */
+
+#ifndef __TT_TIME_SPEED_MAP_H__
+#define __TT_TIME_SPEED_MAP_H__
+
+#include "TTScore.h"
+
+#include <vector>
+
+/** Define a structure to store a point of the speed curve */
+struct TTTimeSpeedMapPoint {
+
+    TTFloat64                       date;                           ///< the score date of the point (in ms)
+    TTFloat64                       speed;                          ///< the speed at this date
+    TTFloat64                       wallDate;                       ///< the wall time (in ms) needed to go from the score date 0 to this point
+};
+
+/** Define a vector to store the points in date order */
+typedef std::vector<TTTimeSpeedMapPoint>    TTTimeSpeedMapPointVector;
+
+/**	The TTTimeSpeedMap class converts score time into wall time and back following a piecewise speed curve
+
+ @see TTTimeClock
+ */
+class TTSCORE_EXPORT TTTimeSpeedMap
+{
+private :
+
+    TTTimeSpeedMapPointVector               mPoints;                        ///< the points sorted by date with their cumulated wall date
+
+    /** Get the index of the last point before a score date
+     @param date            a score date (in ms)
+     @return                an index or -1 if the date is before the first point */
+    TTInt32         findDate(TTFloat64 date) const;
+
+    /** Get the index of the last point before a wall date
+     @param wallDate        a wall date (in ms)
+     @return                an index or -1 if the wall date is before the first point */
+    TTInt32         findWallDate(TTFloat64 wallDate) const;
+
+    /** Get the slope of the speed between a point and the next one
+     @param index           a point index
+     @return                the speed change per ms of score time (0 for the last point) */
+    TTFloat64       getSlope(TTUInt32 index) const;
+
+public:
+
+    /** TTTimeSpeedMap Constructor */
+    TTTimeSpeedMap()
+    {;}
+
+    /** TTTimeSpeedMap Destructor */
+    virtual ~TTTimeSpeedMap()
+    {;}
+
+    /** Set the points of the speed curve
+     @param value           a list of <score date in ms, speed> couples (an empty list clears the curve)
+     @return                kTTErrGeneric if the list is not made of couples, if a speed is not > 0 or if two points have the same date */
+    TTErr           set(const TTValue& value);
+
+    /** Get the points of the speed curve
+     @param value           the returned list of <score date in ms, speed> couples */
+    void            get(TTValue& value) const;
+
+    /** Is there a speed curve ?
+     @return                YES if there is no point */
+    TTBoolean       isEmpty() const;
+
+    /** Get the speed at a score date
+     @param date            a score date (in ms)
+     @return                the speed */
+    TTFloat64       getSpeed(TTFloat64 date) const;
+
+    /** Get the wall time needed to go from the score date 0 to a score date
+     @param date            a score date (in ms)
+     @return                a wall date (in ms) */
+    TTFloat64       getWallDate(TTFloat64 date) const;
+
+    /** Get the score date reached after a wall time from the score date 0
+     @param wallDate        a wall date (in ms)
+     @return                a score date (in ms) */
+    TTFloat64       getDate(TTFloat64 wallDate) const;
+};
+
+typedef TTTimeSpeedMap* TTTimeSpeedMapPtr;
+
+#endif // __TT_TIME_SPEED_MAP_H__
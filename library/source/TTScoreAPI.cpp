@@ -31,12 +31,15 @@ void TTScoreInitialize()
 		TTScoreInitialized = true;
 		
 		// register classes -- both internal and external
+        TTTimeClock::registerClass();
         TTTimeCondition::registerClass();
         TTTimeContainer::registerClass();
         TTTimeEvent::registerClass();
         TTTimeProcess::registerClass();
+        TTTimeRender::registerClass();
         
 		TTScoreTest::registerClass();
+		TTScoreBenchmark::registerClass();
         
 #ifdef TT_DEBUG
 		TTLogMessage("Score -- Version %s -- Debugging Enabled\n", TTSCORE_VERSION_STRING);
@@ -317,6 +320,50 @@ TTErr TTScoreTimeProcessEndCallbackRelease(TTTimeProcessPtr timeProcess, TTObjec
     return err;
 }
 
+TTErr TTScoreClockSetExternal(const TTBoolean external)
+{
+    return TTTimeClock::setExternal(external);
+}
+
+TTErr TTScoreClockSetRealTime(const TTInt32 priority, const TTInt32 cpu)
+{
+    return TTTimeClock::setRealTime(priority, cpu);
+}
+
+TTErr TTScoreClockTick(const TTFloat64 deltaTime)
+{
+    return TTTimeClock::tick(deltaTime);
+}
+
+TTErr TTScoreClockTick(const TTUInt32 sampleCount, const TTUInt32 sampleRate)
+{
+    return TTTimeClock::tick(sampleCount, sampleRate);
+}
+
+TTErr TTScoreRender(TTTimeContainerPtr timeContainer, const std::string outputFile, const std::string inputFile, const TTFloat64 step)
+{
+    TTObjectBasePtr aRender = NULL;
+    TTErr           err;
+    
+    err = TTObjectBaseInstantiate(TTSymbol("TimeRender"), &aRender, TTObjectBasePtr(timeContainer));
+    
+    if (!err) {
+        
+        aRender->setAttributeValue(TTSymbol("outputFile"), TTSymbol(outputFile));
+        
+        if (!inputFile.empty())
+            aRender->setAttributeValue(TTSymbol("inputFile"), TTSymbol(inputFile));
+        
+        aRender->setAttributeValue(TTSymbol("step"), step);
+        
+        err = aRender->sendMessage(TTSymbol("Render"));
+        
+        TTObjectBaseRelease(&aRender);
+    }
+    
+    return err;
+}
+
 #if 0
 #pragma mark -
 #pragma mark some internal functions
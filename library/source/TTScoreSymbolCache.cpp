@@ -22,6 +22,7 @@ TTSCORE_EXPORT TTSymbol         kTTSym_TimeEvent                (("TimeEvent"));
 
 // notifications
 TTSCORE_EXPORT TTSymbol         kTTSym_ConditionReadyChanged    (("ConditionReadyChanged"));
+TTSCORE_EXPORT TTSymbol         kTTSym_ConditionValueReceived   (("ConditionValueReceived"));
 TTSCORE_EXPORT TTSymbol         kTTSym_EventDateChanged         (("EventDateChanged"));
 TTSCORE_EXPORT TTSymbol         kTTSym_EventStatusChanged       (("EventStatusChanged"));
 TTSCORE_EXPORT TTSymbol         kTTSym_ProcessStarted           (("ProcessStarted"));
@@ -0,0 +1,948 @@
+/** @file
+ *
+ * @ingroup scoreLibrary
+ *
+ * @brief a scheduler driven by a clock shared between all time processes
+ *
+ * @see TTTimeProcess, Scheduler
+ *
+ * @authors Théo de la Hogue & Clément Bossut
+ *
+ * @copyright Copyright © 2013, Théo de la Hogue & Clément Bossut @n
+ * This code is licensed under the terms of the "CeCILL-C" @n
+ * http://www.cecill.info
+ */
+
+#include "TTTimeClock.h"
+
+#include <sys/time.h>
+#include <errno.h>
+#include <float.h>
+#include <pthread.h>
+
+#ifdef TT_PLATFORM_LINUX
+#include <time.h>
+#include <sched.h>
+#endif
+
+#define thisTTClass                 TTTimeClock
+#define thisTTClassName             "TimeClock"
+#define thisTTClassTags             "scheduler, clock"
+
+#define thisSchedulerVersion		"0.1"
+#define thisSchedulerAuthor         "Theo de la Hogue"
+#define thisSchedulerStretchable	YES
+
+TTTimeClockVector   TTTimeClock::sClocks;
+TTUInt32            TTTimeClock::sClocksToRemove = 0;
+TTFloat64           TTTimeClock::sDeltaTime = 0.;
+TTUInt32            TTTimeClock::sPeriod = 1;
+TTUInt32            TTTimeClock::sInstanceCount = 0;
+TTThreadPtr         TTTimeClock::sThread = NULL;
+std::vector<TTThreadPtr> TTTimeClock::sStoppedThreads;
+TTBoolean           TTTimeClock::sThreadRunning = NO;
+TTUInt32            TTTimeClock::sThreadGeneration = 0;
+TTMutexPtr          TTTimeClock::sMutex = new TTMutex(true);
+TTBoolean           TTTimeClock::sExternal = NO;
+TTInt32             TTTimeClock::sPriority = 0;
+TTInt32             TTTimeClock::sCpu = -1;
+TTBoolean           TTTimeClock::sRealTimeChanged = NO;
+TTFloat64           TTTimeClock::sLateness = 0.;
+TTFloat64           TTTimeClock::sDrift = 0.;
+TTBoolean           TTTimeClock::sWakeRequested = NO;
+TTBoolean           TTTimeClock::sWoken = NO;
+TTTimeClockCommandQueue* TTTimeClock::sCommands = NULL;
+
+/** how many commands can be posted between two ticks */
+#define TIME_CLOCK_COMMAND_QUEUE_SIZE 1024
+
+/** a thread specific flag set while the thread is ticking the clocks (so it can be read without lock) */
+static pthread_key_t    sTickingKey;
+static pthread_once_t   sTickingKeyOnce = PTHREAD_ONCE_INIT;
+
+static void TTTimeClockCreateTickingKey()
+{
+    pthread_key_create(&sTickingKey, NULL);
+}
+
+/** the clock service thread waits on this condition until its next tick or a wake up */
+static pthread_mutex_t  sWakeMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   sWakeCondition;
+static TTBoolean        sWakeConditionInitialized = NO;
+
+/** wait the clock service threads stopped from a tick when the library is unloaded */
+struct TTTimeClockShutdown {
+
+    ~TTTimeClockShutdown() { TTTimeClock::joinStoppedThreads(); }
+};
+
+static TTTimeClockShutdown sShutdown;
+
+/****************************************************************************************************/
+
+SCHEDULER_CONSTRUCTOR,
+mGranularity(1.),
+mWakeUp(0.),
+mMaster(NULL),
+mStartWallDate(0.),
+mPosition(0.),
+mLastCallback(0.),
+mIndex(0),
+mRegistered(NO),
+mCallbackRequested(NO)
+{
+    SCHEDULER_INITIALIZE
+
+    addAttributeWithSetter(Granularity, kTypeFloat64);
+    addAttributeWithSetter(WakeUp, kTypeFloat64);
+    addAttributeWithSetter(Master, kTypeObject);
+    
+    registerAttribute(TTSymbol("speedMap"), kTypeLocalValue, NULL, (TTGetterMethod)& TTTimeClock::getSpeedMap, (TTSetterMethod)& TTTimeClock::setSpeedMap);
+    
+    addMessageWithArguments(Step);
+    
+    // the attributes below are related to the clock service thread
+    registerAttribute(TTSymbol("lateness"), kTypeFloat64, NULL, (TTGetterMethod)& TTTimeClock::getLateness);
+    registerAttribute(TTSymbol("drift"), kTypeFloat64, NULL, (TTGetterMethod)& TTTimeClock::getDrift);
+
+    sMutex->lock();
+    sInstanceCount++;
+
+    // the command queue is created with the first clock and never deleted (like the mutex)
+    if (!sCommands)
+        sCommands = new TTTimeClockCommandQueue(TIME_CLOCK_COMMAND_QUEUE_SIZE);
+
+    sMutex->unlock();
+}
+
+TTTimeClock::~TTTimeClock()
+{
+    TTThreadPtr aThread = NULL;
+
+    sMutex->lock();
+
+    if (mRegistered)
+        unregisterClock(this);
+
+    sInstanceCount--;
+
+    // stop the clock service thread when there is no more clock
+    if (sInstanceCount == 0)
+        aThread = haltThread();
+
+    // a clock can be deleted by the clock service thread itself (when a posted command releases its object) :
+    // in this case the thread ends by itself after the current tick and it is waited later
+    if (aThread && isExecutionThread()) {
+        sStoppedThreads.push_back(aThread);
+        aThread = NULL;
+    }
+
+    sMutex->unlock();
+
+    if (aThread) {
+        aThread->wait();
+        delete aThread;
+    }
+}
+
+TTErr TTTimeClock::getParameterNames(TTValue& value)
+{
+    value.clear();
+	value.append(TTSymbol("granularity"));
+    value.append(TTSymbol("wakeUp"));
+    value.append(TTSymbol("master"));
+    value.append(TTSymbol("speedMap"));
+
+	return kTTErrNone;
+}
+
+TTErr TTTimeClock::Go()
+{
+    // start from the offset
+    mPosition = mOffset;
+    mRealTime = 0.;
+    mLastCallback = 0.;
+
+    // the first tick always calls the callback
+    mCallbackRequested = YES;
+
+    // where the offset is on the speed curve
+    mStartWallDate = mSpeedMap.getWallDate(mPosition);
+
+    if (mDuration > 0.)
+        mProgression = mPosition / mDuration;
+    else
+        mProgression = 0.;
+
+    mPaused = NO;
+    mRunning = YES;
+    sendNotification(TTSymbol("SchedulerRunningChanged"), mRunning);
+
+    return registerClock(this);
+}
+
+TTErr TTTimeClock::Stop()
+{
+    sMutex->lock();
+
+    if (mRegistered)
+        unregisterClock(this);
+
+    sMutex->unlock();
+
+    mPaused = NO;
+    mRunning = NO;
+    sendNotification(TTSymbol("SchedulerRunningChanged"), mRunning);
+
+    // reset timing informations
+    mProgression = 0.;
+    mRealTime = 0.;
+
+    return kTTErrNone;
+}
+
+TTErr TTTimeClock::Pause()
+{
+    mPaused = YES;
+
+    return kTTErrNone;
+}
+
+TTErr TTTimeClock::Resume()
+{
+    mPaused = NO;
+
+    // the clock service thread could be sleeping for a long time
+    wake();
+
+    return kTTErrNone;
+}
+
+TTErr TTTimeClock::Tick()
+{
+    return advance(sDeltaTime);
+}
+
+TTErr TTTimeClock::Step(const TTValue& inputValue, TTValue& outputValue)
+{
+    if (inputValue.size() == 1) {
+        
+        if (inputValue[0].type() == kTypeFloat64)
+            return advance(inputValue[0]);
+    }
+    else if (inputValue.size() == 2) {
+        
+        if (inputValue[0].type() == kTypeUInt32 && inputValue[1].type() == kTypeUInt32) {
+            
+            if (TTUInt32(inputValue[1]))
+                return advance(TTUInt32(inputValue[0]) * 1000. / TTUInt32(inputValue[1]));
+        }
+    }
+    
+    return kTTErrGeneric;
+}
+
+TTErr TTTimeClock::advance(TTFloat64 deltaTime)
+{
+    if (!mRunning || mPaused)
+        return kTTErrNone;
+
+    mRealTime += deltaTime;
+
+    // follow the speed curve
+    if (!mSpeedMap.isEmpty()) {
+
+        mPosition = mSpeedMap.getDate(mStartWallDate + mRealTime);
+        mSpeed = mSpeedMap.getSpeed(mPosition);
+    }
+    else {
+
+        // follow the speed of the master clock (which is ticked before as it started before)
+        if (mMaster && TTTimeClockPtr(mMaster)->mRunning)
+            mSpeed = TTTimeClockPtr(mMaster)->mSpeed;
+
+        mPosition += deltaTime * mSpeed;
+    }
+
+    if (mDuration > 0.)
+        mProgression = mPosition / mDuration;
+
+    // the end is reached : call the callback a last time and stop
+    if (mProgression >= 1. || mDuration <= 0.) {
+
+        mProgression = 1.;
+
+        (mCallback)(mBaton, mProgression, mRealTime);
+
+        // the callback could have stopped the clock already
+        if (mRunning)
+            Stop();
+
+        return kTTErrNone;
+    }
+
+    // call the callback when it is requested, when the clock service is woken up or when the wakeUp date is reached
+    if (mWakeUp != 0.) {
+
+        if (mCallbackRequested || sWoken || (mWakeUp > 0. && mPosition >= mWakeUp)) {
+
+            mCallbackRequested = NO;
+            mLastCallback = mRealTime;
+
+            (mCallback)(mBaton, mProgression, mRealTime);
+        }
+    }
+
+    // don't call the callback more often than the granularity
+    else if (mCallbackRequested || mRealTime - mLastCallback >= mGranularity) {
+
+        mCallbackRequested = NO;
+        mLastCallback = mRealTime;
+
+        (mCallback)(mBaton, mProgression, mRealTime);
+    }
+
+    return kTTErrNone;
+}
+
+TTFloat64 TTTimeClock::getRemainingTime()
+{
+    TTFloat64 remaining, end;
+
+    if (!mRunning || mPaused)
+        return DBL_MAX;
+
+    if (mCallbackRequested)
+        return 0.;
+
+    // when does the clock need to call its callback ?
+    if (mWakeUp == 0.)
+        remaining = mGranularity - (mRealTime - mLastCallback);
+
+    else if (mWakeUp > 0.)
+        remaining = getTimeToPosition(mWakeUp);
+
+    else
+        remaining = DBL_MAX;
+
+    // when does the clock reach its end ?
+    if (mDuration > 0.) {
+
+        end = getTimeToPosition(mDuration);
+
+        if (end < remaining)
+            remaining = end;
+    }
+
+    return remaining > 0. ? remaining : 0.;
+}
+
+TTFloat64 TTTimeClock::getTimeToPosition(TTFloat64 position)
+{
+    // the speed curve converts the position into a wall date
+    if (!mSpeedMap.isEmpty())
+        return mSpeedMap.getWallDate(position) - (mStartWallDate + mRealTime);
+
+    if (mSpeed > 0.)
+        return (position - mPosition) / mSpeed;
+
+    return DBL_MAX;
+}
+
+TTErr TTTimeClock::getLateness(TTValue& value)
+{
+    TTFloat64 lateness;
+
+    pthread_mutex_lock(&sWakeMutex);
+    lateness = sLateness;
+    pthread_mutex_unlock(&sWakeMutex);
+
+    value = lateness;
+    
+    return kTTErrNone;
+}
+
+TTErr TTTimeClock::getDrift(TTValue& value)
+{
+    TTFloat64 drift;
+
+    pthread_mutex_lock(&sWakeMutex);
+    drift = sDrift;
+    pthread_mutex_unlock(&sWakeMutex);
+
+    value = drift;
+    
+    return kTTErrNone;
+}
+
+TTErr TTTimeClock::setGranularity(const TTValue& value)
+{
+    if (value.size() == 1) {
+
+        if (value[0].type() == kTypeFloat64) {
+
+            if (TTFloat64(value[0]) > 0.) {
+
+                mGranularity = value[0];
+
+                return kTTErrNone;
+            }
+        }
+    }
+
+    return kTTErrGeneric;
+}
+
+TTErr TTTimeClock::setWakeUp(const TTValue& value)
+{
+    if (value.size() == 1) {
+
+        if (value[0].type() == kTypeFloat64) {
+
+            mWakeUp = value[0];
+
+            // the clock service thread will consider the new date after the current tick
+            if (!isExecutionThread())
+                wake();
+
+            return kTTErrNone;
+        }
+    }
+
+    return kTTErrGeneric;
+}
+
+TTErr TTTimeClock::setMaster(const TTValue& value)
+{
+    TTObjectBasePtr aMaster;
+
+    if (value.size() == 1) {
+
+        if (value[0].type() == kTypeObject) {
+
+            aMaster = value[0];
+
+            if (aMaster && aMaster->getName() != TTSymbol(thisTTClassName))
+                return kTTErrGeneric;
+
+            mMaster = aMaster;
+
+            return kTTErrNone;
+        }
+    }
+
+    return kTTErrGeneric;
+}
+
+TTErr TTTimeClock::getSpeedMap(TTValue& value)
+{
+    mSpeedMap.get(value);
+
+    return kTTErrNone;
+}
+
+TTErr TTTimeClock::setSpeedMap(const TTValue& value)
+{
+    TTErr err;
+
+    // don't change the speed curve while the clock service is ticking
+    sMutex->lock();
+
+    err = mSpeedMap.set(value);
+
+    // keep the current position
+    if (!err)
+        mStartWallDate = mSpeedMap.getWallDate(mPosition) - mRealTime;
+
+    sMutex->unlock();
+
+    if (!err && !isExecutionThread())
+        wake();
+
+    return err;
+}
+
+#if 0
+#pragma mark -
+#pragma mark Clock service
+#endif
+
+TTErr TTTimeClock::registerClock(TTTimeClockPtr aClock)
+{
+    // a former clock service thread could be still waiting to be deleted
+    joinStoppedThreads();
+
+    sMutex->lock();
+
+    // a clock can be registered only once
+    if (!aClock->mRegistered) {
+
+        aClock->mIndex = sClocks.size();
+        aClock->mRegistered = YES;
+        sClocks.push_back(aClock);
+    }
+
+    // launch the clock service thread if needed
+    launchThread();
+
+    sMutex->unlock();
+
+    // the clock service thread could be waiting for a wake up
+    wake();
+
+    return kTTErrNone;
+}
+
+TTErr TTTimeClock::unregisterClock(TTTimeClockPtr aClock)
+{
+    TTErr err = kTTErrGeneric;
+
+    sMutex->lock();
+
+    if (aClock->mRegistered) {
+
+        // don't erase the clock now as the clock service could be iterating on the vector :
+        // the vector will be compacted after the next tick
+        sClocks[aClock->mIndex] = NULL;
+        aClock->mRegistered = NO;
+        sClocksToRemove++;
+
+        err = kTTErrNone;
+    }
+
+    sMutex->unlock();
+
+    return err;
+}
+
+void TTTimeClock::tickClocks(TTFloat64 deltaTime)
+{
+    TTUInt32 i, j, size;
+
+    sMutex->lock();
+
+    // is this tick due to a wake up ?
+    pthread_mutex_lock(&sWakeMutex);
+    sWoken = sWakeRequested;
+    sWakeRequested = NO;
+    pthread_mutex_unlock(&sWakeMutex);
+
+    sDeltaTime = deltaTime;
+
+    pthread_once(&sTickingKeyOnce, TTTimeClockCreateTickingKey);
+    pthread_setspecific(sTickingKey, &sTickingKey);
+
+    // note : the clocks registered during this tick (by a command or a callback) will be ticked the next time
+    size = sClocks.size();
+
+    // apply the commands posted since the last tick
+    applyCommands();
+
+    // tick each clock in their registration order
+
+    for (i = 0; i < size; i++)
+        if (sClocks[i])
+            sClocks[i]->Tick();
+
+    pthread_setspecific(sTickingKey, NULL);
+    sWoken = NO;
+
+    // compact the vector if some clocks have been unregistered
+    if (sClocksToRemove) {
+
+        for (i = 0, j = 0; i < sClocks.size(); i++) {
+
+            if (sClocks[i]) {
+
+                sClocks[i]->mIndex = j;
+                sClocks[j++] = sClocks[i];
+            }
+        }
+
+        sClocks.resize(j);
+        sClocksToRemove = 0;
+    }
+
+    sMutex->unlock();
+}
+
+void TTTimeClock::applyCommands()
+{
+    TTTimeClockCommand  aCommand;
+    TTValue             none;
+
+    if (!sCommands)
+        return;
+
+    while (sCommands->pop(aCommand) == TTTimeClockCommandQueue::kBufferReadSuccessful) {
+
+        aCommand.object->sendMessage(aCommand.message, aCommand.argument, none);
+        TTObjectBaseRelease(&aCommand.object);
+    }
+}
+
+TTFloat64 TTTimeClock::getNextTickTime()
+{
+    TTFloat64   next = DBL_MAX, remaining;
+    TTUInt32    i;
+
+    sMutex->lock();
+
+    for (i = 0; i < sClocks.size(); i++) {
+
+        if (sClocks[i]) {
+
+            remaining = sClocks[i]->getRemainingTime();
+
+            if (remaining < next)
+                next = remaining;
+        }
+    }
+
+    sMutex->unlock();
+
+    return next;
+}
+
+void TTTimeClock::launchThread()
+{
+    if (!sThread && !sExternal) {
+
+        if (!sWakeConditionInitialized) {
+
+            pthread_condattr_t attributes;
+
+            pthread_condattr_init(&attributes);
+#ifdef TT_PLATFORM_LINUX
+            // the timed waits are relative to the monotonic clock
+            pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+#endif
+            pthread_cond_init(&sWakeCondition, &attributes);
+            pthread_condattr_destroy(&attributes);
+
+            sWakeConditionInitialized = YES;
+        }
+        
+        sRealTimeChanged = sPriority > 0 || sCpu >= 0;
+
+        // a former thread which is ending its last tick can't take the place of the new one
+        pthread_mutex_lock(&sWakeMutex);
+        sThreadRunning = YES;
+        sThreadGeneration++;
+        pthread_mutex_unlock(&sWakeMutex);
+
+        sThread = new TTThread(TTThreadCallbackType(TTTimeClockThreadCallback), TTPtr(TTPtrSizedInt(sThreadGeneration)));
+    }
+}
+
+TTThreadPtr TTTimeClock::haltThread()
+{
+    TTThreadPtr aThread = sThread;
+    
+    pthread_mutex_lock(&sWakeMutex);
+    sThreadRunning = NO;
+    pthread_mutex_unlock(&sWakeMutex);
+
+    sThread = NULL;
+
+    // the thread could be waiting for a wake up
+    wake();
+    
+    return aThread;
+}
+
+void TTTimeClock::joinStoppedThreads()
+{
+    std::vector<TTThreadPtr>    threads;
+    TTUInt32                    i;
+
+    // a stopped thread can't wait for itself
+    if (isExecutionThread())
+        return;
+
+    sMutex->lock();
+    threads.swap(sStoppedThreads);
+    sMutex->unlock();
+
+    for (i = 0; i < threads.size(); i++) {
+        threads[i]->wait();
+        delete threads[i];
+    }
+}
+
+TTErr TTTimeClock::setExternal(TTBoolean external)
+{
+    TTThreadPtr aThread = NULL;
+    
+    sMutex->lock();
+    
+    sExternal = external;
+    
+    if (sExternal)
+        aThread = haltThread();
+    
+    else if (sClocks.size())
+        launchThread();
+    
+    sMutex->unlock();
+    
+    // wait the end of the thread outside the lock because it could be ticking
+    if (aThread) {
+        aThread->wait();
+        delete aThread;
+    }
+    
+    return kTTErrNone;
+}
+
+void TTTimeClock::wake()
+{
+    pthread_mutex_lock(&sWakeMutex);
+
+    sWakeRequested = YES;
+
+    if (sWakeConditionInitialized)
+        pthread_cond_signal(&sWakeCondition);
+
+    pthread_mutex_unlock(&sWakeMutex);
+}
+
+TTBoolean TTTimeClock::isExecutionThread()
+{
+    pthread_once(&sTickingKeyOnce, TTTimeClockCreateTickingKey);
+
+    return pthread_getspecific(sTickingKey) != NULL;
+}
+
+TTErr TTTimeClock::post(TTObjectBasePtr anObject, TTSymbol aMessage, const TTValue& anArgument)
+{
+    TTTimeClockCommand aCommand;
+
+    if (!anObject || !sCommands)
+        return kTTErrGeneric;
+
+    aCommand.object = TTObjectBaseReference(anObject);
+    aCommand.message = aMessage;
+    aCommand.argument = anArgument;
+
+    if (sCommands->push(aCommand) != TTTimeClockCommandQueue::kBufferWriteSuccessful) {
+
+        TTObjectBaseRelease(&aCommand.object);
+        TTLogError("TTTimeClock::post : the command queue is full, %s is not posted\n", aMessage.c_str());
+        return kTTErrGeneric;
+    }
+
+    // make sure there is a thread to apply the command as soon as possible
+    // (in external mode, the command is applied at the next tick of the host)
+    if (!sThread && !sExternal) {
+
+        sMutex->lock();
+        launchThread();
+        sMutex->unlock();
+    }
+
+    wake();
+
+    return kTTErrNone;
+}
+
+TTBoolean TTTimeClock::isExternal()
+{
+    return sExternal;
+}
+
+TTErr TTTimeClock::setRealTime(TTInt32 priority, TTInt32 cpu)
+{
+    sMutex->lock();
+    
+    sPriority = priority;
+    sCpu = cpu;
+    
+    // the clock service thread will apply the settings before its next tick
+    sRealTimeChanged = YES;
+    
+    sMutex->unlock();
+    
+#ifdef TT_PLATFORM_LINUX
+    return kTTErrNone;
+#else
+    return kTTErrGeneric;
+#endif
+}
+
+TTErr TTTimeClock::tick(TTFloat64 deltaTime)
+{
+    if (!sExternal)
+        return kTTErrGeneric;
+    
+    tickClocks(deltaTime);
+    
+    return kTTErrNone;
+}
+
+TTErr TTTimeClock::tick(TTUInt32 sampleCount, TTUInt32 sampleRate)
+{
+    if (!sampleRate)
+        return kTTErrGeneric;
+    
+    return tick(sampleCount * 1000. / sampleRate);
+}
+
+#if 0
+#pragma mark -
+#pragma mark Some Methods
+#endif
+
+/** Get the current time of a monotonic clock (in ms) */
+static TTFloat64 TTTimeClockNow()
+{
+#ifdef TT_PLATFORM_LINUX
+    struct timespec now;
+    
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000. + now.tv_nsec / 1000000.;
+#else
+    struct timeval  now;
+    
+    gettimeofday(&now, NULL);
+    return now.tv_sec * 1000. + now.tv_usec / 1000.;
+#endif
+}
+
+/** Convert an absolute date of the monotonic clock (in ms) into a timespec */
+static void TTTimeClockDateToTimespec(TTFloat64 date, struct timespec& aTimespec)
+{
+    aTimespec.tv_sec = time_t(date / 1000.);
+    aTimespec.tv_nsec = long((date - aTimespec.tv_sec * 1000.) * 1000000.);
+    
+    if (aTimespec.tv_nsec >= 1000000000) {
+        aTimespec.tv_sec++;
+        aTimespec.tv_nsec -= 1000000000;
+    }
+}
+
+/** Apply the real time priority and the cpu affinity to the calling thread */
+static void TTTimeClockApplyRealTime(TTInt32 priority, TTInt32 cpu)
+{
+#ifdef TT_PLATFORM_LINUX
+    struct sched_param  param;
+    cpu_set_t           cpuSet;
+    
+    if (priority > 0) {
+        
+        param.sched_priority = priority;
+        
+        if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param))
+            TTLogError("TTTimeClock : can't set SCHED_FIFO priority %d\n", priority);
+    }
+    else {
+        
+        param.sched_priority = 0;
+        pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+    }
+    
+    CPU_ZERO(&cpuSet);
+    
+    if (cpu >= 0)
+        CPU_SET(cpu, &cpuSet);
+    else
+        for (TTInt32 i = 0; i < CPU_SETSIZE; i++)
+            CPU_SET(i, &cpuSet);
+    
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) && cpu >= 0)
+        TTLogError("TTTimeClock : can't set the affinity to cpu %d\n", cpu);
+#endif
+}
+
+void* TTTimeClockThreadCallback(void* anArgument)
+{
+    TTUInt32        generation = TTUInt32(TTPtrSizedInt(anArgument));
+    TTFloat64       lastTime, currentTime, next, deadline;
+    TTBoolean       woken, running = YES, realTimeChanged;
+    TTInt32         priority, cpu;
+    struct timespec date;
+
+    lastTime = TTTimeClockNow();
+
+    pthread_mutex_lock(&sWakeMutex);
+    TTTimeClock::sLateness = 0.;
+    TTTimeClock::sDrift = 0.;
+    pthread_mutex_unlock(&sWakeMutex);
+
+    while (running) {
+        
+        // apply the real time settings if they changed
+        TTTimeClock::sMutex->lock();
+        realTimeChanged = TTTimeClock::sRealTimeChanged;
+        TTTimeClock::sRealTimeChanged = NO;
+        priority = TTTimeClock::sPriority;
+        cpu = TTTimeClock::sCpu;
+        TTTimeClock::sMutex->unlock();
+
+        if (realTimeChanged)
+            TTTimeClockApplyRealTime(priority, cpu);
+        
+        // sleep until the nearest date a clock needs to be ticked (but not less than the period)
+        next = TTTimeClock::getNextTickTime();
+
+        if (next == DBL_MAX)
+            deadline = DBL_MAX;
+
+        else if (next < TTTimeClock::sPeriod)
+            deadline = lastTime + TTTimeClock::sPeriod;
+
+        else
+            deadline = lastTime + next;
+
+        if (deadline != DBL_MAX)
+            TTTimeClockDateToTimespec(deadline, date);
+        
+        pthread_mutex_lock(&sWakeMutex);
+        
+        // wait to an absolute deadline so the wait duration errors don't accumulate
+        // note : a wake up requested before the wait is not lost as the flag is tested first
+        while (!TTTimeClock::sWakeRequested && TTTimeClock::sThreadRunning && TTTimeClock::sThreadGeneration == generation) {
+            
+            if (deadline == DBL_MAX)
+                pthread_cond_wait(&sWakeCondition, &sWakeMutex);
+            
+            else if (pthread_cond_timedwait(&sWakeCondition, &sWakeMutex, &date) == ETIMEDOUT)
+                break;
+        }
+        
+        woken = TTTimeClock::sWakeRequested;
+        running = TTTimeClock::sThreadRunning && TTTimeClock::sThreadGeneration == generation;
+        
+        pthread_mutex_unlock(&sWakeMutex);
+
+        if (!running)
+            break;
+
+        currentTime = TTTimeClockNow();
+        
+        // a wrong system time change could make the time going backward
+        if (currentTime < lastTime)
+            currentTime = lastTime;
+        
+        // how late is this tick compared to the deadline it has waited for ?
+        // (the next deadline starts from this tick so the lateness is never counted twice in the drift)
+        pthread_mutex_lock(&sWakeMutex);
+
+        if (!woken && currentTime > deadline) {
+
+            TTTimeClock::sLateness = currentTime - deadline;
+            TTTimeClock::sDrift += TTTimeClock::sLateness;
+        }
+        else
+            TTTimeClock::sLateness = 0.;
+
+        pthread_mutex_unlock(&sWakeMutex);
+
+        // the clocks advance of the real time elapsed so the lateness doesn't accumulate
+        TTTimeClock::tickClocks(currentTime - lastTime);
+
+        lastTime = currentTime;
+    }
+
+    return NULL;
+}
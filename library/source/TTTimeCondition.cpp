@@ -498,12 +498,19 @@ TTErr TTTimeConditionReceiverReturnValueCallback(TTPtr baton, TTValue& data)
     Expression          anExpression;
     TTList              timeEventToTrigger;
     TTList              timeEventToDispose;
+    TTValue             v;
 	
 	// unpack baton (condition, address)
 	b = (TTValuePtr)baton;
 	aTimeCondition = TTTimeConditionPtr(TTObjectBasePtr((*b)[0]));
     anAddress = (*b)[1];
     
+    // tell the observers which value is received (to record it for example)
+    v = TTObjectBasePtr(aTimeCondition);
+    v.append(anAddress);
+    v.append(data);
+    aTimeCondition->sendNotification(kTTSym_ConditionValueReceived, v);
+    
     // for each event's expression matching the incoming address
     for (TTCaseMapIterator it = aTimeCondition->mCases.begin(); it != aTimeCondition->mCases.end(); it++) {
         
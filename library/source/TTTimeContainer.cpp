@@ -41,6 +41,7 @@ TTTimeProcess(arguments)
     registerAttribute(TTSymbol("timeProcesses"), kTypeLocalValue, NULL, (TTGetterMethod)& TTTimeContainer::getTimeProcesses, NULL);
     registerAttribute(TTSymbol("timeEvents"), kTypeLocalValue, NULL, (TTGetterMethod)& TTTimeContainer::getTimeEvents, NULL);
     registerAttribute(TTSymbol("timeConditions"), kTypeLocalValue, NULL, (TTGetterMethod)& TTTimeContainer::getTimeConditions, NULL);
+    registerAttribute(TTSymbol("speedMap"), kTypeLocalValue, NULL, (TTGetterMethod)& TTTimeContainer::getSpeedMap, (TTSetterMethod)& TTTimeContainer::setSpeedMap);
     
     addMessageWithArguments(TimeEventCreate);
     addMessageProperty(TimeEventCreate, hidden, YES);
@@ -110,6 +111,16 @@ TTErr TTTimeContainer::getTimeProcesses(TTValue& value)
     return kTTErrNone;
 }
 
+TTErr TTTimeContainer::getSpeedMap(TTValue& value)
+{
+    return mScheduler->getAttributeValue(TTSymbol("speedMap"), value);
+}
+
+TTErr TTTimeContainer::setSpeedMap(const TTValue& value)
+{
+    return mScheduler->setAttributeValue(TTSymbol("speedMap"), value);
+}
+
 TTErr TTTimeContainer::getTimeEvents(TTValue& value)
 {
     value.clear();
@@ -531,22 +542,11 @@ TTErr TTTimeContainer::SchedulerSpeedChanged(const TTValue& inputValue, TTValue&
 {
     TT_ASSERT("TTTimeContainer::SchedulerSpeedChanged : inputValue is correct", inputValue.size() == 1 && inputValue[0].type() == kTypeFloat64);
     
-    TTObjectBasePtr aTimeProcess;
-    TTObjectBasePtr aScheduler;
-    TTValue         v;
+    // there is no need to set the speed of each time process scheduler :
+    // they read the speed of the container scheduler at each tick (see TTTimeClock master attribute)
     
-    // for each time process
-    for (mTimeProcessList.begin(); mTimeProcessList.end(); mTimeProcessList.next()) {
-        
-        aTimeProcess = mTimeProcessList.current()[0];
-        
-        // get the actual time process scheduler
-        aTimeProcess->getAttributeValue(TTSymbol("scheduler"), v);
-        aScheduler = v[0];
-        
-        // set the time process scheduler speed value with the container scheduler speed value
-        aScheduler->setAttributeValue(kTTSym_speed, inputValue);
-    }
+    // the clock service thread could be waiting for a date computed with the former speed
+    TTTimeClock::wake();
     
     return kTTErrNone;
 }
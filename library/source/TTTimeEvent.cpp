@@ -183,15 +183,51 @@ TTErr TTTimeEvent::Happen()
 
     // if the event is not muted
     if (!mMute) {
+        
+        // during an offline render : write the state into the render file instead of recalling it
+        if (TTTimeRenderIsRunning())
+            err = RenderState();
     
         // recall the state
-        err = mState->sendMessage(kTTSym_Run);
+        else
+            err = mState->sendMessage(kTTSym_Run);
     }
     
     setStatus(kTTSym_eventHappened);
     return err;
 }
 
+TTErr TTTimeEvent::RenderState()
+{
+    TTValue         v;
+    TTAddress       address;
+    TTListPtr       lines;
+    TTDictionaryBasePtr aLine;
+    
+    // get the lines of the state
+    mState->getAttributeValue(kTTSym_lines, v);
+    lines = TTListPtr(TTPtr(v[0]));
+    
+    // write the address and the value of each command line
+    for (lines->begin(); lines->end(); lines->next()) {
+        
+        aLine = TTDictionaryBasePtr((TTPtr)lines->current()[0]);
+        
+        if (aLine->getSchema() == kTTSym_command) {
+            
+            if (!aLine->lookup(kTTSym_address, v)) {
+                
+                address = v[0];
+                
+                aLine->getValue(v);
+                TTTimeRenderOutput(address, v);
+            }
+        }
+    }
+    
+    return kTTErrNone;
+}
+
 TTErr TTTimeEvent::StateAddressGetValue(const TTValue& inputValue, TTValue& outputValue)
 {
     TTValue         v;
@@ -123,17 +123,25 @@ mEndEvent(NULL)
     addMessageWithArguments(EventStatusChanged);
     addMessageProperty(EventStatusChanged, hidden, YES);
     
-    // Creation of a scheduler based on the System scheduler plugin
+    // Creation of a scheduler ticked by the clock shared between all time processes
+    // (instead of a System scheduler plugin which would run its own thread for each time process)
     // Prepare callback argument to be notified of :
     //      - the progression
     args = TTValue((TTPtr)&TTTimeProcessSchedulerCallback);
     args.append((TTPtr)this);   // we have to store this as a pointer for Scheduler
     
-    err = TTObjectBaseInstantiate(TTSymbol("System"), TTObjectBaseHandle(&mScheduler), args);
+    err = TTObjectBaseInstantiate(TTSymbol("TimeClock"), TTObjectBaseHandle(&mScheduler), args);
     
 	if (err) {
         mScheduler = NULL;
-		logError("TimeProcess failed to load the System Scheduler");
+		logError("TimeProcess failed to load the TimeClock Scheduler");
+    }
+    
+    // the scheduler follows the speed of the container scheduler
+    else if (mContainer) {
+        
+        mContainer->getAttributeValue(TTSymbol("scheduler"), args);
+        mScheduler->setAttributeValue(TTSymbol("master"), args);
     }
     
     // generate a random name
@@ -421,11 +429,19 @@ TTErr TTTimeProcess::Limit(const TTValue& inputValue, TTValue& outputValue)
 
 TTErr TTTimeProcess::Start()
 {
+    // apply the command at the next tick of the clock service
+    if (!TTTimeClock::isExecutionThread())
+        return TTTimeClock::post(this, TTSymbol("Start"));
+    
     return mStartEvent->sendMessage(kTTSym_Happen);
 }
 
 TTErr TTTimeProcess::End()
 {
+    // apply the command at the next tick of the clock service
+    if (!TTTimeClock::isExecutionThread())
+        return TTTimeClock::post(this, TTSymbol("End"));
+    
     return mEndEvent->sendMessage(kTTSym_Happen);
 }
 
@@ -434,6 +450,10 @@ TTErr TTTimeProcess::Play()
     TTValue    v;
     TTUInt32   start, end;
     
+    // apply the command at the next tick of the clock service
+    if (!TTTimeClock::isExecutionThread())
+        return TTTimeClock::post(this, TTSymbol("Play"));
+    
     // set the running state of the process
     mRunning = YES;
     
@@ -459,6 +479,10 @@ TTErr TTTimeProcess::Play()
 
 TTErr TTTimeProcess::Stop()
 {
+    // apply the command at the next tick of the clock service
+    if (!TTTimeClock::isExecutionThread())
+        return TTTimeClock::post(this, kTTSym_Stop);
+    
     // set the running state of the process
     mRunning = NO;
     
@@ -469,6 +493,10 @@ TTErr TTTimeProcess::Pause()
 {
     TTValue none;
     
+    // apply the command at the next tick of the clock service
+    if (!TTTimeClock::isExecutionThread())
+        return TTTimeClock::post(this, kTTSym_Pause);
+    
     mScheduler->sendMessage(kTTSym_Pause);
     
     return ProcessPaused(TTBoolean(YES), none);
@@ -478,6 +506,10 @@ TTErr TTTimeProcess::Resume()
 {
     TTValue none;
     
+    // apply the command at the next tick of the clock service
+    if (!TTTimeClock::isExecutionThread())
+        return TTTimeClock::post(this, kTTSym_Resume);
+    
     mScheduler->sendMessage(kTTSym_Resume);
     
     return ProcessPaused(TTBoolean(NO), none);
@@ -0,0 +1,242 @@
+/** @file
+ *
+ * @ingroup scoreLibrary
+ *
+ * @brief a class to render a time container offline
+ *
+ * @see TTTimeContainer, TTTimeClock
+ *
+ * @authors Théo de la Hogue & Clément Bossut
+ *
+ * @copyright Copyright © 2013, Théo de la Hogue & Clément Bossut @n
+ * This code is licensed under the terms of the "CeCILL-C" @n
+ * http://www.cecill.info
+ */
+
+#include "TTTimeRender.h"
+#include "TTTimeClock.h"
+
+#include <algorithm>
+
+#define thisTTClass         TTTimeRender
+#define thisTTClassName     "TimeRender"
+#define thisTTClassTags     "time, render"
+
+/** the render which is running (only one render can run at a time because the clock is shared) */
+static TTTimeRenderPtr  sRunningRender = NULL;
+
+/** compare the date of two triggers */
+static bool TTTimeRenderTriggerCompare(const TTTimeRenderTrigger& a, const TTTimeRenderTrigger& b)
+{
+    return a.date < b.date;
+}
+
+/****************************************************************************************************/
+
+TT_BASE_OBJECT_CONSTRUCTOR,
+mContainer(NULL),
+mStep(1.),
+mInputFile(kTTSymEmpty),
+mOutputFile(kTTSymEmpty),
+mDate(0.),
+mOutput(NULL)
+{
+    TT_ASSERT("Correct number of args to create TTTimeRender", arguments.size() == 0 || arguments.size() == 1);
+
+    if (arguments.size() == 1)
+        mContainer = arguments[0];
+
+    addAttribute(Container, kTypeObject);
+    addAttributeWithSetter(Step, kTypeFloat64);
+    addAttribute(InputFile, kTypeSymbol);
+    addAttribute(OutputFile, kTypeSymbol);
+
+    addMessage(Render);
+}
+
+TTTimeRender::~TTTimeRender()
+{
+    if (mOutput) {
+        fclose(mOutput);
+        mOutput = NULL;
+    }
+
+    if (sRunningRender == this)
+        sRunningRender = NULL;
+}
+
+TTErr TTTimeRender::setStep(const TTValue& value)
+{
+    if (value.size() == 1) {
+
+        if (value[0].type() == kTypeFloat64) {
+
+            if (TTFloat64(value[0]) > 0.) {
+
+                mStep = value[0];
+
+                return kTTErrNone;
+            }
+        }
+    }
+
+    return kTTErrGeneric;
+}
+
+TTErr TTTimeRender::Render()
+{
+    TTValue     v, out;
+    TTFloat64   endDate;
+    TTBoolean   external, running;
+    TTUInt32    i;
+    TTErr       err;
+
+    if (!mContainer || mOutputFile == kTTSymEmpty)
+        return kTTErrGeneric;
+
+    // only one render can run at a time
+    if (sRunningRender) {
+        logError("TimeRender : another render is already running");
+        return kTTErrGeneric;
+    }
+
+    // read the triggers to do
+    mTriggers.clear();
+
+    if (mInputFile != kTTSymEmpty) {
+
+        err = readTriggers();
+
+        if (err)
+            return err;
+    }
+
+    // open the output file
+    mOutput = fopen(mOutputFile.c_str(), "w");
+
+    if (!mOutput) {
+        logError("TimeRender : can't open %s", mOutputFile.c_str());
+        return kTTErrGeneric;
+    }
+
+    // drive the clock by ourself
+    external = TTTimeClock::isExternal();
+    TTTimeClock::setExternal(YES);
+
+    sRunningRender = this;
+    mDate = 0.;
+
+    mContainer->getAttributeValue(kTTSym_endDate, v);
+    endDate = TTUInt32(v[0]);
+
+    // compile then start the container
+    mContainer->sendMessage(kTTSym_Compile);
+    mContainer->sendMessage(TTSymbol("Start"));
+
+    // the start is posted to the clock service : apply it without advancing the time
+    TTTimeClock::tick(0.);
+
+    i = 0;
+    running = YES;
+
+    while (running && mDate <= endDate) {
+
+        // do all the triggers planned before the current date
+        while (i < mTriggers.size() && mTriggers[i].date <= mDate) {
+
+            if (!mContainer->sendMessage(TTSymbol("TimeEventFind"), mTriggers[i].name, out))
+                TTObjectBasePtr(out[0])->sendMessage(kTTSym_Trigger);
+            else
+                logError("TimeRender : can't find %s event to trigger", mTriggers[i].name.c_str());
+
+            i++;
+        }
+
+        // advance the clock of one step
+        mDate += mStep;
+        TTTimeClock::tick(mStep);
+
+        mContainer->getAttributeValue(TTSymbol("running"), v);
+        running = v[0];
+    }
+
+    // end the container if it is still running (an interactive event could be still waiting)
+    if (running) {
+
+        mContainer->sendMessage(TTSymbol("End"));
+
+        // the end is posted to the clock service : apply it while the states are still rendered into the file
+        TTTimeClock::tick(0.);
+    }
+
+    sRunningRender = NULL;
+
+    // give the clock back to its previous mode
+    TTTimeClock::setExternal(external);
+
+    fclose(mOutput);
+    mOutput = NULL;
+
+    return kTTErrNone;
+}
+
+TTErr TTTimeRender::readTriggers()
+{
+    FILE*               input;
+    char                line[512];
+    char                name[256];
+    double              date;
+    TTTimeRenderTrigger aTrigger;
+
+    input = fopen(mInputFile.c_str(), "r");
+
+    if (!input) {
+        logError("TimeRender : can't open %s", mInputFile.c_str());
+        return kTTErrGeneric;
+    }
+
+    // each line is : <date in ms> <time event name>
+    while (fgets(line, sizeof(line), input)) {
+
+        if (sscanf(line, "%lf %255s", &date, name) == 2) {
+
+            aTrigger.date = date;
+            aTrigger.name = TTSymbol(name);
+            mTriggers.push_back(aTrigger);
+        }
+    }
+
+    fclose(input);
+
+    // sort the triggers in time order (keeping the file order for a same date)
+    std::stable_sort(mTriggers.begin(), mTriggers.end(), TTTimeRenderTriggerCompare);
+
+    return kTTErrNone;
+}
+
+void TTTimeRender::write(const TTSymbol& address, const TTValue& value)
+{
+    TTValue     v = value;
+    TTString    s;
+
+    v.toString();
+    s = TTString(v[0]);
+
+    fprintf(mOutput, "%.3f %s %s\n", mDate, address.c_str(), s.c_str());
+}
+
+#if 0
+#pragma mark -
+#pragma mark Some Methods
+#endif
+
+TTBoolean TTTimeRenderIsRunning()
+{
+    return sRunningRender != NULL;
+}
+
+void TTTimeRenderOutput(const TTSymbol& address, const TTValue& value)
+{
+    if (sRunningRender)
+        sRunningRender->write(address, value);
+}
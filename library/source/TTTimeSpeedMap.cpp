@@ -0,0 +1,202 @@
+/** @file
+ *
+ * @ingroup scoreLibrary
+ *
+ * @brief a TTTimeSpeedMap is a piecewise speed curve to convert score time into wall time and back
+ *
+ * @see TTTimeClock
+ *
+ * @authors Théo de la Hogue & Clément Bossut
+ *
+ * @copyright Copyright © 2013, Théo de la Hogue & Clément Bossut @n
+ * This code is licensed under the terms of the "CeCILL-C" @n
+ * http://www.cecill.info
+ */
+
+#include "TTTimeSpeedMap.h"
+
+#include <algorithm>
+#include <math.h>
+
+/** compare the date of two points */
+static bool TTTimeSpeedMapPointCompare(const TTTimeSpeedMapPoint& a, const TTTimeSpeedMapPoint& b)
+{
+    return a.date < b.date;
+}
+
+TTErr TTTimeSpeedMap::set(const TTValue& value)
+{
+    TTTimeSpeedMapPointVector   points;
+    TTTimeSpeedMapPoint         aPoint;
+    TTFloat64                   slope, length;
+    TTUInt32                    i;
+
+    if (value.size() % 2)
+        return kTTErrGeneric;
+
+    for (i = 0; i < value.size(); i += 2) {
+
+        if (!TTDataInfo::getIsNumerical(value[i].type()) || !TTDataInfo::getIsNumerical(value[i+1].type()))
+            return kTTErrGeneric;
+
+        aPoint.date = value[i];
+        aPoint.speed = value[i+1];
+        aPoint.wallDate = 0.;
+
+        if (aPoint.speed <= 0.)
+            return kTTErrGeneric;
+
+        points.push_back(aPoint);
+    }
+
+    std::stable_sort(points.begin(), points.end(), TTTimeSpeedMapPointCompare);
+
+    // cumulate the wall time needed to reach each point
+    for (i = 0; i < points.size(); i++) {
+
+        // before the first point the speed is constant
+        if (i == 0) {
+            points[i].wallDate = points[i].date / points[i].speed;
+            continue;
+        }
+
+        length = points[i].date - points[i-1].date;
+
+        if (length <= 0.)
+            return kTTErrGeneric;
+
+        slope = (points[i].speed - points[i-1].speed) / length;
+
+        if (slope == 0.)
+            points[i].wallDate = points[i-1].wallDate + length / points[i-1].speed;
+        else
+            points[i].wallDate = points[i-1].wallDate + log(points[i].speed / points[i-1].speed) / slope;
+    }
+
+    mPoints = points;
+
+    return kTTErrNone;
+}
+
+void TTTimeSpeedMap::get(TTValue& value) const
+{
+    value.clear();
+
+    for (TTUInt32 i = 0; i < mPoints.size(); i++) {
+        value.append(mPoints[i].date);
+        value.append(mPoints[i].speed);
+    }
+}
+
+TTBoolean TTTimeSpeedMap::isEmpty() const
+{
+    return mPoints.empty();
+}
+
+TTFloat64 TTTimeSpeedMap::getSpeed(TTFloat64 date) const
+{
+    TTInt32 i;
+
+    if (mPoints.empty())
+        return 1.;
+
+    i = findDate(date);
+
+    if (i < 0)
+        return mPoints[0].speed;
+
+    return mPoints[i].speed + getSlope(i) * (date - mPoints[i].date);
+}
+
+TTFloat64 TTTimeSpeedMap::getWallDate(TTFloat64 date) const
+{
+    TTFloat64   slope, speed;
+    TTInt32     i;
+
+    if (mPoints.empty())
+        return date;
+
+    i = findDate(date);
+
+    if (i < 0)
+        return date / mPoints[0].speed;
+
+    slope = getSlope(i);
+
+    // the wall time to go through a segment where the speed is s0 + slope * x is log(s / s0) / slope
+    if (slope == 0.)
+        return mPoints[i].wallDate + (date - mPoints[i].date) / mPoints[i].speed;
+
+    speed = mPoints[i].speed + slope * (date - mPoints[i].date);
+
+    return mPoints[i].wallDate + log(speed / mPoints[i].speed) / slope;
+}
+
+TTFloat64 TTTimeSpeedMap::getDate(TTFloat64 wallDate) const
+{
+    TTFloat64   slope;
+    TTInt32     i;
+
+    if (mPoints.empty())
+        return wallDate;
+
+    i = findWallDate(wallDate);
+
+    if (i < 0)
+        return wallDate * mPoints[0].speed;
+
+    slope = getSlope(i);
+
+    // the inverse of the formula used in getWallDate
+    if (slope == 0.)
+        return mPoints[i].date + (wallDate - mPoints[i].wallDate) * mPoints[i].speed;
+
+    return mPoints[i].date + mPoints[i].speed * (exp(slope * (wallDate - mPoints[i].wallDate)) - 1.) / slope;
+}
+
+TTInt32 TTTimeSpeedMap::findDate(TTFloat64 date) const
+{
+    TTInt32 low = 0, high = mPoints.size() - 1, middle, found = -1;
+
+    while (low <= high) {
+
+        middle = (low + high) / 2;
+
+        if (mPoints[middle].date <= date) {
+            found = middle;
+            low = middle + 1;
+        }
+        else
+            high = middle - 1;
+    }
+
+    return found;
+}
+
+TTInt32 TTTimeSpeedMap::findWallDate(TTFloat64 wallDate) const
+{
+    TTInt32 low = 0, high = mPoints.size() - 1, middle, found = -1;
+
+    while (low <= high) {
+
+        middle = (low + high) / 2;
+
+        if (mPoints[middle].wallDate <= wallDate) {
+            found = middle;
+            low = middle + 1;
+        }
+        else
+            high = middle - 1;
+    }
+
+    return found;
+}
+
+TTFloat64 TTTimeSpeedMap::getSlope(TTUInt32 index) const
+{
+    // after the last point the speed is constant
+    if (index + 1 >= mPoints.size())
+        return 0.;
+
+    return (mPoints[index+1].speed - mPoints[index].speed) / (mPoints[index+1].date - mPoints[index].date);
+}
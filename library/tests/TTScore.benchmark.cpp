@@ -0,0 +1,104 @@
+/** @file
+ *
+ * @ingroup scoreLibrary
+ *
+ * @brief Benchmark for Score library
+ *
+ * @see TTScoreTest, Scenario
+ *
+ * @authors Théo de la Hogue & Clément Bossut
+ *
+ * @copyright Copyright © 2013, Théo de la Hogue & Clément Bossut @n
+ * This code is licensed under the terms of the "CeCILL-C" @n
+ * http://www.cecill.info
+ */
+
+#include "TTScore.benchmark.h"
+#include "TTScoreAPI.h"
+
+#define thisTTClass			TTScoreBenchmark
+#define thisTTClassName		"score.benchmark"
+#define thisTTClassTags		"benchmark, score"
+
+TT_BASE_OBJECT_CONSTRUCTOR
+{;}
+
+TTScoreBenchmark::~TTScoreBenchmark()
+{;}
+
+/** Compile scenarios of 1000, 10000 and 100000 events : a chain of automation boxes, each linked to the next one by an interval
+    (without duration for a third of them). The compile time per event is logged : it shouldn't grow with the size of the scenario. */
+void TTScoreBenchmarkCompile(int& errorCount, int& testAssertionCount)
+{
+    TTTimeEventPtr      startEvent, endEvent, boxStartEvent, boxEndEvent, previousEndEvent;
+    TTTimeProcessPtr    aScenario, aTimeProcess;
+    TTUInt32            nbOfEvents, date, i;
+    TTFloat64           start, duration, firstTimePerEvent = 0.;
+    TTErr               err;
+    
+    TTTestLog("\n");
+	TTTestLog("Benchmarking Scenario compilation");
+    
+    for (nbOfEvents = 1000; nbOfEvents <= 100000; nbOfEvents *= 10) {
+        
+        TTScoreTimeEventCreate(&startEvent, 0);
+        TTScoreTimeEventCreate(&endEvent, nbOfEvents * 20);
+        
+        err = TTScoreTimeProcessCreate(&aScenario, "Scenario", startEvent, endEvent);
+        
+        TTTestAssertion("Scenario created", err == kTTErrNone, testAssertionCount, errorCount);
+        
+        if (err)
+            return;
+        
+        // the events are created in time order (the building of the scenario is not measured)
+        previousEndEvent = NULL;
+        date = 0;
+        
+        for (i = 0; i < nbOfEvents / 2; i++) {
+            
+            if (i % 3)
+                date += 10;
+            
+            TTScoreTimeEventCreate(&boxStartEvent, date, TTTimeContainerPtr(aScenario));
+            
+            date += 10;
+            
+            TTScoreTimeEventCreate(&boxEndEvent, date, TTTimeContainerPtr(aScenario));
+            
+            TTScoreTimeProcessCreate(&aTimeProcess, "Automation", boxStartEvent, boxEndEvent, TTTimeContainerPtr(aScenario));
+            
+            if (previousEndEvent)
+                TTScoreTimeProcessCreate(&aTimeProcess, "Interval", previousEndEvent, boxStartEvent, TTTimeContainerPtr(aScenario));
+            
+            previousEndEvent = boxEndEvent;
+        }
+        
+        start = TTGetTimeInMilliseconds();
+        err = aScenario->sendMessage(kTTSym_Compile);
+        duration = TTGetTimeInMilliseconds() - start;
+        
+        TTTestAssertion("Scenario compiled", err == kTTErrNone, testAssertionCount, errorCount);
+        
+        // the timings are only logged : they depend on the load of the machine
+        if (nbOfEvents == 1000)
+            firstTimePerEvent = duration / nbOfEvents;
+        
+        TTTestLog("%u events compiled in %.1f ms (%.3f ms per event, %.1fx the time per event of 1000 events)",
+                  nbOfEvents, duration, duration / nbOfEvents, firstTimePerEvent > 0. ? duration / nbOfEvents / firstTimePerEvent : 0.);
+        
+        TTScoreTimeProcessRelease(&aScenario);
+        TTScoreTimeEventRelease(&startEvent);
+        TTScoreTimeEventRelease(&endEvent);
+    }
+}
+
+TTErr TTScoreBenchmark::test(TTValue& returnedTestInfo)
+{
+	int	errorCount = 0;
+	int testAssertionCount = 0;
+	
+	TTScoreBenchmarkCompile(errorCount, testAssertionCount);
+	
+	return TTTestFinish(testAssertionCount, errorCount, returnedTestInfo);
+}
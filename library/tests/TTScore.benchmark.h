@@ -0,0 +1,33 @@
+/** @file
+ *
+ * @ingroup scoreLibrary
+ *
+ * @brief Benchmark for Score library
+ *
+ * @details The benchmark logs how long the compilation of bigger and bigger scenarios takes. @n
+ * It is not tagged as a test so it is not run with the unit tests : instantiate score.benchmark and send it the test message to run it. @n@n
+ *
+ * @see TTScoreTest, Scenario
+ *
+ * @authors Théo de la Hogue & Clément Bossut
+ *
+ * @copyright Copyright © 2013, Théo de la Hogue & Clément Bossut @n
+ * This code is licensed under the terms of the "CeCILL-C" @n
+ * http://www.cecill.info
+ */
+
+#ifndef __TT_SCOREBENCHMARK_H__
+#define __TT_SCOREBENCHMARK_H__
+
+#include "TTObjectBase.h"
+#include "TTUnitTest.h"
+
+/**	Provide benchmarks for Score framework */
+class TTScoreBenchmark : public TTObjectBase {
+	TTCLASS_SETUP(TTScoreBenchmark)
+		
+	virtual TTErr test(TTValue& returnedTestInfo);
+};
+
+
+#endif // __TT_SCOREBENCHMARK_H__
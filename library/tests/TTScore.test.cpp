@@ -14,6 +14,7 @@
  */
 
 #include "TTScore.test.h"
+#include "TTScoreAPI.h"
 
 #define thisTTClass			TTScoreTest
 #define thisTTClassName		"score.test"
@@ -25,6 +26,8 @@ TT_BASE_OBJECT_CONSTRUCTOR
 TTScoreTest::~TTScoreTest()
 {;}
 
+void TTScoreTestCompile(int& errorCount, int& testAssertionCount);
+
 void TTScoreTestMain(int& errorCount, int& testAssertionCount)
 {
 	TTTestLog("\n");
@@ -35,9 +38,135 @@ void TTScoreTestMain(int& errorCount, int& testAssertionCount)
                     YES,
 					testAssertionCount,
 					errorCount);
+    
+    TTScoreTestCompile(errorCount, testAssertionCount);
+}
+
+/** Create a scenario of 100 events : a chain of automation boxes, each linked to the next one by an interval
+    (without duration for a third of them). The end event of the fifth box is returned to move it. */
+TTTimeProcessPtr TTScoreTestCompileChain(TTTimeEventPtr *startEvent, TTTimeEventPtr *endEvent, TTTimeEventPtr *movedEvent)
+{
+    TTTimeEventPtr      boxStartEvent, boxEndEvent, previousEndEvent = NULL;
+    TTTimeProcessPtr    aScenario, aTimeProcess;
+    TTUInt32            nbOfEvents = 100, date = 0, i;
+    
+    TTScoreTimeEventCreate(startEvent, 0);
+    TTScoreTimeEventCreate(endEvent, nbOfEvents * 20);
+    
+    if (TTScoreTimeProcessCreate(&aScenario, "Scenario", *startEvent, *endEvent))
+        return NULL;
+    
+    for (i = 0; i < nbOfEvents / 2; i++) {
+        
+        if (i % 3)
+            date += 10;
+        
+        TTScoreTimeEventCreate(&boxStartEvent, date, TTTimeContainerPtr(aScenario));
+        
+        date += 10;
+        
+        TTScoreTimeEventCreate(&boxEndEvent, date, TTTimeContainerPtr(aScenario));
+        
+        TTScoreTimeProcessCreate(&aTimeProcess, "Automation", boxStartEvent, boxEndEvent, TTTimeContainerPtr(aScenario));
+        
+        if (previousEndEvent)
+            TTScoreTimeProcessCreate(&aTimeProcess, "Interval", previousEndEvent, boxStartEvent, TTTimeContainerPtr(aScenario));
+        
+        if (i == 4)
+            *movedEvent = boxEndEvent;
+        
+        previousEndEvent = boxEndEvent;
+    }
+    
+    return aScenario;
 }
 
-// TODO: Benchmarking
+/** Compile the chain of 100 events, check the size of its graph
+    then check that patching the graph after moving one event gives the same arc times as compiling it again.
+    The compile time is measured by the score.benchmark class. */
+void TTScoreTestCompile(int& errorCount, int& testAssertionCount)
+{
+    TTTimeEventPtr      startEvent, endEvent, movedEvent = NULL;
+    TTTimeEventPtr      otherStartEvent, otherEndEvent, otherMovedEvent = NULL;
+    TTTimeProcessPtr    aScenario, otherScenario;
+    TTValue             v, none, patchedInfo, compiledInfo;
+    TTBoolean           same;
+    TTUInt32            i;
+    TTErr               err;
+    
+    TTTestLog("\n");
+	TTTestLog("Testing Scenario compilation");
+    
+    aScenario = TTScoreTestCompileChain(&startEvent, &endEvent, &movedEvent);
+    
+    TTTestAssertion("Scenario created", aScenario != NULL, testAssertionCount, errorCount);
+    
+    if (!aScenario)
+        return;
+    
+    err = aScenario->sendMessage(kTTSym_Compile);
+    
+    TTTestAssertion("Scenario compiled", err == kTTErrNone, testAssertionCount, errorCount);
+    
+    // 100 events minus the 16 ones merged by the intervals without duration, and the start and end transitions
+    // one place for each of the 33 intervals with duration, of the 50 boxes, of the 17 arcs from the start and of the 17 arcs to the end
+    // (the boxes after an interval without duration are started from the start of the graph and closed to its end), and the start and end places
+    err = aScenario->sendMessage(TTSymbol("GraphInfo"), none, v);
+    
+    TTTestAssertion("Scenario graph info", err == kTTErrNone && v.size() == 2 + 2 * 99, testAssertionCount, errorCount);
+    
+    if (!err) {
+        
+        TTTestAssertion("Scenario graph transitions", TTUInt32(v[0]) == 86, testAssertionCount, errorCount);
+        TTTestAssertion("Scenario graph places", TTUInt32(v[1]) == 119, testAssertionCount, errorCount);
+    }
+    
+    // compiling again an unchanged scenario must work as well
+    err = aScenario->sendMessage(kTTSym_Compile);
+    
+    TTTestAssertion("Scenario compiled again", err == kTTErrNone, testAssertionCount, errorCount);
+    
+    // move the end of the fifth box (from 80 to 85) : its intervals keep a duration so the graph is patched
+    movedEvent->setAttributeValue(kTTSym_date, TTUInt32(85));
+    
+    err = aScenario->sendMessage(kTTSym_Compile);
+    
+    TTTestAssertion("Scenario patched", err == kTTErrNone, testAssertionCount, errorCount);
+    
+    aScenario->sendMessage(TTSymbol("GraphInfo"), none, patchedInfo);
+    
+    // compile the same chain with the event already moved
+    otherScenario = TTScoreTestCompileChain(&otherStartEvent, &otherEndEvent, &otherMovedEvent);
+    
+    if (otherScenario) {
+        
+        otherMovedEvent->setAttributeValue(kTTSym_date, TTUInt32(85));
+        
+        err = otherScenario->sendMessage(kTTSym_Compile);
+        
+        TTTestAssertion("Moved scenario compiled", err == kTTErrNone, testAssertionCount, errorCount);
+        
+        otherScenario->sendMessage(TTSymbol("GraphInfo"), none, compiledInfo);
+    }
+    
+    same = patchedInfo.size() == compiledInfo.size() && patchedInfo.size() > 0;
+    
+    for (i = 0; same && i < patchedInfo.size(); i++)
+        same = TTInt32(patchedInfo[i]) == TTInt32(compiledInfo[i]);
+    
+    TTTestAssertion("Patched graph same as compiled graph", same, testAssertionCount, errorCount);
+    
+    if (otherScenario) {
+        
+        TTScoreTimeProcessRelease(&otherScenario);
+        TTScoreTimeEventRelease(&otherStartEvent);
+        TTScoreTimeEventRelease(&otherEndEvent);
+    }
+    
+    TTScoreTimeProcessRelease(&aScenario);
+    TTScoreTimeEventRelease(&startEvent);
+    TTScoreTimeEventRelease(&endEvent);
+}
 
 TTErr TTScoreTest::test(TTValue& returnedTestInfo)
 {